@@ -0,0 +1,123 @@
+#ifndef BENCHMARK_UTILS_H
+#define BENCHMARK_UTILS_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "src/graph/weighted_graph.h"
+#include "src/graph/unweighted_graph.h"
+
+/**
+ * @brief Helpers shared by the benchmark executables
+ *
+ * Benchmarks are plain executables that print one table per run. They are built alongside
+ * the tests but are not registered with CTest.
+ */
+namespace bench {
+
+/**
+ * @brief Run fn the given number of times and return the fastest wall-clock time
+ * @param fn Function to measure
+ * @param repetitions Number of runs
+ * @return double Best time in milliseconds
+ */
+template<typename Fn>
+double time_ms(Fn&& fn, int repetitions = 3) {
+    double best = 0;
+    for (int r = 0; r < repetitions; ++r) {
+        auto begin = std::chrono::steady_clock::now();
+        fn();
+        auto end = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(end - begin).count();
+        if (r == 0 || ms < best) best = ms;
+    }
+    return best;
+}
+
+/**
+ * @brief Read an integer command-line argument
+ * @param argc Argument count
+ * @param argv Argument values
+ * @param index Position of the argument
+ * @param fallback Value used when the argument is missing
+ * @return long long Parsed value
+ */
+inline long long arg_or(int argc, char** argv, int index, long long fallback) {
+    return index < argc ? std::atoll(argv[index]) : fallback;
+}
+
+/**
+ * @brief Thread counts to sweep: 1, 2, 4, ... up to hardware concurrency
+ * @return std::vector<int> Increasing thread counts
+ */
+inline std::vector<int> thread_sweep() {
+    int hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<int> counts;
+    for (int t = 1; t < hardware; t *= 2) counts.push_back(t);
+    counts.push_back(hardware);
+    return counts;
+}
+
+/**
+ * @brief Build a connected random weighted graph: a random spanning path plus random edges
+ * @param vertices Number of vertices
+ * @param average_degree Average number of incident edges per vertex
+ * @param max_weight Largest edge weight (weights are uniform in [1, max_weight])
+ * @param seed Random seed
+ * @return WeightedGraph Finalized graph
+ */
+inline WeightedGraph random_weighted_graph(int vertices, int average_degree, int max_weight, unsigned seed = 42) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> vertex_dist(0, vertices - 1);
+    std::uniform_int_distribution<> weight_dist(1, max_weight);
+    std::vector<int> order(vertices);
+    for (int i = 0; i < vertices; ++i) order[i] = i;
+    std::shuffle(order.begin(), order.end(), gen);
+
+    WeightedGraph g(vertices);
+    for (int i = 1; i < vertices; ++i) {
+        g.add_edge(order[i - 1], order[i], weight_dist(gen));
+    }
+    long long extra = static_cast<long long>(vertices) * average_degree / 2 - (vertices - 1);
+    for (long long i = 0; i < extra; ++i) {
+        g.add_edge(vertex_dist(gen), vertex_dist(gen), weight_dist(gen));
+    }
+    g.finalize();
+    return g;
+}
+
+/**
+ * @brief Build a random directed graph with a power-law-like degree distribution
+ *
+ * Sources are drawn uniformly, targets from a Zipf-like distribution, which yields the low
+ * diameter and skewed in-degrees typical of social graphs.
+ *
+ * @param vertices Number of vertices
+ * @param average_degree Average out-degree
+ * @param seed Random seed
+ * @return UnweightedGraph Finalized graph
+ */
+inline UnweightedGraph random_power_law_graph(int vertices, int average_degree, unsigned seed = 42) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> vertex_dist(0, vertices - 1);
+    std::uniform_real_distribution<> unit(0.0, 1.0);
+
+    UnweightedGraph g(vertices);
+    long long edges = static_cast<long long>(vertices) * average_degree;
+    for (long long i = 0; i < edges; ++i) {
+        int target = static_cast<int>(vertices * std::pow(unit(gen), 2.5));
+        g.add_edge(vertex_dist(gen), std::min(target, vertices - 1));
+    }
+    g.finalize();
+    return g;
+}
+
+} // namespace bench
+
+#endif // BENCHMARK_UTILS_H
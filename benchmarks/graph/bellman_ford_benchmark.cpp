@@ -0,0 +1,66 @@
+#include "benchmarks/benchmark_utils.h"
+#include "src/graph/directed_weighted_graph.h"
+#include <cstdio>
+
+/**
+ * Compares the textbook Bellman-Ford (a pass over the whole edge list per round) with the
+ * frontier-driven parallel Bellman-Ford across thread counts and with SPFA, on a random
+ * digraph with negative arcs but no negative cycles. The textbook version is timed with its
+ * usual early exit; the cost of the full V - 1 passes is extrapolated from one pass.
+ *
+ * Usage: graph_bellman_ford_benchmark [vertices] [average_degree]
+ */
+int main(int argc, char** argv) {
+    int vertices = static_cast<int>(bench::arg_or(argc, argv, 1, 1'000'000));
+    int degree = static_cast<int>(bench::arg_or(argc, argv, 2, 10));
+
+    // w = base + p(u) - p(v) with base >= 0 keeps every cycle non-negative.
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> vertex_dist(0, vertices - 1), base_dist(0, 100), potential_dist(0, 1000);
+    std::vector<int> potential(vertices);
+    for (int& p : potential) p = potential_dist(gen);
+    std::vector<DirectedWeightedGraph::Edge> edges;
+    edges.reserve(static_cast<std::size_t>(vertices) * degree);
+    for (long long i = 0; i < static_cast<long long>(vertices) * degree; ++i) {
+        int u = vertex_dist(gen), v = vertex_dist(gen);
+        edges.emplace_back(u, v, base_dist(gen) + potential[u] - potential[v]);
+    }
+    DirectedWeightedGraph g(vertices);
+    g.add_edges(edges);
+    std::printf("vertices=%d arcs=%zu\n", vertices, g.edge_count());
+
+    std::vector<long long> expected;
+    int passes = 0;
+    auto textbook = [&](bool early_exit, int max_passes) {
+        expected.assign(vertices, DirectedWeightedGraph::unreachable);
+        expected[0] = 0;
+        for (passes = 1; passes <= max_passes; ++passes) {
+            bool changed = false;
+            for (const auto& e : edges) {
+                if (expected[e.u] != DirectedWeightedGraph::unreachable && expected[e.u] + e.w < expected[e.v]) {
+                    expected[e.v] = expected[e.u] + e.w;
+                    changed = true;
+                }
+            }
+            if (early_exit && !changed) break;
+        }
+    };
+    double pass_ms = bench::time_ms([&] { textbook(false, 1); }, 1);
+    double naive_ms = bench::time_ms([&] { textbook(true, vertices - 1); }, 1);
+    std::printf("%-24s %8s %12.2f ms %8s\n", "naive, V - 1 passes", "1", pass_ms * (vertices - 1),
+                "(extrapolated)");
+    std::printf("%-24s %8s %12.2f ms %8s  (%d passes)\n", "naive, early exit", "1", naive_ms, "1.00x", passes);
+
+    for (int threads : bench::thread_sweep()) {
+        DirectedWeightedGraph::ShortestPathTree tree;
+        double ms = bench::time_ms([&] { tree = g.bellman_ford(0, threads); });
+        std::printf("%-24s %8d %12.2f ms %7.2fx%s\n", "parallel bellman_ford", threads, ms, naive_ms / ms,
+                    tree.distance == expected ? "" : "  MISMATCH");
+    }
+
+    DirectedWeightedGraph::ShortestPathTree tree;
+    double spfa_ms = bench::time_ms([&] { tree = g.spfa(0); });
+    std::printf("%-24s %8s %12.2f ms %7.2fx%s\n", "spfa", "1", spfa_ms, naive_ms / spfa_ms,
+                tree.distance == expected ? "" : "  MISMATCH");
+    return 0;
+}
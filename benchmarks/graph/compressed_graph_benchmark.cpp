@@ -0,0 +1,74 @@
+#include "benchmarks/benchmark_utils.h"
+#include <cstdio>
+#include <numeric>
+
+/**
+ * Compares memory use and traversal speed of CSR and compressed adjacency storage.
+ *
+ * Inputs are a power-law DAG (with its original ids and after breadth-first relabelling) and
+ * a grid DAG, whose neighbours have nearby ids. Rows of the CSR graphs are sorted so both
+ * representations visit neighbours in the same order.
+ *
+ * Usage: graph_compressed_graph_benchmark [vertices] [average_degree]
+ */
+int main(int argc, char** argv) {
+    int vertices = static_cast<int>(bench::arg_or(argc, argv, 1, 2'000'000));
+    int degree = static_cast<int>(bench::arg_or(argc, argv, 2, 16));
+    std::vector<int> identity(vertices);
+    std::iota(identity.begin(), identity.end(), 0);
+
+    // Orient every edge from the smaller to the larger id so topological_sort has work to do.
+    UnweightedGraph power_law = bench::random_power_law_graph(vertices, degree);
+    std::vector<std::pair<int, int>> arcs;
+    for (int v = 0; v < vertices; ++v) {
+        for (int u : power_law.neighbours(v)) {
+            if (u != v) arcs.emplace_back(std::min(u, v), std::max(u, v));
+        }
+    }
+    UnweightedGraph original(vertices);
+    original.add_edges(arcs);
+    original = original.relabelled(identity);
+    auto [breadth_first, new_id] = original.reordered(VertexOrdering::BreadthFirst);
+
+    int side = static_cast<int>(std::sqrt(vertices));
+    std::vector<std::pair<int, int>> grid_arcs;
+    for (int r = 0; r < side; ++r) {
+        for (int c = 0; c < side; ++c) {
+            if (c + 1 < side) grid_arcs.emplace_back(r * side + c, r * side + c + 1);
+            if (r + 1 < side) grid_arcs.emplace_back(r * side + c, (r + 1) * side + c);
+        }
+    }
+    UnweightedGraph grid(side * side);
+    grid.add_edges(grid_arcs);
+
+    struct Layout {
+        const char* name;
+        const UnweightedGraph* graph;
+        int start;
+    };
+    for (auto [name, graph, start] : {Layout{"power-law, original ids", &original, 0},
+                                      Layout{"power-law, breadth-first", &breadth_first, new_id[0]},
+                                      Layout{"grid", &grid, 0}}) {
+        CompressedGraph compressed = graph->compressed();
+        double edges = static_cast<double>(compressed.edge_count());
+        std::printf("%s: vertices=%d edges=%.0f\n", name, graph->size(), edges);
+        std::printf("  %-22s %8.2f bytes/edge (csr) %8.2f bytes/edge (compressed)\n", "memory",
+                    4.0 * (graph->size() + 1 + edges) / edges, compressed.bytes_per_edge());
+
+        auto report = [&](const char* operation, auto&& plain, auto&& packed, bool same) {
+            double plain_ms = bench::time_ms(plain);
+            double packed_ms = bench::time_ms(packed);
+            std::printf("  %-22s %10.2f ms (%6.1f Medges/s) %10.2f ms (%6.1f Medges/s) %7.2fx%s\n", operation,
+                        plain_ms, edges / 1e3 / plain_ms, packed_ms, edges / 1e3 / packed_ms, plain_ms / packed_ms,
+                        same ? "" : "  MISMATCH");
+        };
+        report("bfs", [&] { auto r = graph->bfs(start); }, [&] { auto r = compressed.bfs(start); },
+               graph->bfs(start) == compressed.bfs(start));
+        report("dfs", [&] { auto r = graph->dfs(start); }, [&] { auto r = compressed.dfs(start); },
+               graph->dfs(start) == compressed.dfs(start));
+        report("topological_sort", [&] { auto r = graph->topological_sort(); },
+               [&] { auto r = compressed.topological_sort(); },
+               graph->topological_sort() == compressed.topological_sort());
+    }
+    return 0;
+}
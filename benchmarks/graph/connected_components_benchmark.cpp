@@ -0,0 +1,48 @@
+#include "benchmarks/benchmark_utils.h"
+#include "src/data_structures/union_find.h"
+#include <cstdio>
+
+namespace {
+
+/**
+ * Times a sequential UnionFind pass over every arc against Afforest across thread counts,
+ * checking that both find the same number of components.
+ */
+template<typename Graph>
+void run(const char* name, const Graph& g) {
+    int expected = 0;
+    double union_find_ms = bench::time_ms([&] {
+        UnionFind sets(g.size());
+        for (int u = 0; u < g.size(); ++u) {
+            for (int v : g.neighbours(u)) sets.unite(u, v);
+        }
+        expected = sets.count();
+    }, 1);
+    std::printf("%-12s %-24s %8s %12.2f ms %8s  (%d components)\n", name, "union_find", "1", union_find_ms, "1.00x",
+                expected);
+
+    for (int threads : bench::thread_sweep()) {
+        ConnectedComponents got;
+        double ms = bench::time_ms([&] { got = g.connected_components(threads); });
+        std::printf("%-12s %-24s %8d %12.2f ms %7.2fx%s\n", name, "afforest", threads, ms, union_find_ms / ms,
+                    got.count == expected ? "" : "  MISMATCH");
+    }
+}
+
+} // namespace
+
+/**
+ * Compares parallel Afforest connected components with a sequential UnionFind pass on a
+ * power-law digraph (weakly connected components) and on an undirected random graph.
+ *
+ * Usage: graph_connected_components_benchmark [vertices] [average_degree]
+ */
+int main(int argc, char** argv) {
+    int vertices = static_cast<int>(bench::arg_or(argc, argv, 1, 4'000'000));
+    int degree = static_cast<int>(bench::arg_or(argc, argv, 2, 8));
+    std::printf("vertices=%d average_degree=%d\n", vertices, degree);
+
+    run("power-law", bench::random_power_law_graph(vertices, degree));
+    run("uniform", bench::random_weighted_graph(vertices, degree, 100));
+    return 0;
+}
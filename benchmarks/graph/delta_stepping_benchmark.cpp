@@ -0,0 +1,28 @@
+#include "benchmarks/benchmark_utils.h"
+
+/**
+ * Compares sequential Dijkstra with parallel delta-stepping across thread counts.
+ *
+ * Usage: graph_delta_stepping_benchmark [vertices] [average_degree] [max_weight]
+ */
+int main(int argc, char** argv) {
+    int vertices = static_cast<int>(bench::arg_or(argc, argv, 1, 1'000'000));
+    int degree = static_cast<int>(bench::arg_or(argc, argv, 2, 8));
+    int max_weight = static_cast<int>(bench::arg_or(argc, argv, 3, 1000));
+
+    WeightedGraph g = bench::random_weighted_graph(vertices, degree, max_weight);
+    std::printf("vertices=%d average_degree=%d max_weight=%d selected_delta=%d\n",
+                vertices, degree, max_weight, g.select_delta());
+
+    std::vector<int> expected;
+    double dijkstra_ms = bench::time_ms([&] { expected = g.dijkstra(0); });
+    std::printf("%-24s %8s %12.2f ms %8s\n", "dijkstra", "-", dijkstra_ms, "1.00x");
+
+    for (int threads : bench::thread_sweep()) {
+        std::vector<int> dist;
+        double ms = bench::time_ms([&] { dist = g.delta_stepping(0, threads); });
+        std::printf("%-24s %8d %12.2f ms %7.2fx%s\n", "delta_stepping", threads, ms, dijkstra_ms / ms,
+                    dist == expected ? "" : "  MISMATCH");
+    }
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include "benchmarks/benchmark_utils.h"
+#include <cstdio>
+#include <stack>
+
+/**
+ * Compares the explicit-stack DFS engine behind UnweightedGraph::dfs() with the DFS it
+ * replaced: a std::stack that pushes every unvisited neighbour, run over a nested-vector
+ * adjacency list as the graph used to store. The old recursive DFS is not timed; on these
+ * graphs it overflows the call stack.
+ *
+ * Inputs are a power-law graph, whose searches reach most vertices quickly, and a long path,
+ * the deep case that made the recursive version unusable.
+ *
+ * Usage: graph_dfs_benchmark [vertices] [average_degree]
+ */
+namespace {
+
+/**
+ * @brief The pre-engine DFS: pops a vertex, numbers it, pushes its undiscovered neighbours
+ */
+std::pair<std::vector<int>, std::vector<int>> legacy_dfs(const std::vector<std::vector<int>>& adjacency, int start) {
+    const int n = static_cast<int>(adjacency.size());
+    std::vector<int> parent(n, -1), discovery_time(n, -1);
+    std::stack<int> s;
+    s.push(start);
+    int time = 0;
+
+    while (!s.empty()) {
+        int curr = s.top();
+        s.pop();
+        if (discovery_time[curr] != -1) continue;
+        discovery_time[curr] = time++;
+        for (int neighbour : adjacency[curr]) {
+            if (discovery_time[neighbour] == -1) {
+                parent[neighbour] = curr;
+                s.push(neighbour);
+            }
+        }
+    }
+    return {parent, discovery_time};
+}
+
+void run(const char* name, const UnweightedGraph& g) {
+    std::vector<std::vector<int>> nested(g.size());
+    std::size_t arcs = 0;
+    for (int v = 0; v < g.size(); ++v) {
+        std::span<const int> row = g.neighbours(v);
+        nested[v].assign(row.begin(), row.end());
+        arcs += row.size();
+    }
+    std::printf("%s: vertices=%d arcs=%zu\n", name, g.size(), arcs);
+
+    int reached = 0;
+    auto count_reached = [&](const std::vector<int>& discovery) {
+        reached = static_cast<int>(std::ranges::count_if(discovery, [](int t) { return t != -1; }));
+    };
+    double legacy_ms = bench::time_ms([&] { count_reached(legacy_dfs(nested, 0).second); });
+    int legacy_reached = reached;
+    std::printf("  %-22s %12.2f ms %8s  reached=%d\n", "legacy_stack_dfs", legacy_ms, "1.00x", reached);
+
+    double engine_ms = bench::time_ms([&] { count_reached(g.dfs(0).second); });
+    std::printf("  %-22s %12.2f ms %7.2fx  reached=%d%s\n", "dfs", engine_ms, legacy_ms / engine_ms, reached,
+                reached == legacy_reached ? "" : "  MISMATCH");
+
+    SearchWorkspace workspace(g.size());
+    double workspace_ms = bench::time_ms([&] { reached = static_cast<int>(g.dfs(0, workspace).size()); });
+    std::printf("  %-22s %12.2f ms %7.2fx  reached=%d%s\n", "dfs (workspace)", workspace_ms, legacy_ms / workspace_ms,
+                reached, reached == legacy_reached ? "" : "  MISMATCH");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int vertices = static_cast<int>(bench::arg_or(argc, argv, 1, 2'000'000));
+    int degree = static_cast<int>(bench::arg_or(argc, argv, 2, 8));
+
+    run("power_law", bench::random_power_law_graph(vertices, degree));
+
+    std::vector<std::pair<int, int>> path_arcs;
+    for (int v = 0; v + 1 < vertices; ++v) path_arcs.emplace_back(v, v + 1);
+    UnweightedGraph path(vertices);
+    path.add_edges(path_arcs);
+    run("path", path);
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include "benchmarks/benchmark_utils.h"
+#include <cstdio>
+
+/**
+ * Streams batches of edge insertions into a large DAG and compares re-sorting the whole graph
+ * after every batch with maintaining the order incrementally (Pearce–Kelly). Inserted edges
+ * respect a hidden random order, so none of them closes a cycle.
+ *
+ * Usage: graph_dynamic_topological_order_benchmark [vertices] [average_degree] [batches] [batch_size]
+ */
+int main(int argc, char** argv) {
+    int vertices = static_cast<int>(bench::arg_or(argc, argv, 1, 1'000'000));
+    int degree = static_cast<int>(bench::arg_or(argc, argv, 2, 4));
+    int batches = static_cast<int>(bench::arg_or(argc, argv, 3, 20));
+    int batch_size = static_cast<int>(bench::arg_or(argc, argv, 4, 1'000));
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> vertex_dist(0, vertices - 1);
+    std::vector<int> hidden(vertices);
+    for (int i = 0; i < vertices; ++i) hidden[i] = i;
+    std::shuffle(hidden.begin(), hidden.end(), gen);
+    auto random_arc = [&] {
+        int a = vertex_dist(gen), b = vertex_dist(gen);
+        while (a == b) b = vertex_dist(gen);
+        return std::pair{hidden[std::min(a, b)], hidden[std::max(a, b)]};
+    };
+
+    std::vector<std::pair<int, int>> arcs(static_cast<std::size_t>(vertices) * degree);
+    for (auto& arc : arcs) arc = random_arc();
+    std::vector<std::pair<int, int>> stream(static_cast<std::size_t>(batches) * batch_size);
+    for (auto& arc : stream) arc = random_arc();
+
+    UnweightedGraph g(vertices);
+    g.add_edges(arcs);
+    std::printf("vertices=%d arcs=%zu batches=%d batch_size=%d\n", vertices, arcs.size(), batches, batch_size);
+
+    UnweightedGraph rebuilt = g;
+    std::size_t sorted = 0;
+    double static_ms = bench::time_ms([&] {
+        for (int b = 0; b < batches; ++b) {
+            for (int i = 0; i < batch_size; ++i) rebuilt.add_edge(stream[b * batch_size + i].first, stream[b * batch_size + i].second);
+            sorted = rebuilt.topological_sort().size();
+        }
+    }, 1);
+
+    DynamicTopologicalOrder dto = g.dynamic_topological_order();
+    std::size_t inserted = 0, reordered = 0;
+    double dynamic_ms = bench::time_ms([&] {
+        for (const auto& [u, v] : stream) {
+            inserted += dto.add_edge(u, v);
+            reordered += dto.last_reordered();
+        }
+    }, 1);
+
+    std::printf("%-24s %12.3f ms per batch\n", "re-sort after batch", static_ms / batches);
+    std::printf("%-24s %12.3f ms per batch %7.2fx  avg_reordered=%.1f%s\n", "pearce_kelly", dynamic_ms / batches,
+                static_ms / dynamic_ms, static_cast<double>(reordered) / stream.size(),
+                inserted == stream.size() && sorted == static_cast<std::size_t>(vertices) ? "" : "  MISMATCH");
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include "benchmarks/benchmark_utils.h"
+#include <array>
+#include <cstdio>
+#include <fstream>
+#include "src/graph/edge_list.h"
+
+/**
+ * Measures edge-list parsing throughput (GB/s) for every format across thread counts, and the
+ * full WeightedGraph::from_edge_list() construction time.
+ *
+ * Writes a random edge list of roughly the requested size next to the working directory.
+ * Use a size larger than RAM to include disk throughput; otherwise the file is read from the
+ * page cache after the first repetition.
+ *
+ * Usage: graph_edge_list_benchmark [megabytes] [vertices] [file_prefix]
+ */
+int main(int argc, char** argv) {
+    long long megabytes = bench::arg_or(argc, argv, 1, 512);
+    int vertices = static_cast<int>(bench::arg_or(argc, argv, 2, 10'000'000));
+    std::string prefix = argc > 3 ? argv[3] : "edge_list_benchmark";
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> vertex_dist(0, vertices - 1);
+    std::uniform_int_distribution<> weight_dist(1, 1000);
+
+    const std::array<std::pair<EdgeListFormat, const char*>, 3> formats{{
+        {EdgeListFormat::Text, "text"}, {EdgeListFormat::Csv, "csv"}, {EdgeListFormat::Binary, "binary"}}};
+
+    for (const auto& [format, name] : formats) {
+        std::string filename = prefix + "." + name;
+        std::size_t bytes = 0;
+        {
+            std::ofstream out(filename, std::ios::binary);
+            char line[64];
+            while (bytes < static_cast<std::size_t>(megabytes) << 20) {
+                int triple[3] = {vertex_dist(gen), vertex_dist(gen), weight_dist(gen)};
+                if (format == EdgeListFormat::Binary) {
+                    out.write(reinterpret_cast<const char*>(triple), sizeof(triple));
+                    bytes += sizeof(triple);
+                } else {
+                    const char* pattern = format == EdgeListFormat::Csv ? "%d,%d,%d\n" : "%d %d %d\n";
+                    int length = std::snprintf(line, sizeof(line), pattern, triple[0], triple[1], triple[2]);
+                    out.write(line, length);
+                    bytes += length;
+                }
+            }
+        }
+
+        std::printf("%s: %.1f MB\n", name, bytes / 1048576.0);
+        std::size_t edges = 0;
+        for (int threads : bench::thread_sweep()) {
+            double ms = bench::time_ms([&] {
+                edges = read_edge_list(filename, format, true, vertices, threads).from.size();
+            });
+            std::printf("  %-22s %8d %12.2f ms %8.2f GB/s\n", "read_edge_list", threads, ms, bytes / ms / 1e6);
+        }
+        int threads = bench::thread_sweep().back();
+        double ms = bench::time_ms([&] { WeightedGraph g = WeightedGraph::from_edge_list(filename, format, vertices); });
+        std::printf("  %-22s %8d %12.2f ms %8.2f GB/s  (%zu edges)\n", "from_edge_list", threads, ms,
+                    bytes / ms / 1e6, edges);
+        std::remove(filename.c_str());
+    }
+    return 0;
+}
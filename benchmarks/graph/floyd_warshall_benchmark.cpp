@@ -0,0 +1,36 @@
+#include "benchmarks/benchmark_utils.h"
+#include <cstdio>
+#include <numeric>
+
+/**
+ * Finds the crossover between blocked Floyd–Warshall and one Dijkstra per vertex
+ * (distance_table) for all-pairs distances, across graph sizes and average degrees, both
+ * using all hardware threads.
+ *
+ * Usage: graph_floyd_warshall_benchmark [max_vertices]
+ */
+int main(int argc, char** argv) {
+    int max_vertices = static_cast<int>(bench::arg_or(argc, argv, 1, 4096));
+    int threads = bench::thread_sweep().back();
+    std::printf("threads=%d\n", threads);
+    std::printf("%8s %8s %16s %16s %9s\n", "vertices", "degree", "dijkstra x V ms", "floyd ms", "speedup");
+
+    for (int vertices = 512; vertices <= max_vertices; vertices *= 2) {
+        for (int degree : {4, 16, 64, vertices / 4}) {
+            WeightedGraph g = bench::random_weighted_graph(vertices, degree, 1000);
+            std::vector<int> all(vertices);
+            std::iota(all.begin(), all.end(), 0);
+
+            std::vector<int> expected;
+            double dijkstra_ms = bench::time_ms([&] { expected = g.distance_table(all, all, threads); }, 1);
+            bool match = true;
+            double floyd_ms = bench::time_ms([&] {
+                DistanceMatrix m = g.all_pairs_distances(threads);
+                match = std::equal(expected.begin(), expected.end(), m.data().begin());
+            }, 1);
+            std::printf("%8d %8d %16.2f %16.2f %8.2fx%s\n", vertices, degree, dijkstra_ms, floyd_ms,
+                        dijkstra_ms / floyd_ms, match ? "" : "  MISMATCH");
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,42 @@
+#include "benchmarks/benchmark_utils.h"
+#include <array>
+#include <cstdio>
+
+/**
+ * Compares building a graph edge by edge with loading it from a memory-mapped graph file.
+ *
+ * Usage: graph_graph_file_benchmark [vertices] [average_degree] [file]
+ */
+int main(int argc, char** argv) {
+    int vertices = static_cast<int>(bench::arg_or(argc, argv, 1, 1'000'000));
+    int degree = static_cast<int>(bench::arg_or(argc, argv, 2, 16));
+    std::string filename = argc > 3 ? argv[3] : "graph_file_benchmark.bin";
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> vertex_dist(0, vertices - 1);
+    std::uniform_int_distribution<> weight_dist(1, 1000);
+    std::vector<std::array<int, 3>> edges(static_cast<std::size_t>(vertices) * degree / 2);
+    for (auto& edge : edges) edge = {vertex_dist(gen), vertex_dist(gen), weight_dist(gen)};
+    std::printf("vertices=%d edges=%zu\n", vertices, edges.size());
+
+    WeightedGraph built(0);
+    double build_ms = bench::time_ms([&] {
+        built = WeightedGraph(vertices);
+        for (const auto& [u, v, w] : edges) built.add_edge(u, v, w);
+        built.finalize();
+    }, 1);
+    std::printf("%-24s %12.2f ms %8s\n", "add_edge + finalize", build_ms, "1.00x");
+
+    double save_ms = bench::time_ms([&] { built.save(filename); }, 1);
+    std::printf("%-24s %12.2f ms\n", "save", save_ms);
+
+    std::vector<int> expected = built.dijkstra(0);
+    for (bool verify : {true, false}) {
+        double ms = bench::time_ms([&] { WeightedGraph g = WeightedGraph::load(filename, verify); });
+        bool same = WeightedGraph::load(filename, verify).dijkstra(0) == expected;
+        std::printf("%-24s %12.2f ms %7.1fx%s\n", verify ? "load (verified)" : "load (header only)", ms,
+                    build_ms / ms, same ? "" : "  MISMATCH");
+    }
+    std::remove(filename.c_str());
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include "benchmarks/benchmark_utils.h"
+#include "src/graph/max_flow.h"
+#include <cstdio>
+#include <tuple>
+
+namespace {
+
+/**
+ * Grid of rows x columns with arcs in all four directions; the source feeds the left column
+ * and the right column drains into the sink. Returns {network, source, sink}.
+ */
+std::tuple<FlowNetwork, int, int> grid_network(int rows, int columns, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> capacity(1, 1000);
+    const int source = rows * columns, sink = source + 1;
+    FlowNetwork network(rows * columns + 2);
+    network.reserve_edges(4LL * rows * columns + 2LL * rows);
+    auto id = [&](int r, int c) { return r * columns + c; };
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < columns; ++c) {
+            if (c + 1 < columns) {
+                network.add_edge(id(r, c), id(r, c + 1), capacity(gen));
+                network.add_edge(id(r, c + 1), id(r, c), capacity(gen));
+            }
+            if (r + 1 < rows) {
+                network.add_edge(id(r, c), id(r + 1, c), capacity(gen));
+                network.add_edge(id(r + 1, c), id(r, c), capacity(gen));
+            }
+        }
+        network.add_edge(source, id(r, 0), 1'000'000);
+        network.add_edge(id(r, columns - 1), sink, 1'000'000);
+    }
+    return {std::move(network), source, sink};
+}
+
+/**
+ * layers x width vertices; every vertex has degree arcs to random vertices of the next
+ * layer, the source feeds the first layer and the last layer drains into the sink.
+ */
+std::tuple<FlowNetwork, int, int> layered_network(int layers, int width, int degree, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> capacity(1, 1000), column(0, width - 1);
+    const int source = layers * width, sink = source + 1;
+    FlowNetwork network(layers * width + 2);
+    network.reserve_edges(static_cast<std::size_t>(layers) * width * degree + 2 * width);
+    for (int l = 0; l + 1 < layers; ++l) {
+        for (int i = 0; i < width; ++i) {
+            for (int d = 0; d < degree; ++d) {
+                network.add_edge(l * width + i, (l + 1) * width + column(gen), capacity(gen));
+            }
+        }
+    }
+    for (int i = 0; i < width; ++i) {
+        network.add_edge(source, i, 1'000'000);
+        network.add_edge((layers - 1) * width + i, sink, 1'000'000);
+    }
+    return {std::move(network), source, sink};
+}
+
+void run(const char* name, const FlowNetwork& network, int source, int sink) {
+    FlowNetwork::MaxFlow dinic, push_relabel;
+    double dinic_ms = bench::time_ms([&] { dinic = network.dinic(source, sink); }, 1);
+    double push_relabel_ms = bench::time_ms([&] { push_relabel = network.push_relabel(source, sink); }, 1);
+    std::printf("%-28s %9d %10zu %14lld %12.2f %14.2f %8.2fx%s\n", name, network.size(), network.edge_count(),
+                dinic.value, dinic_ms, push_relabel_ms, dinic_ms / push_relabel_ms,
+                dinic.value == push_relabel.value ? "" : "  MISMATCH");
+}
+
+} // namespace
+
+/**
+ * Times Dinic and highest-label push-relabel on synthetic grid and layered networks of
+ * growing size. The last column is Dinic's time over push-relabel's.
+ *
+ * Usage: graph_max_flow_benchmark [max_side]
+ */
+int main(int argc, char** argv) {
+    int max_side = static_cast<int>(bench::arg_or(argc, argv, 1, 512));
+    std::printf("%-28s %9s %10s %14s %12s %14s %9s\n", "instance", "vertices", "edges", "max flow", "dinic ms",
+                "push-relabel ms", "ratio");
+
+    char name[64];
+    for (int side = 128; side <= max_side; side *= 2) {
+        auto [network, source, sink] = grid_network(side, side, 7);
+        std::snprintf(name, sizeof(name), "grid %dx%d", side, side);
+        run(name, network, source, sink);
+    }
+    for (int side = 128; side <= max_side; side *= 2) {
+        auto [network, source, sink] = layered_network(side / 8, side * 8, 4, 7);
+        std::snprintf(name, sizeof(name), "layered %dx%d, degree 4", side / 8, side * 8);
+        run(name, network, source, sink);
+    }
+    return 0;
+}
@@ -0,0 +1,43 @@
+#include "benchmarks/benchmark_utils.h"
+
+/**
+ * Compares Kruskal and Prim with Filter-Kruskal and parallel Borůvka across thread counts.
+ *
+ * Usage: graph_mst_benchmark [vertices] [average_degree] [max_weight]
+ */
+int main(int argc, char** argv) {
+    int vertices = static_cast<int>(bench::arg_or(argc, argv, 1, 1'000'000));
+    int degree = static_cast<int>(bench::arg_or(argc, argv, 2, 16));
+    int max_weight = static_cast<int>(bench::arg_or(argc, argv, 3, 1'000'000));
+
+    WeightedGraph g = bench::random_weighted_graph(vertices, degree, max_weight);
+    std::printf("vertices=%d average_degree=%d max_weight=%d\n", vertices, degree, max_weight);
+
+    auto total = [](const std::vector<WeightedGraph::Edge>& mst) {
+        long long sum = 0;
+        for (const auto& edge : mst) sum += edge.w;
+        return sum;
+    };
+
+    long long expected = 0;
+    double kruskal_ms = bench::time_ms([&] { expected = total(g.kruskal_mst()); });
+    std::printf("%-24s %8s %12.2f ms %8s\n", "kruskal", "-", kruskal_ms, "1.00x");
+
+    long long weight = 0;
+    double prim_ms = bench::time_ms([&] { weight = total(g.prim_mst()); });
+    std::printf("%-24s %8s %12.2f ms %7.2fx%s\n", "prim", "-", prim_ms, kruskal_ms / prim_ms,
+                weight == expected ? "" : "  MISMATCH");
+
+    for (int threads : bench::thread_sweep()) {
+        double ms = bench::time_ms([&] { weight = total(g.filter_kruskal_mst(threads)); });
+        std::printf("%-24s %8d %12.2f ms %7.2fx%s\n", "filter_kruskal", threads, ms, kruskal_ms / ms,
+                    weight == expected ? "" : "  MISMATCH");
+    }
+
+    for (int threads : bench::thread_sweep()) {
+        double ms = bench::time_ms([&] { weight = total(g.boruvka_mst(threads)); });
+        std::printf("%-24s %8d %12.2f ms %7.2fx%s\n", "boruvka", threads, ms, kruskal_ms / ms,
+                    weight == expected ? "" : "  MISMATCH");
+    }
+    return 0;
+}
@@ -0,0 +1,50 @@
+#include "benchmarks/benchmark_utils.h"
+#include <cstdio>
+
+/**
+ * Times one bfs() call per source against bit-parallel multi-source BFS at every batch width
+ * and thread count on a power-law digraph. Throughput is reported in traversed edges per
+ * second (out-arcs of every vertex reached, summed over the sources).
+ *
+ * Usage: graph_multi_source_bfs_benchmark [vertices] [average_degree] [sources]
+ */
+int main(int argc, char** argv) {
+    int vertices = static_cast<int>(bench::arg_or(argc, argv, 1, 250'000));
+    int degree = static_cast<int>(bench::arg_or(argc, argv, 2, 8));
+    int count = static_cast<int>(bench::arg_or(argc, argv, 3, 512));
+    std::printf("vertices=%d average_degree=%d sources=%d\n", vertices, degree, count);
+
+    UnweightedGraph g = bench::random_power_law_graph(vertices, degree);
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<> vertex(0, vertices - 1);
+    std::vector<int> sources(count);
+    for (int& s : sources) s = vertex(gen);
+
+    long long expected_reached = 0, traversed = 0;
+    double bfs_ms = bench::time_ms([&] {
+        expected_reached = traversed = 0;
+        for (int s : sources) {
+            std::vector<int> distance = g.bfs(s).second;
+            for (int v = 0; v < vertices; ++v) {
+                if (distance[v] == -1) continue;
+                ++expected_reached;
+                traversed += static_cast<long long>(g.neighbours(v).size());
+            }
+        }
+    }, 1);
+    std::printf("%-16s %8s %8s %12s %12s %8s\n", "method", "width", "threads", "ms", "GTEPS", "speedup");
+    std::printf("%-16s %8s %8s %12.2f %12.3f %8s\n", "bfs per source", "-", "1", bfs_ms, traversed / bfs_ms / 1e6,
+                "1.00x");
+
+    for (int width : {64, 256, 512}) {
+        for (int threads : bench::thread_sweep()) {
+            BfsSummary summary;
+            double ms = bench::time_ms([&] { summary = g.multi_source_bfs_summary(sources, width, threads); }, 1);
+            long long reached = 0;
+            for (int r : summary.reached) reached += r;
+            std::printf("%-16s %8d %8d %12.2f %12.3f %7.2fx%s\n", "multi-source", width, threads, ms,
+                        traversed / ms / 1e6, bfs_ms / ms, reached == expected_reached ? "" : "  MISMATCH");
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include "benchmarks/benchmark_utils.h"
+#include <cstdio>
+#include <utility>
+
+/**
+ * Measures traversal speed before and after relabelling the vertices of a road-network-like
+ * grid whose vertex ids have been shuffled.
+ *
+ * Usage: graph_reorder_benchmark [grid_side]
+ */
+int main(int argc, char** argv) {
+    int side = static_cast<int>(bench::arg_or(argc, argv, 1, 1000));
+    int vertices = side * side;
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> weight_dist(1, 1000);
+    std::vector<int> label(vertices);
+    for (int i = 0; i < vertices; ++i) label[i] = i;
+    std::shuffle(label.begin(), label.end(), gen);
+
+    std::vector<WeightedGraph::Edge> edges;
+    std::vector<std::pair<int, int>> arcs;
+    for (int r = 0; r < side; ++r) {
+        for (int c = 0; c < side; ++c) {
+            int v = label[r * side + c];
+            for (int u : {c + 1 < side ? label[r * side + c + 1] : -1, r + 1 < side ? label[(r + 1) * side + c] : -1}) {
+                if (u < 0) continue;
+                edges.emplace_back(v, u, weight_dist(gen));
+                arcs.emplace_back(v, u);
+                arcs.emplace_back(u, v);
+            }
+        }
+    }
+    WeightedGraph weighted(vertices);
+    weighted.add_edges(edges);
+    UnweightedGraph unweighted(vertices);
+    unweighted.add_edges(arcs);
+    std::printf("vertices=%d edges=%zu\n", vertices, edges.size());
+
+    const int source = label[vertices / 2 + side / 2];
+    std::vector<int> dijkstra_expected = weighted.dijkstra(source);
+    std::vector<int> bfs_expected = unweighted.bfs(source).second;
+
+    double base_dijkstra = 0, base_prim = 0, base_bfs = 0, base_dfs = 0;
+    auto run = [&](const char* name, const WeightedGraph& wg, const UnweightedGraph& ug,
+                   const std::vector<int>& new_id) {
+        int s = new_id.empty() ? source : new_id[source];
+        auto maps_back = [&](const std::vector<int>& got, const std::vector<int>& expected) {
+            for (int v = 0; v < vertices; ++v) {
+                if (got[new_id.empty() ? v : new_id[v]] != expected[v]) return false;
+            }
+            return true;
+        };
+
+        double dijkstra_ms = bench::time_ms([&] { auto d = wg.dijkstra(s); });
+        double prim_ms = bench::time_ms([&] { auto t = wg.prim_mst(); }, 1);
+        double bfs_ms = bench::time_ms([&] { auto b = ug.bfs(s); });
+        double dfs_ms = bench::time_ms([&] { auto d = ug.dfs(s); });
+        if (new_id.empty()) {
+            base_dijkstra = dijkstra_ms;
+            base_prim = prim_ms;
+            base_bfs = bfs_ms;
+            base_dfs = dfs_ms;
+        }
+        bool dijkstra_ok = maps_back(wg.dijkstra(s), dijkstra_expected);
+        bool bfs_ok = maps_back(ug.bfs(s).second, bfs_expected);
+
+        std::printf("%s\n", name);
+        std::printf("  %-22s %12.2f ms %7.2fx%s\n", "dijkstra", dijkstra_ms, base_dijkstra / dijkstra_ms,
+                    dijkstra_ok ? "" : "  MISMATCH");
+        std::printf("  %-22s %12.2f ms %7.2fx\n", "prim_mst", prim_ms, base_prim / prim_ms);
+        std::printf("  %-22s %12.2f ms %7.2fx%s\n", "bfs", bfs_ms, base_bfs / bfs_ms, bfs_ok ? "" : "  MISMATCH");
+        std::printf("  %-22s %12.2f ms %7.2fx\n", "dfs", dfs_ms, base_dfs / dfs_ms);
+    };
+
+    run("original (shuffled ids)", weighted, unweighted, {});
+
+    const std::pair<VertexOrdering, const char*> orderings[] = {
+        {VertexOrdering::ReverseCuthillMcKee, "reverse Cuthill-McKee"},
+        {VertexOrdering::DegreeDescending, "degree descending"},
+        {VertexOrdering::BreadthFirst, "breadth-first"},
+    };
+    for (auto [ordering, name] : orderings) {
+        std::pair<WeightedGraph, std::vector<int>> relabelled{WeightedGraph(0), {}};
+        double reorder_ms = bench::time_ms([&] { relabelled = weighted.reordered(ordering); }, 1);
+        UnweightedGraph relabelled_unweighted = unweighted.relabelled(relabelled.second);
+        run(name, relabelled.first, relabelled_unweighted, relabelled.second);
+        std::printf("  %-22s %12.2f ms\n", "reorder cost", reorder_ms);
+    }
+    return 0;
+}
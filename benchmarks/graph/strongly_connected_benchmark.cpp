@@ -0,0 +1,52 @@
+#include "benchmarks/benchmark_utils.h"
+#include <cstdio>
+
+/**
+ * Compares sequential Tarjan with the parallel trim / forward-backward / colouring SCC
+ * algorithm on a power-law digraph, across thread counts, and times building the
+ * condensation DAG.
+ *
+ * Usage: graph_strongly_connected_benchmark [vertices] [average_degree]
+ */
+int main(int argc, char** argv) {
+    int vertices = static_cast<int>(bench::arg_or(argc, argv, 1, 4'000'000));
+    int degree = static_cast<int>(bench::arg_or(argc, argv, 2, 4));
+
+    UnweightedGraph g = bench::random_power_law_graph(vertices, degree);
+    std::printf("vertices=%d average_degree=%d\n", vertices, degree);
+
+    // Labels from different algorithms may number unordered components differently.
+    auto same_partition = [&](const StronglyConnectedComponents& a, const StronglyConnectedComponents& b) {
+        if (a.count != b.count) return false;
+        std::vector<int> map(a.count, -1);
+        for (int v = 0; v < vertices; ++v) {
+            int& m = map[a.component[v]];
+            if (m == -1) m = b.component[v];
+            if (m != b.component[v]) return false;
+        }
+        return true;
+    };
+
+    StronglyConnectedComponents expected;
+    double tarjan_ms = bench::time_ms([&] { expected = g.strongly_connected_components(); });
+    std::vector<int> sizes(expected.count, 0);
+    for (int c : expected.component) sizes[c]++;
+    std::printf("components=%d largest=%d\n", expected.count, *std::max_element(sizes.begin(), sizes.end()));
+    std::printf("%-24s %8s %12.2f ms %8s\n", "tarjan", "-", tarjan_ms, "1.00x");
+
+    for (int threads : bench::thread_sweep()) {
+        StronglyConnectedComponents got;
+        double ms = bench::time_ms([&] { got = g.strongly_connected_components_parallel(threads); });
+        std::printf("%-24s %8d %12.2f ms %7.2fx%s\n", "forward_backward", threads, ms, tarjan_ms / ms,
+                    same_partition(expected, got) ? "" : "  MISMATCH");
+    }
+
+    for (int threads : bench::thread_sweep()) {
+        UnweightedGraph dag(0);
+        double ms = bench::time_ms([&] { dag = g.condensation(expected, threads); });
+        std::size_t arcs = 0;
+        for (int c = 0; c < dag.size(); ++c) arcs += dag.neighbours(c).size();
+        std::printf("%-24s %8d %12.2f ms   dag_edges=%zu\n", "condensation", threads, ms, arcs);
+    }
+    return 0;
+}
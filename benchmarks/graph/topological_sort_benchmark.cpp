@@ -0,0 +1,37 @@
+#include "benchmarks/benchmark_utils.h"
+#include <cstdio>
+
+/**
+ * Compares the sequential Kahn topological sort with the parallel layered variant across
+ * thread counts on a random DAG (arcs always point from the smaller to the larger id).
+ *
+ * Usage: graph_topological_sort_benchmark [vertices] [average_degree]
+ */
+int main(int argc, char** argv) {
+    int vertices = static_cast<int>(bench::arg_or(argc, argv, 1, 4'000'000));
+    int degree = static_cast<int>(bench::arg_or(argc, argv, 2, 8));
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> vertex_dist(0, vertices - 1);
+    std::vector<std::pair<int, int>> arcs;
+    arcs.reserve(static_cast<std::size_t>(vertices) * degree);
+    for (long long i = 0; i < static_cast<long long>(vertices) * degree; ++i) {
+        int u = vertex_dist(gen), v = vertex_dist(gen);
+        if (u != v) arcs.emplace_back(std::min(u, v), std::max(u, v));
+    }
+    UnweightedGraph g(vertices);
+    g.add_edges(arcs);
+    std::printf("vertices=%d arcs=%zu\n", vertices, arcs.size());
+
+    std::size_t sorted = 0;
+    double kahn_ms = bench::time_ms([&] { sorted = g.topological_sort().size(); });
+    std::printf("%-24s %8s %12.2f ms %8s\n", "kahn", "-", kahn_ms, "1.00x");
+
+    for (int threads : bench::thread_sweep()) {
+        UnweightedGraph::TopologicalLayers layers;
+        double ms = bench::time_ms([&] { layers = g.topological_layers(threads); });
+        std::printf("%-24s %8d %12.2f ms %7.2fx  layers=%d%s\n", "layered_kahn", threads, ms, kahn_ms / ms,
+                    layers.layer_count(), layers.order.size() == sorted ? "" : "  MISMATCH");
+    }
+    return 0;
+}
@@ -16,6 +16,11 @@ int UnionFind::find(int x) {
     }
 }
 
+int UnionFind::find_root(int x) const {
+    while (parent[x] != x) x = parent[x];
+    return x;
+}
+
 void UnionFind::unite(int x, int y) {
     int x_root = find(x);
     int y_root = find(y);
@@ -68,6 +68,17 @@ public:
      */
     int find(int x);
 
+    /**
+     * @brief Finds the representative (root) of the set containing element x without modifying the structure.
+     *
+     * Unlike find(), this method does not compress paths, so several threads may call it at the
+     * same time as long as none of them modifies the structure.
+     *
+     * @param x The element to find the representative for.
+     * @return The representative (root) of the set containing x.
+     */
+    int find_root(int x) const;
+
     /**
      * @brief Unites the sets containing elements x and y.
      *
@@ -0,0 +1,115 @@
+#include "boruvka.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include "src/graph/parallel.h"
+
+namespace {
+
+constexpr std::uint64_t no_edge = std::numeric_limits<std::uint64_t>::max();
+
+/**
+ * @brief Pack (weight, edge index) into one key whose unsigned order is the lexicographic order
+ */
+std::uint64_t edge_key(int weight, std::size_t index) {
+    auto biased = static_cast<std::uint32_t>(weight) ^ 0x80000000u;
+    return (static_cast<std::uint64_t>(biased) << 32) | static_cast<std::uint32_t>(index);
+}
+
+void fetch_min(std::uint64_t& slot, std::uint64_t key) {
+    std::atomic_ref<std::uint64_t> target(slot);
+    std::uint64_t current = target.load(std::memory_order_relaxed);
+    while (key < current && !target.compare_exchange_weak(current, key, std::memory_order_relaxed)) {
+    }
+}
+
+} // namespace
+
+std::vector<std::size_t> boruvka_forest(int vertices, std::span<const int> from,
+                                        std::span<const int> to, std::span<const int> weights,
+                                        int threads) {
+    threads = resolve_thread_count(threads);
+    const int edge_count = static_cast<int>(from.size());
+
+    std::vector<int> component(vertices);  // Representative vertex of each vertex's component
+    std::vector<int> parent(vertices);     // Hook target of each representative this round
+    std::vector<int> next_parent(vertices);
+    std::vector<std::uint64_t> best(vertices, no_edge);
+    std::vector<char> in_forest(edge_count, 0);
+    for (int v = 0; v < vertices; ++v) component[v] = v;
+
+    std::vector<int> active;
+    active.reserve(edge_count);
+    for (int e = 0; e < edge_count; ++e) {
+        if (from[e] != to[e]) active.push_back(e);
+    }
+    std::vector<std::vector<int>> survivors(threads);
+
+    while (!active.empty()) {
+        // 1. Every component finds its lightest outgoing edge.
+        parallel_for(0, static_cast<int>(active.size()), threads, [&](int, int lo, int hi) {
+            for (int i = lo; i < hi; ++i) {
+                int e = active[i];
+                std::uint64_t key = edge_key(weights[e], e);
+                fetch_min(best[component[from[e]]], key);
+                fetch_min(best[component[to[e]]], key);
+            }
+        });
+
+        // 2. Hook each component onto the other end of its edge. Two components that picked the
+        //    same edge form the only possible cycle; the smaller one stays a root.
+        parallel_for(0, vertices, threads, [&](int, int lo, int hi) {
+            for (int c = lo; c < hi; ++c) {
+                parent[c] = c;
+                if (component[c] != c || best[c] == no_edge) continue;
+                auto e = static_cast<int>(best[c] & 0xffffffffu);
+                int other = component[from[e]] == c ? component[to[e]] : component[from[e]];
+                if (best[other] == best[c] && c < other) continue;
+                parent[c] = other;
+                in_forest[e] = 1;
+            }
+        });
+
+        // 3. Pointer jumping: halve the depth of every hook tree until all point at their root,
+        //    then relabel every vertex with the root of its component.
+        for (std::atomic<bool> changed = true; changed.exchange(false);) {
+            parallel_for(0, vertices, threads, [&](int, int lo, int hi) {
+                bool moved = false;
+                for (int c = lo; c < hi; ++c) {
+                    int grandparent = parent[parent[c]];
+                    next_parent[c] = grandparent;
+                    moved |= grandparent != parent[c];
+                }
+                if (moved) changed.store(true, std::memory_order_relaxed);
+            });
+            parent.swap(next_parent);
+        }
+        parallel_for(0, vertices, threads, [&](int, int lo, int hi) {
+            for (int v = lo; v < hi; ++v) component[v] = parent[component[v]];
+        });
+        parallel_for(0, vertices, threads, [&](int, int lo, int hi) {
+            std::fill(best.begin() + lo, best.begin() + hi, no_edge);
+        });
+
+        // 4. Drop edges that now lie inside a single component.
+        int workers = parallel_for(0, static_cast<int>(active.size()), threads, [&](int worker, int lo, int hi) {
+            std::vector<int>& kept = survivors[worker];
+            kept.clear();
+            for (int i = lo; i < hi; ++i) {
+                int e = active[i];
+                if (component[from[e]] != component[to[e]]) kept.push_back(e);
+            }
+        });
+        active.clear();
+        for (int w = 0; w < workers; ++w) {
+            active.insert(active.end(), survivors[w].begin(), survivors[w].end());
+        }
+    }
+
+    std::vector<std::size_t> forest;
+    for (int e = 0; e < edge_count; ++e) {
+        if (in_forest[e]) forest.push_back(e);
+    }
+    return forest;
+}
@@ -0,0 +1,34 @@
+#ifndef BORUVKA_H
+#define BORUVKA_H
+
+#include <vector>
+#include <span>
+#include <cstddef>
+
+/**
+ * @brief Compute a minimum spanning forest of an edge list with parallel Borůvka
+ *
+ * Every round, each component picks its lightest incident edge with an atomic fetch-min over
+ * all remaining edges, the picked edges hook components onto each other, pointer jumping
+ * flattens the resulting trees and edges that became internal to a component are filtered
+ * out. Each round at least halves the number of components, so there are O(log V) rounds of
+ * O(V + E) parallel work.
+ *
+ * Ties are broken by edge index, so the result is deterministic and independent of the
+ * number of threads. Disconnected graphs yield one tree per connected component.
+ *
+ * The edge list is given as three parallel arrays; edge i joins from[i] and to[i] with
+ * weight weights[i]. Self-loops are ignored. Weights may be negative.
+ *
+ * @param vertices Number of vertices
+ * @param from First endpoint of each edge
+ * @param to Second endpoint of each edge
+ * @param weights Weight of each edge
+ * @param threads Number of worker threads (non-positive selects hardware concurrency)
+ * @return std::vector<std::size_t> Indices of the forest edges, in increasing order
+ */
+[[nodiscard]] std::vector<std::size_t> boruvka_forest(int vertices, std::span<const int> from,
+                                                      std::span<const int> to, std::span<const int> weights,
+                                                      int threads = 0);
+
+#endif // BORUVKA_H
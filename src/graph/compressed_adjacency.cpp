@@ -0,0 +1,133 @@
+#include "compressed_adjacency.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include "src/graph/parallel.h"
+
+namespace {
+
+void write_varint(std::vector<std::uint8_t>& out, std::uint32_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+/**
+ * @brief Append the encoding of v's row, which must already be sorted
+ */
+void write_row(std::vector<std::uint8_t>& out, int v, std::span<const int> row) {
+    write_varint(out, static_cast<std::uint32_t>(row.size()));
+    if (row.empty()) return;
+    int delta = row[0] - v;
+    write_varint(out, (static_cast<std::uint32_t>(delta) << 1) ^ static_cast<std::uint32_t>(delta >> 31));
+    for (std::size_t i = 1; i < row.size(); ++i) {
+        write_varint(out, static_cast<std::uint32_t>(row[i] - row[i - 1]));
+    }
+}
+
+/**
+ * @brief Check that a row starting at the given distance from its block's start can be indexed
+ */
+bool fits_row_offset(std::size_t offset) {
+    return offset <= std::numeric_limits<std::uint32_t>::max();
+}
+
+} // namespace
+
+CompressedAdjacency::CompressedAdjacency(const CsrAdjacency& csr, int threads)
+    : _size(csr.size()), _arcs(csr.arc_count()) {
+    threads = resolve_thread_count(threads);
+    const int blocks = (_size + (1 << block_shift) - 1) >> block_shift;
+    _block_offsets.assign(blocks, 0);
+    _row_offsets.assign(_size, 0);
+
+    // Each worker encodes a contiguous range of blocks into its own buffer; the buffers are
+    // then concatenated in order and the block offsets shifted accordingly.
+    std::vector<std::vector<std::uint8_t>> chunks(threads);
+    std::vector<std::pair<int, int>> chunk_blocks(threads);
+    std::vector<char> overflow(threads, 0);
+    int workers = parallel_for(0, blocks, threads, [&](int worker, int lo, int hi) {
+        std::vector<std::uint8_t>& out = chunks[worker];
+        chunk_blocks[worker] = {lo, hi};
+        std::vector<int> row;
+        for (int b = lo; b < hi; ++b) {
+            _block_offsets[b] = out.size();
+            int first = b << block_shift, last = std::min(_size, first + (1 << block_shift));
+            for (int v = first; v < last; ++v) {
+                std::span<const int> neighbours = csr.neighbours(v);
+                row.assign(neighbours.begin(), neighbours.end());
+                std::ranges::sort(row);
+                if (!fits_row_offset(out.size() - _block_offsets[b])) {
+                    overflow[worker] = 1;
+                    return;
+                }
+                _row_offsets[v] = static_cast<std::uint32_t>(out.size() - _block_offsets[b]);
+                write_row(out, v, row);
+            }
+        }
+    }, 64);
+    if (std::ranges::find(overflow, 1) != overflow.end()) {
+        throw std::overflow_error("A block of 64 rows encodes to more than 4 GiB");
+    }
+
+    std::vector<std::uint64_t> chunk_begin(workers + 1, 0);
+    for (int w = 0; w < workers; ++w) chunk_begin[w + 1] = chunk_begin[w] + chunks[w].size();
+    _bytes.resize(chunk_begin[workers]);
+    parallel_for(0, workers, workers, [&](int, int lo, int hi) {
+        for (int w = lo; w < hi; ++w) {
+            std::ranges::copy(chunks[w], _bytes.begin() + static_cast<std::ptrdiff_t>(chunk_begin[w]));
+            for (int b = chunk_blocks[w].first; b < chunk_blocks[w].second; ++b) _block_offsets[b] += chunk_begin[w];
+        }
+    }, 1);
+}
+
+std::vector<int> CompressedAdjacency::neighbours(int v) const {
+    std::vector<int> result;
+    result.reserve(degree(v));
+    for_each_neighbour(v, [&](int u) { result.push_back(u); });
+    return result;
+}
+
+CompressedAdjacency::Encoder::Encoder(int size) {
+    if (size < 0) {
+        throw std::invalid_argument("Vertex count must be non-negative");
+    }
+    _result._size = size;
+    _result._block_offsets.assign((size + (1 << block_shift) - 1) >> block_shift, 0);
+    _result._row_offsets.assign(size, 0);
+}
+
+void CompressedAdjacency::Encoder::add_row(std::span<const int> neighbours) {
+    const int n = _result._size;
+    if (_next >= n) {
+        throw std::out_of_range("Every row has already been added");
+    }
+    if (neighbours.size() > static_cast<std::size_t>(std::numeric_limits<int>::max())) {
+        throw std::overflow_error("Row degree does not fit in an int");
+    }
+    if (std::ranges::any_of(neighbours, [n](int u) { return u < 0 || u >= n; })) {
+        throw std::out_of_range("Vertex index out of range");
+    }
+    std::vector<std::uint8_t>& out = _result._bytes;
+    if ((_next & ((1 << block_shift) - 1)) == 0) _result._block_offsets[_next >> block_shift] = out.size();
+    std::size_t offset = out.size() - _result._block_offsets[_next >> block_shift];
+    if (!fits_row_offset(offset)) {
+        throw std::overflow_error("A block of 64 rows encodes to more than 4 GiB");
+    }
+    _result._row_offsets[_next] = static_cast<std::uint32_t>(offset);
+
+    _row.assign(neighbours.begin(), neighbours.end());
+    std::ranges::sort(_row);
+    write_row(out, _next, _row);
+    _result._arcs += _row.size();
+    ++_next;
+}
+
+CompressedAdjacency CompressedAdjacency::Encoder::finish() && {
+    while (_next < _result._size) add_row({});
+    _result._bytes.shrink_to_fit();
+    return std::move(_result);
+}
@@ -0,0 +1,220 @@
+#ifndef COMPRESSED_ADJACENCY_H
+#define COMPRESSED_ADJACENCY_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include "src/graph/csr.h"
+
+/**
+ * @class CompressedAdjacency
+ * @brief Unweighted adjacency stored as delta-encoded, byte-aligned varints.
+ *
+ * Every row is sorted and written as its degree, the signed distance from the vertex to its
+ * first neighbour and then the gaps between consecutive neighbours, each as an LEB128 varint
+ * (seven payload bits per byte, high bit set on all but the last byte). Neighbours of a
+ * vertex tend to have nearby ids, especially after reordering (see reorder.h), so most gaps
+ * fit in a single byte and an arc costs one to two bytes instead of four.
+ *
+ * Row starts are kept as a 64-bit base per block of 64 vertices plus a 32-bit offset per
+ * vertex inside its block, which costs about as much as CSR's offsets while still allowing
+ * encodings larger than 4 GiB. Encoding throws std::overflow_error rather than wrap an offset
+ * if 64 consecutive rows alone exceed 4 GiB.
+ *
+ * Rows are decoded sequentially with for_each_neighbour(); there is no random access into a
+ * row.
+ *
+ * Encoding from a CsrAdjacency needs the uncompressed arrays, although they may be borrowed
+ * from a mapped graph file (see CompressedGraph::load()). Graphs that are produced row by row
+ * can instead be fed to an Encoder, which never holds more than one uncompressed row.
+ *
+ * @note Vertices are zero-indexed.
+ */
+class CompressedAdjacency {
+private:
+    int _size = 0;                      ///< Number of vertices
+    std::size_t _arcs = 0;              ///< Number of arcs
+    std::vector<std::uint64_t> _block_offsets; ///< Byte offset of every block of 64 rows
+    std::vector<std::uint32_t> _row_offsets;   ///< Offset of each row from its block's start
+    std::vector<std::uint8_t> _bytes;          ///< Encoded rows
+
+    static constexpr int block_shift = 6;
+
+    [[nodiscard]] const std::uint8_t* row(int v) const {
+        return _bytes.data() + _block_offsets[v >> block_shift] + _row_offsets[v];
+    }
+
+    static std::uint32_t read_varint(const std::uint8_t*& p) {
+        std::uint32_t byte = *p++;
+        std::uint32_t value = byte & 0x7f;
+        for (int shift = 7; byte & 0x80; shift += 7) {
+            byte = *p++;
+            value |= (byte & 0x7f) << shift;
+        }
+        return value;
+    }
+
+public:
+    /**
+     * @brief Construct an empty adjacency with no vertices
+     */
+    CompressedAdjacency() = default;
+
+    /**
+     * @brief Encode a CSR adjacency, ignoring its weights
+     * @param csr Adjacency to encode
+     * @param threads Number of worker threads (non-positive selects hardware concurrency)
+     * @throw std::overflow_error if a block of 64 rows encodes to more than 4 GiB
+     */
+    explicit CompressedAdjacency(const CsrAdjacency& csr, int threads = 0);
+
+    class Encoder;
+
+    /**
+     * @brief Call fn(u) for every out-neighbour u of v, in increasing order
+     * @param v Vertex
+     * @param fn Callback receiving each neighbour
+     */
+    template<typename Fn>
+    void for_each_neighbour(int v, Fn&& fn) const {
+        const std::uint8_t* p = row(v);
+        std::uint32_t count = read_varint(p);
+        if (count == 0) return;
+        std::uint32_t zigzag = read_varint(p);
+        int u = v + static_cast<int>((zigzag >> 1) ^ (0u - (zigzag & 1)));
+        fn(u);
+        for (std::uint32_t i = 1; i < count; ++i) {
+            u += static_cast<int>(read_varint(p));
+            fn(u);
+        }
+    }
+
+    /**
+     * @class Cursor
+     * @brief Resumable decoding position in a row, used by the explicit-stack DFS engine
+     */
+    class Cursor {
+    private:
+        const std::uint8_t* _next;
+        std::uint32_t _remaining;
+        int _last;
+        bool _first;
+
+    public:
+        Cursor(const std::uint8_t* row, int v) : _next(row), _last(v) {
+            _remaining = read_varint(_next);
+            _first = true;
+        }
+
+        /**
+         * @brief Decode the next neighbour
+         * @param u Receives the neighbour
+         * @return bool False once the row is exhausted
+         */
+        bool next(int& u) {
+            if (_remaining == 0) return false;
+            std::uint32_t value = read_varint(_next);
+            // The first value is the zigzag-encoded distance from v, the rest are gaps.
+            if (_first) {
+                _last += static_cast<int>((value >> 1) ^ (0u - (value & 1)));
+                _first = false;
+            } else {
+                _last += static_cast<int>(value);
+            }
+            --_remaining;
+            u = _last;
+            return true;
+        }
+    };
+
+    /**
+     * @brief Get a cursor positioned before the first out-neighbour of v
+     * @param v Vertex
+     * @return Cursor Cursor over the row of v
+     */
+    [[nodiscard]] Cursor cursor(int v) const { return Cursor(row(v), v); }
+
+    /**
+     * @brief Decode the out-neighbours of a vertex
+     * @param v Vertex
+     * @return std::vector<int> Neighbours in increasing order
+     */
+    [[nodiscard]] std::vector<int> neighbours(int v) const;
+
+    /**
+     * @brief Get the out-degree of a vertex
+     * @param v Vertex
+     * @return int Number of arcs leaving v
+     */
+    [[nodiscard]] int degree(int v) const {
+        const std::uint8_t* p = row(v);
+        return static_cast<int>(read_varint(p));
+    }
+
+    /**
+     * @brief Get the number of vertices
+     * @return int Number of vertices
+     */
+    [[nodiscard]] int size() const { return _size; }
+
+    /**
+     * @brief Get the total number of arcs
+     * @return std::size_t Number of arcs
+     */
+    [[nodiscard]] std::size_t arc_count() const { return _arcs; }
+
+    /**
+     * @brief Get the memory used by the encoded rows and their offsets
+     * @return std::size_t Size in bytes
+     */
+    [[nodiscard]] std::size_t byte_size() const {
+        return _bytes.size() + _block_offsets.size() * sizeof(std::uint64_t) +
+               _row_offsets.size() * sizeof(std::uint32_t);
+    }
+};
+
+/**
+ * @class CompressedAdjacency::Encoder
+ * @brief Builds a CompressedAdjacency one row at a time, in vertex order
+ *
+ * Only the encoded bytes and the current row are kept in memory, so a graph can be compressed
+ * while it is generated or streamed, without materialising its CSR arrays.
+ */
+class CompressedAdjacency::Encoder {
+private:
+    CompressedAdjacency _result; ///< Adjacency under construction
+    int _next = 0;               ///< Vertex whose row is added next
+    std::vector<int> _row;       ///< Sorted copy of the current row
+
+public:
+    /**
+     * @brief Start encoding an adjacency
+     * @param size Number of vertices
+     * @throw std::invalid_argument if size is negative
+     */
+    explicit Encoder(int size);
+
+    /**
+     * @brief Append the out-neighbours of the next vertex (0 for the first call, then 1, ...)
+     * @param neighbours Out-neighbours in any order
+     * @throw std::out_of_range if every row has been added or a neighbour is out of range
+     * @throw std::overflow_error if the row has more than INT_MAX neighbours or its block
+     *        has grown beyond 4 GiB
+     */
+    void add_row(std::span<const int> neighbours);
+
+    /**
+     * @brief Get the vertex whose row add_row() appends next
+     * @return int Next vertex (size() once every row has been added)
+     */
+    [[nodiscard]] int next_vertex() const { return _next; }
+
+    /**
+     * @brief Finish the encoding; vertices without an added row get no out-neighbours
+     * @return CompressedAdjacency Encoded adjacency
+     */
+    [[nodiscard]] CompressedAdjacency finish() &&;
+};
+
+#endif // COMPRESSED_ADJACENCY_H
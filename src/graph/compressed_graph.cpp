@@ -0,0 +1,40 @@
+#include "compressed_graph.h"
+#include <stdexcept>
+#include "src/graph/graph_file.h"
+#include "src/graph/traversal.h"
+
+CompressedGraph::CompressedGraph(CompressedAdjacency adjacency) : _adjacency(std::move(adjacency)) {}
+
+CompressedGraph CompressedGraph::load(const std::string& filename, bool verify, int threads) {
+    return CompressedGraph(CompressedAdjacency(map_graph_file(filename, GraphFileKind::Directed, verify).first, threads));
+}
+
+std::pair<std::vector<int>, std::vector<int>> CompressedGraph::bfs(int start) const {
+    if (start < 0 || start >= size()) {
+        throw std::out_of_range("Start vertex index out of range");
+    }
+    return breadth_first_tree(_adjacency, start);
+}
+
+std::pair<std::vector<int>, std::vector<int>> CompressedGraph::dfs(int start) const {
+    if (start < 0 || start >= size()) {
+        throw std::out_of_range("Start vertex index out of range");
+    }
+    return depth_first_tree(_adjacency, start);
+}
+
+std::vector<int> CompressedGraph::topological_sort() const {
+    return kahn_topological_order(_adjacency);
+}
+
+std::vector<int> CompressedGraph::neighbours(int v) const {
+    if (v < 0 || v >= size()) {
+        throw std::out_of_range("Vertex index out of range");
+    }
+    return _adjacency.neighbours(v);
+}
+
+double CompressedGraph::bytes_per_edge() const {
+    if (edge_count() == 0) return 0;
+    return static_cast<double>(byte_size()) / static_cast<double>(edge_count());
+}
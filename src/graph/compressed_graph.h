@@ -0,0 +1,111 @@
+#ifndef COMPRESSED_GRAPH_H
+#define COMPRESSED_GRAPH_H
+
+#include <vector>
+#include <string>
+#include <utility>
+#include <cstddef>
+#include "src/graph/compressed_adjacency.h"
+
+/**
+ * @class CompressedGraph
+ * @brief A read-only directed unweighted graph stored in compressed form.
+ *
+ * Holds a CompressedAdjacency, which typically needs one to two bytes per edge instead of the
+ * four of CSR storage, and runs BFS, DFS and topological sorting directly on the encoded rows.
+ * The traversals are the same as UnweightedGraph's (see traversal.h); as rows are stored
+ * sorted, results match an UnweightedGraph whose neighbour lists are sorted, e.g. one
+ * relabelled with the identity permutation.
+ *
+ * Obtain one with UnweightedGraph::compressed(), from a file written by UnweightedGraph::save()
+ * with load(), or row by row with a CompressedAdjacency::Encoder. The last two never hold
+ * the uncompressed graph in memory.
+ *
+ * @note Vertices are zero-indexed.
+ */
+class CompressedGraph {
+private:
+    CompressedAdjacency _adjacency; ///< Encoded out-arcs
+
+public:
+    /**
+     * @brief Construct a graph from an encoded adjacency
+     * @param adjacency Encoded out-arcs
+     */
+    explicit CompressedGraph(CompressedAdjacency adjacency);
+
+    /**
+     * @brief Compress a graph file written by UnweightedGraph::save()
+     *
+     * The file is memory-mapped and encoded straight from the mapping, so its arrays are only
+     * paged in, never copied; graphs whose CSR does not fit in memory can be compressed this
+     * way.
+     *
+     * @param filename Source path
+     * @param verify Whether to validate the payload checksum and contents, not just the header
+     * @param threads Number of worker threads (non-positive selects hardware concurrency)
+     * @return CompressedGraph Compressed graph
+     * @throw std::runtime_error if the file cannot be read or does not hold a UnweightedGraph
+     */
+    [[nodiscard]] static CompressedGraph load(const std::string& filename, bool verify = true, int threads = 0);
+
+    /**
+     * @brief Perform Breadth-First Search (BFS) starting from a given vertex
+     * @param start Starting vertex for BFS
+     * @return std::pair<std::vector<int>, std::vector<int>>
+     *         First vector: parent of each vertex in BFS tree (-1 for unreachable vertices)
+     *         Second vector: distance from start to each vertex (-1 for unreachable vertices)
+     * @throw std::out_of_range if start vertex is out of range
+     */
+    [[nodiscard]] std::pair<std::vector<int>, std::vector<int>> bfs(int start) const;
+
+    /**
+     * @brief Perform iterative Depth-First Search (DFS) starting from a given vertex
+     * @param start Starting vertex for DFS
+     * @return std::pair<std::vector<int>, std::vector<int>>
+     *         First vector: parent of each vertex in DFS tree (-1 for unreachable vertices)
+     *         Second vector: discovery time of each vertex (-1 for unreachable vertices)
+     * @throw std::out_of_range if start vertex is out of range
+     */
+    [[nodiscard]] std::pair<std::vector<int>, std::vector<int>> dfs(int start) const;
+
+    /**
+     * @brief Perform topological sorting of the graph
+     * @return std::vector<int> Topologically sorted vertices (empty if graph has cycles)
+     */
+    [[nodiscard]] std::vector<int> topological_sort() const;
+
+    /**
+     * @brief Decode the out-neighbours of a vertex
+     * @param v Vertex
+     * @return std::vector<int> Neighbours in increasing order
+     * @throw std::out_of_range if v is out of range
+     */
+    [[nodiscard]] std::vector<int> neighbours(int v) const;
+
+    /**
+     * @brief Get the number of vertices
+     * @return int Number of vertices
+     */
+    [[nodiscard]] int size() const { return _adjacency.size(); }
+
+    /**
+     * @brief Get the number of edges
+     * @return std::size_t Number of edges
+     */
+    [[nodiscard]] std::size_t edge_count() const { return _adjacency.arc_count(); }
+
+    /**
+     * @brief Get the memory used by the adjacency
+     * @return std::size_t Size in bytes, row offsets included
+     */
+    [[nodiscard]] std::size_t byte_size() const { return _adjacency.byte_size(); }
+
+    /**
+     * @brief Get the average memory cost of an edge
+     * @return double Bytes per edge, row offsets included (0 for a graph without edges)
+     */
+    [[nodiscard]] double bytes_per_edge() const;
+};
+
+#endif // COMPRESSED_GRAPH_H
@@ -0,0 +1,130 @@
+#include "connected_components.h"
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <unordered_map>
+#include "src/graph/parallel.h"
+
+namespace {
+
+constexpr int sampled_arcs = 2;
+constexpr int sample_size = 1024;
+
+/**
+ * @brief Union the trees of u and v, hooking the larger root under the smaller one
+ *
+ * A failed compare-and-swap means another worker just hooked that root; the loop then
+ * retries with the new roots.
+ */
+inline void link(std::vector<int>& parent, int u, int v) {
+    auto load = [&](int x) { return std::atomic_ref<int>(parent[x]).load(std::memory_order_relaxed); };
+    int p1 = load(u), p2 = load(v);
+    while (p1 != p2) {
+        int high = std::max(p1, p2), low = std::min(p1, p2);
+        int p_high = load(high);
+        if (p_high == low) break;
+        if (p_high == high && std::atomic_ref<int>(parent[high]).compare_exchange_strong(p_high, low,
+                                                                                         std::memory_order_relaxed)) {
+            break;
+        }
+        p1 = load(load(high));
+        p2 = load(low);
+    }
+}
+
+/**
+ * @brief Point every vertex directly at its root
+ */
+void compress(std::vector<int>& parent, int threads) {
+    parallel_for(0, static_cast<int>(parent.size()), threads, [&](int, int lo, int hi) {
+        for (int v = lo; v < hi; ++v) {
+            auto at = [&](int x) { return std::atomic_ref<int>(parent[x]).load(std::memory_order_relaxed); };
+            int root = at(v);
+            while (root != at(root)) root = at(root);
+            std::atomic_ref<int>(parent[v]).store(root, std::memory_order_relaxed);
+        }
+    }, 4096);
+}
+
+} // namespace
+
+ConnectedComponents afforest_components(const CsrAdjacency& adjacency, const CsrAdjacency* reverse, int threads) {
+    threads = resolve_thread_count(threads);
+    const int n = adjacency.size();
+    ConnectedComponents result;
+    std::vector<int>& parent = result.component;
+    parent.resize(n);
+    parallel_for(0, n, threads, [&](int, int lo, int hi) {
+        for (int v = lo; v < hi; ++v) parent[v] = v;
+    }, 4096);
+    if (n == 0) return result;
+
+    for (int round = 0; round < sampled_arcs; ++round) {
+        parallel_for(0, n, threads, [&](int, int lo, int hi) {
+            for (int u = lo; u < hi; ++u) {
+                std::span<const int> targets = adjacency.neighbours(u);
+                if (round < static_cast<int>(targets.size())) link(parent, u, targets[round]);
+            }
+        }, 1024);
+        compress(parent, threads);
+    }
+
+    // The most frequent root in a fixed sample is, with high probability, the giant component.
+    std::mt19937 gen(27491095);
+    std::uniform_int_distribution<int> vertex(0, n - 1);
+    std::unordered_map<int, int> frequency;
+    for (int i = 0; i < sample_size; ++i) frequency[parent[vertex(gen)]]++;
+    const int giant = std::ranges::max_element(frequency, {}, [](const auto& entry) { return entry.second; })->first;
+
+    parallel_for(0, n, threads, [&](int, int lo, int hi) {
+        for (int u = lo; u < hi; ++u) {
+            if (std::atomic_ref<int>(parent[u]).load(std::memory_order_relaxed) == giant) continue;
+            std::span<const int> targets = adjacency.neighbours(u);
+            for (std::size_t i = sampled_arcs; i < targets.size(); ++i) link(parent, u, targets[i]);
+            if (reverse) {
+                for (int v : reverse->neighbours(u)) link(parent, u, v);
+            }
+        }
+    }, 1024);
+    compress(parent, threads);
+
+    // Roots are the smallest vertex of their component; numbering them in vertex order gives
+    // labels independent of the schedule. Each worker numbers the roots of its own range.
+    std::vector<int> label(n);
+    std::vector<int> roots_before(threads + 1, 0);
+    int used = parallel_for(0, n, threads, [&](int worker, int lo, int hi) {
+        int roots = 0;
+        for (int v = lo; v < hi; ++v) roots += parent[v] == v;
+        roots_before[worker + 1] = roots;
+    }, 4096);
+    for (int t = 0; t < used; ++t) roots_before[t + 1] += roots_before[t];
+    result.count = roots_before[used];
+    parallel_for(0, n, threads, [&](int worker, int lo, int hi) {
+        int next = roots_before[worker];
+        for (int v = lo; v < hi; ++v) {
+            if (parent[v] == v) label[v] = next++;
+        }
+    }, 4096);
+
+    // The giant component would make every worker contend on one counter, so it is counted
+    // locally and added once.
+    result.sizes.assign(result.count, 0);
+    const int giant_root = parent[giant];
+    parallel_for(0, n, threads, [&](int, int lo, int hi) {
+        int giant_size = 0;
+        for (int v = lo; v < hi; ++v) {
+            int root = parent[v];
+            if (root == giant_root) {
+                ++giant_size;
+            } else {
+                std::atomic_ref<int>(result.sizes[label[root]]).fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        std::atomic_ref<int>(result.sizes[label[giant_root]]).fetch_add(giant_size, std::memory_order_relaxed);
+    }, 4096);
+
+    parallel_for(0, n, threads, [&](int, int lo, int hi) {
+        for (int v = lo; v < hi; ++v) parent[v] = label[parent[v]];
+    }, 4096);
+    return result;
+}
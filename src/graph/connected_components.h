@@ -0,0 +1,45 @@
+#ifndef CONNECTED_COMPONENTS_H
+#define CONNECTED_COMPONENTS_H
+
+#include <vector>
+#include "src/graph/csr.h"
+
+/**
+ * @struct ConnectedComponents
+ * @brief Connected component label and size of every component.
+ *
+ * Components are numbered 0 .. count - 1 in increasing order of their smallest vertex, so
+ * the labelling does not depend on the algorithm or the number of threads.
+ */
+struct ConnectedComponents {
+    int count = 0;              ///< Number of components
+    std::vector<int> component; ///< Component label of each vertex
+    std::vector<int> sizes;     ///< Number of vertices in each component
+};
+
+/**
+ * @brief Find connected components with the Afforest algorithm
+ *
+ * Every vertex starts as its own tree in a shared parent array, and arcs are linked by
+ * hooking the larger of the two roots under the smaller one with a compare-and-swap, so
+ * workers never take locks and each root is the smallest vertex of its tree.
+ *
+ *  1. Sampling rounds: link only the first two arcs of every vertex, then compress all
+ *     paths. On graphs with a giant component this already joins most of it.
+ *  2. Estimate the largest intermediate component from a fixed sample of vertices.
+ *  3. Link the remaining arcs of every vertex outside that component; its own vertices
+ *     are skipped, since any arc leaving it is seen from the other end.
+ *
+ * Step 3 relies on seeing every arc from both ends, which holds for symmetric adjacencies.
+ * For directed graphs pass the reverse adjacency, whose arcs are linked as well; the result
+ * then holds the weakly connected components.
+ *
+ * @param adjacency Graph adjacency
+ * @param reverse Reverse adjacency for directed graphs, nullptr if adjacency is symmetric
+ * @param threads Number of worker threads (non-positive selects hardware concurrency)
+ * @return ConnectedComponents Component labels and sizes
+ */
+[[nodiscard]] ConnectedComponents afforest_components(const CsrAdjacency& adjacency, const CsrAdjacency* reverse,
+                                                      int threads = 0);
+
+#endif // CONNECTED_COMPONENTS_H
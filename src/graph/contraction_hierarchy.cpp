@@ -0,0 +1,373 @@
+#include "contraction_hierarchy.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include "src/graph/parallel.h"
+#include "src/graph/saturating.h"
+
+struct ContractionHierarchy::OverlayArc {
+    int to;     ///< Neighbour
+    int weight; ///< Arc weight
+    int middle; ///< Bypassed vertex for shortcuts, -1 for original edges
+};
+
+namespace {
+
+constexpr int infinity = std::numeric_limits<int>::max();
+constexpr int witness_settle_limit = 500;  ///< Settled vertices after which a witness search gives up
+constexpr int simulate_settle_limit = 50;  ///< Cheaper limit used when only estimating priorities
+constexpr char ch_magic[8] = {'D', 'S', 'A', '-', 'C', 'H', '\0', '\0'};
+constexpr std::uint32_t ch_version = 1;
+
+template<typename T>
+void write_array(std::ofstream& out, const std::vector<T>& values) {
+    out.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+}
+
+template<typename T>
+void read_array(std::ifstream& in, std::vector<T>& values, std::size_t count) {
+    values.resize(count);
+    in.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(count * sizeof(T)));
+}
+
+} // namespace
+
+ContractionHierarchy::ContractionHierarchy(const WeightedGraph& graph, int threads)
+    : _size(graph.size()), _rank(graph.size(), -1) {
+    threads = resolve_thread_count(threads);
+
+    // Overlay graph: one arc per neighbour, parallel edges collapsed to the lightest.
+    Overlay overlay(_size);
+    for (int u = 0; u < _size; ++u) {
+        for (auto [v, w] : graph.get_adj_list()[u]) {
+            if (v != u) overlay[u].push_back({v, w, -1});
+        }
+        auto& arcs = overlay[u];
+        std::sort(arcs.begin(), arcs.end(), [](const OverlayArc& a, const OverlayArc& b) {
+            return a.to != b.to ? a.to < b.to : a.weight < b.weight;
+        });
+        arcs.erase(std::unique(arcs.begin(), arcs.end(), [](const OverlayArc& a, const OverlayArc& b) {
+            return a.to == b.to;
+        }), arcs.end());
+    }
+
+    std::vector<int> priority(_size);
+    std::vector<SearchWorkspace> workspaces(threads);
+    parallel_for(0, _size, threads, [&](int worker, int lo, int hi) {
+        for (int v = lo; v < hi; ++v) {
+            priority[v] = contract(overlay, v, workspaces[worker], true) - static_cast<int>(overlay[v].size());
+        }
+    }, 256);
+
+    std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<>> pq;
+    for (int v = 0; v < _size; ++v) pq.emplace(priority[v], v);
+
+    std::vector<int> contracted_neighbours(_size, 0);
+    std::vector<std::pair<int, OverlayArc>> upward;
+    SearchWorkspace& workspace = workspaces[0];
+    int next_rank = 0;
+
+    while (!pq.empty()) {
+        int v = pq.top().second;
+        pq.pop();
+
+        // Lazy update: priorities of untouched vertices may be stale, so re-evaluate before contracting.
+        int current = contract(overlay, v, workspace, true) - static_cast<int>(overlay[v].size())
+                      + contracted_neighbours[v];
+        if (!pq.empty() && current > pq.top().first) {
+            pq.emplace(current, v);
+            continue;
+        }
+
+        _rank[v] = next_rank++;
+        contract(overlay, v, workspace, false);
+        for (const auto& arc : overlay[v]) {
+            upward.emplace_back(v, arc);
+            auto& back = overlay[arc.to];
+            back.erase(std::find_if(back.begin(), back.end(), [v](const OverlayArc& a) { return a.to == v; }));
+            contracted_neighbours[arc.to]++;
+        }
+        overlay[v].clear();
+        overlay[v].shrink_to_fit();
+    }
+
+    _offsets.assign(_size + 1, 0);
+    for (const auto& [from, arc] : upward) _offsets[from + 1]++;
+    for (int v = 0; v < _size; ++v) _offsets[v + 1] += _offsets[v];
+    _targets.resize(upward.size());
+    _weights.resize(upward.size());
+    _middles.resize(upward.size());
+    std::vector<int> cursor(_offsets.begin(), _offsets.end() - 1);
+    for (const auto& [from, arc] : upward) {
+        int slot = cursor[from]++;
+        _targets[slot] = arc.to;
+        _weights[slot] = arc.weight;
+        _middles[slot] = arc.middle;
+    }
+}
+
+void ContractionHierarchy::witness_search(const Overlay& overlay, int source, int excluded,
+                                          const std::vector<OverlayArc>& targets, std::size_t first_target,
+                                          long long limit, int settle_limit, SearchWorkspace& workspace) {
+    workspace.begin(static_cast<int>(overlay.size()), infinity);
+    std::vector<int>& dist = workspace._distance[0];
+    std::vector<std::pair<int, int>>& heap = workspace._heap[0];
+    for (std::size_t j = first_target; j < targets.size(); ++j) {
+        workspace.touch(targets[j].to);
+        workspace.flag(targets[j].to); // not settled yet
+    }
+    workspace.touch(source);
+    dist[source] = 0;
+    heap.emplace_back(0, source);
+    std::size_t remaining = targets.size() - first_target;
+
+    for (int settled = 0; !heap.empty() && settled < settle_limit && remaining > 0;) {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<>());
+        auto [d, x] = heap.back();
+        heap.pop_back();
+        if (d > dist[x]) continue;
+        if (d > limit) break;
+        ++settled;
+        if (workspace.flagged(x)) {
+            workspace.unflag(x);
+            --remaining;
+        }
+
+        for (const auto& arc : overlay[x]) {
+            if (arc.to == excluded) continue;
+            workspace.touch(arc.to);
+            int candidate = saturating_add(d, arc.weight);
+            if (candidate < dist[arc.to]) {
+                dist[arc.to] = candidate;
+                heap.emplace_back(dist[arc.to], arc.to);
+                std::push_heap(heap.begin(), heap.end(), std::greater<>());
+            }
+        }
+    }
+}
+
+int ContractionHierarchy::contract(Overlay& overlay, int v, SearchWorkspace& workspace, bool simulate) {
+    const std::vector<OverlayArc>& arcs = overlay[v];
+
+    int shortcuts = 0;
+    for (std::size_t i = 0; i + 1 < arcs.size(); ++i) {
+        int u = arcs[i].to;
+        int max_weight = 0;
+        for (std::size_t j = i + 1; j < arcs.size(); ++j) max_weight = std::max(max_weight, arcs[j].weight);
+        witness_search(overlay, u, v, arcs, i + 1, static_cast<long long>(arcs[i].weight) + max_weight,
+                       simulate ? simulate_settle_limit : witness_settle_limit, workspace);
+
+        for (std::size_t j = i + 1; j < arcs.size(); ++j) {
+            int w = arcs[j].to;
+            long long via = static_cast<long long>(arcs[i].weight) + arcs[j].weight;
+            if (workspace.distance(w) <= via) continue; // witness path found
+
+            ++shortcuts;
+            if (simulate) continue;
+
+            // Longer than any int distance: saturates like the paths it replaces.
+            int weight = static_cast<int>(std::min<long long>(via, infinity));
+            auto& from_u = overlay[u];
+            auto existing = std::find_if(from_u.begin(), from_u.end(), [w](const OverlayArc& a) { return a.to == w; });
+            if (existing == from_u.end()) {
+                from_u.push_back({w, weight, v});
+                overlay[w].push_back({u, weight, v});
+            } else if (weight < existing->weight) {
+                *existing = {w, weight, v};
+                auto& from_w = overlay[w];
+                *std::find_if(from_w.begin(), from_w.end(), [u](const OverlayArc& a) { return a.to == u; }) = {u, weight, v};
+            }
+        }
+    }
+    return shortcuts;
+}
+
+int ContractionHierarchy::distance(int start, int end) const {
+    SearchWorkspace::Lease workspace;
+    return distance(start, end, *workspace);
+}
+
+int ContractionHierarchy::distance(int start, int end, SearchWorkspace& workspace) const {
+    int meeting_vertex;
+    return search(start, end, workspace, meeting_vertex);
+}
+
+std::pair<int, std::vector<int>> ContractionHierarchy::path(int start, int end) const {
+    SearchWorkspace::Lease lease;
+    SearchWorkspace& workspace = *lease;
+    int meeting_vertex;
+    int distance = search(start, end, workspace, meeting_vertex);
+    if (distance == -1) return {-1, {}};
+
+    std::vector<int> peak_path;
+    for (int v = meeting_vertex; v != -1; v = workspace._parent[0][v]) peak_path.push_back(v);
+    std::reverse(peak_path.begin(), peak_path.end());
+    for (int v = workspace._parent[1][meeting_vertex]; v != -1; v = workspace._parent[1][v]) peak_path.push_back(v);
+
+    std::vector<int> result{start};
+    for (std::size_t i = 1; i < peak_path.size(); ++i) {
+        unpack(peak_path[i - 1], peak_path[i], result);
+    }
+    return {distance, result};
+}
+
+int ContractionHierarchy::search(int start, int end, SearchWorkspace& workspace, int& meeting_vertex) const {
+    if (start < 0 || start >= _size || end < 0 || end >= _size) {
+        throw std::out_of_range("Vertex index out of range");
+    }
+
+    workspace.begin(_size, infinity);
+    std::vector<int>* dist = workspace._distance;
+    std::vector<int>* parent = workspace._parent;
+    std::vector<std::pair<int, int>>* heap = workspace._heap;
+
+    workspace.touch(start);
+    workspace.touch(end);
+    dist[0][start] = 0;
+    dist[1][end] = 0;
+    heap[0].emplace_back(0, start);
+    heap[1].emplace_back(0, end);
+    long long best = infinity;
+    meeting_vertex = -1;
+    bool active[2] = {true, true};
+
+    while (active[0] || active[1]) {
+        int side = !active[0] ? 1 : !active[1] ? 0 : heap[0].front().first <= heap[1].front().first ? 0 : 1;
+        if (heap[side].empty() || heap[side].front().first >= best) {
+            active[side] = false;
+            continue;
+        }
+
+        std::pop_heap(heap[side].begin(), heap[side].end(), std::greater<>());
+        auto [d, x] = heap[side].back();
+        heap[side].pop_back();
+        if (heap[side].empty()) active[side] = false;
+        if (d > dist[side][x]) continue;
+
+        if (dist[1 - side][x] != infinity && static_cast<long long>(d) + dist[1 - side][x] < best) {
+            best = static_cast<long long>(d) + dist[1 - side][x];
+            meeting_vertex = x;
+        }
+
+        for (int i = _offsets[x]; i < _offsets[x + 1]; ++i) {
+            int y = _targets[i];
+            workspace.touch(y);
+            int candidate = saturating_add(d, _weights[i]);
+            if (candidate < dist[side][y]) {
+                dist[side][y] = candidate;
+                parent[side][y] = x;
+                heap[side].emplace_back(dist[side][y], y);
+                std::push_heap(heap[side].begin(), heap[side].end(), std::greater<>());
+                active[side] = true;
+            }
+        }
+    }
+
+    return meeting_vertex == -1 ? -1 : static_cast<int>(best);
+}
+
+void ContractionHierarchy::unpack(int a, int b, std::vector<int>& path) const {
+    int low = _rank[a] < _rank[b] ? a : b;
+    int high = low == a ? b : a;
+
+    int middle = -1;
+    for (int i = _offsets[low]; i < _offsets[low + 1]; ++i) {
+        if (_targets[i] == high) {
+            middle = _middles[i];
+            break;
+        }
+    }
+
+    if (middle == -1) {
+        path.push_back(b);
+    } else {
+        unpack(a, middle, path);
+        unpack(middle, b, path);
+    }
+}
+
+void ContractionHierarchy::save(const std::string& filename) const {
+    std::ofstream out(filename, std::ios::binary);
+    if (!out) {
+        throw std::runtime_error("Cannot open file for writing: " + filename);
+    }
+
+    std::int32_t size = _size;
+    std::uint64_t arcs = _targets.size();
+    out.write(ch_magic, sizeof(ch_magic));
+    out.write(reinterpret_cast<const char*>(&ch_version), sizeof(ch_version));
+    out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    out.write(reinterpret_cast<const char*>(&arcs), sizeof(arcs));
+    write_array(out, _rank);
+    write_array(out, _offsets);
+    write_array(out, _targets);
+    write_array(out, _weights);
+    write_array(out, _middles);
+
+    if (!out) {
+        throw std::runtime_error("Failed to write contraction hierarchy: " + filename);
+    }
+}
+
+ContractionHierarchy ContractionHierarchy::load(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Cannot open file for reading: " + filename);
+    }
+
+    char magic[sizeof(ch_magic)];
+    std::uint32_t version = 0;
+    std::int32_t size = 0;
+    std::uint64_t arcs = 0;
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(&version), sizeof(version));
+    in.read(reinterpret_cast<char*>(&size), sizeof(size));
+    in.read(reinterpret_cast<char*>(&arcs), sizeof(arcs));
+    if (!in || std::memcmp(magic, ch_magic, sizeof(ch_magic)) != 0) {
+        throw std::runtime_error("Not a contraction hierarchy file: " + filename);
+    }
+    if (version != ch_version) {
+        throw std::runtime_error("Unsupported contraction hierarchy version in " + filename);
+    }
+    if (size < 0 || arcs > static_cast<std::uint64_t>(std::numeric_limits<int>::max())) {
+        throw std::runtime_error("Corrupt contraction hierarchy header in " + filename);
+    }
+
+    ContractionHierarchy ch;
+    ch._size = size;
+    read_array(in, ch._rank, size);
+    read_array(in, ch._offsets, static_cast<std::size_t>(size) + 1);
+    read_array(in, ch._targets, arcs);
+    read_array(in, ch._weights, arcs);
+    read_array(in, ch._middles, arcs);
+    if (!in) {
+        throw std::runtime_error("Truncated contraction hierarchy file: " + filename);
+    }
+
+    bool valid = ch._offsets.front() == 0 && ch._offsets.back() == static_cast<int>(arcs)
+                 && std::is_sorted(ch._offsets.begin(), ch._offsets.end());
+    // Ranks must be a permutation, so every rank comparison below is meaningful.
+    std::vector<char> seen(size, 0);
+    for (int v = 0; valid && v < size; ++v) {
+        int rank = ch._rank[v];
+        valid = rank >= 0 && rank < size && !seen[rank];
+        if (valid) seen[rank] = 1;
+    }
+    // Arcs lead upwards and a shortcut's middle ranks below both ends; unpack() recurses on
+    // strictly lower ranks only because of this.
+    for (int v = 0; valid && v < size; ++v) {
+        for (int i = ch._offsets[v]; valid && i < ch._offsets[v + 1]; ++i) {
+            int target = ch._targets[i], middle = ch._middles[i];
+            valid = target >= 0 && target < size && ch._rank[v] < ch._rank[target] && ch._weights[i] >= 0
+                    && (middle == -1 || (middle >= 0 && middle < size && ch._rank[middle] < ch._rank[v]));
+        }
+    }
+    if (!valid) {
+        throw std::runtime_error("Corrupt contraction hierarchy data in " + filename);
+    }
+    return ch;
+}
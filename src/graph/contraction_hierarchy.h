@@ -0,0 +1,176 @@
+#ifndef CONTRACTION_HIERARCHY_H
+#define CONTRACTION_HIERARCHY_H
+
+#include <vector>
+#include <string>
+#include <utility>
+#include "src/graph/weighted_graph.h"
+#include "src/graph/search_workspace.h"
+
+/**
+ * @class ContractionHierarchy
+ * @brief Contraction hierarchies (CH) preprocessing and query engine for a WeightedGraph.
+ *
+ * Preprocessing contracts vertices one by one in order of increasing importance. Removing a
+ * vertex v inserts a shortcut u - w between two of its neighbours whenever u - v - w is the
+ * only shortest u - w path (checked with a bounded local "witness" Dijkstra search). Each
+ * vertex receives its contraction rank and keeps the edges to neighbours contracted after
+ * it, forming the upward search graph.
+ *
+ * A query runs Dijkstra upwards from both endpoints in that small graph; the shortest path
+ * always has this up-then-down shape, so distance queries touch only a few hundred vertices
+ * even on continent-sized road networks. Shortcuts remember the vertex they bypass, so paths
+ * are recovered by recursively unpacking them.
+ *
+ * The vertex order is chosen lazily by edge difference (shortcuts added minus edges removed)
+ * plus the number of already contracted neighbours. Initial priorities are computed in
+ * parallel; contraction itself is sequential.
+ *
+ * A hierarchy can be saved to and loaded from a versioned binary file, so preprocessing does
+ * not have to be repeated on every process start.
+ *
+ * @note Vertices are zero-indexed and keep the ids of the source graph.
+ */
+class ContractionHierarchy {
+private:
+    int _size = 0;              ///< Number of vertices
+    std::vector<int> _rank;     ///< Contraction order position of each vertex
+    std::vector<int> _offsets;  ///< Upward-graph row offsets, _size + 1 entries
+    std::vector<int> _targets;  ///< Higher-ranked neighbour of each upward arc
+    std::vector<int> _weights;  ///< Weight of each upward arc
+    std::vector<int> _middles;  ///< Bypassed vertex of each shortcut (-1 for original edges)
+
+    struct OverlayArc;
+    using Overlay = std::vector<std::vector<OverlayArc>>;
+
+    ContractionHierarchy() = default;
+
+public:
+    /**
+     * @brief Preprocess a graph into a contraction hierarchy
+     * @param graph Graph to preprocess
+     * @param threads Number of worker threads for priority computation (non-positive selects
+     *                hardware concurrency)
+     */
+    explicit ContractionHierarchy(const WeightedGraph& graph, int threads = 0);
+
+    /**
+     * @brief Find the shortest distance between two vertices
+     * @param start Starting vertex
+     * @param end Ending vertex
+     * @return int Shortest distance from start to end (-1 if no path exists)
+     * @throw std::out_of_range if either vertex is out of range
+     */
+    [[nodiscard]] int distance(int start, int end) const;
+
+    /**
+     * @brief Find the shortest distance between two vertices reusing a caller-owned workspace
+     * @param start Starting vertex
+     * @param end Ending vertex
+     * @param workspace Workspace used for the search; costs O(touched vertices) to reuse
+     * @return int Shortest distance from start to end (-1 if no path exists)
+     * @throw std::out_of_range if either vertex is out of range
+     */
+    [[nodiscard]] int distance(int start, int end, SearchWorkspace& workspace) const;
+
+    /**
+     * @brief Find a shortest path between two vertices, with all shortcuts unpacked
+     * @param start Starting vertex
+     * @param end Ending vertex
+     * @return std::pair<int, std::vector<int>>
+     *         First: shortest distance from start to end (-1 if no path exists)
+     *         Second: vertices of the path in the original graph (empty if no path exists)
+     * @throw std::out_of_range if either vertex is out of range
+     */
+    [[nodiscard]] std::pair<int, std::vector<int>> path(int start, int end) const;
+
+    /**
+     * @brief Write the hierarchy to a binary file
+     * @param filename Destination path
+     * @throw std::runtime_error if the file cannot be written
+     */
+    void save(const std::string& filename) const;
+
+    /**
+     * @brief Read a hierarchy previously written by save()
+     *
+     * The whole file is validated before it is used: ranks must be a permutation, every arc
+     * must lead to a higher rank with a non-negative weight, and a shortcut's middle vertex
+     * must rank below both of its ends.
+     *
+     * @param filename Source path
+     * @return ContractionHierarchy Loaded hierarchy
+     * @throw std::runtime_error if the file cannot be read or is not a valid hierarchy
+     */
+    [[nodiscard]] static ContractionHierarchy load(const std::string& filename);
+
+    /**
+     * @brief Get the number of vertices
+     * @return int Number of vertices
+     */
+    [[nodiscard]] int size() const { return _size; }
+
+    /**
+     * @brief Get the contraction rank of a vertex (0 = contracted first)
+     * @param v Vertex
+     * @return int Rank of v
+     */
+    [[nodiscard]] int rank(int v) const { return _rank[v]; }
+
+    /**
+     * @brief Get the number of arcs in the upward search graph, shortcuts included
+     * @return std::size_t Number of upward arcs
+     */
+    [[nodiscard]] std::size_t arc_count() const { return _targets.size(); }
+
+private:
+    /**
+     * @brief Bounded Dijkstra from source in the overlay graph that never enters excluded
+     *
+     * Stops once every target has been settled, the distance limit is exceeded or enough
+     * vertices have been settled; vertices it did not reach report an infinite distance in the
+     * workspace.
+     *
+     * @param overlay Remaining (uncontracted) graph including shortcuts
+     * @param source Starting vertex
+     * @param excluded Vertex being contracted
+     * @param targets Arcs of the vertex being contracted
+     * @param first_target Index of the first arc in targets whose endpoint must be reached
+     * @param limit Largest distance of interest
+     * @param settle_limit Number of settled vertices after which the search gives up
+     * @param workspace Workspace receiving the distances
+     */
+    static void witness_search(const Overlay& overlay, int source, int excluded,
+                               const std::vector<OverlayArc>& targets, std::size_t first_target,
+                               long long limit, int settle_limit, SearchWorkspace& workspace);
+
+    /**
+     * @brief Determine the shortcuts needed to contract v and optionally insert them
+     * @param overlay Remaining (uncontracted) graph including shortcuts
+     * @param v Vertex to contract
+     * @param workspace Workspace for the witness searches
+     * @param simulate If true only count the shortcuts, leaving the overlay unchanged
+     * @return int Number of shortcuts required
+     */
+    static int contract(Overlay& overlay, int v, SearchWorkspace& workspace, bool simulate);
+
+    /**
+     * @brief Run the bidirectional upward search
+     * @param start Starting vertex
+     * @param end Ending vertex
+     * @param workspace Workspace holding both search frontiers
+     * @param meeting_vertex Receives the vertex where the shortest path peaks (-1 if none)
+     * @return int Shortest distance (-1 if no path exists)
+     */
+    int search(int start, int end, SearchWorkspace& workspace, int& meeting_vertex) const;
+
+    /**
+     * @brief Append the original-graph vertices of the arc a - b, excluding a, to path
+     * @param a First endpoint
+     * @param b Second endpoint
+     * @param path Output path
+     */
+    void unpack(int a, int b, std::vector<int>& path) const;
+};
+
+#endif // CONTRACTION_HIERARCHY_H
@@ -0,0 +1,213 @@
+#include "csr.h"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include "src/graph/parallel.h"
+
+CsrAdjacency::CsrAdjacency(int size, bool weighted)
+    : _size(size), _weighted(weighted), _offsets(size + 1, 0) {
+    rebind();
+}
+
+CsrAdjacency::CsrAdjacency(const CsrAdjacency& other)
+    : _size(other._size), _weighted(other._weighted), _offsets(other._offsets), _targets(other._targets),
+      _weights(other._weights), _storage(other._storage), _offset_view(other._offset_view),
+      _target_view(other._target_view), _weight_view(other._weight_view), _fill(other._fill) {
+    if (!_storage) rebind();
+}
+
+CsrAdjacency::CsrAdjacency(CsrAdjacency&& other) noexcept
+    : _size(other._size), _weighted(other._weighted), _offsets(std::move(other._offsets)),
+      _targets(std::move(other._targets)), _weights(std::move(other._weights)),
+      _storage(std::move(other._storage)), _offset_view(other._offset_view),
+      _target_view(other._target_view), _weight_view(other._weight_view), _fill(std::move(other._fill)) {
+    if (!_storage) rebind();
+    other.rebind();
+}
+
+CsrAdjacency& CsrAdjacency::operator=(const CsrAdjacency& other) {
+    if (this != &other) *this = CsrAdjacency(other);
+    return *this;
+}
+
+CsrAdjacency& CsrAdjacency::operator=(CsrAdjacency&& other) noexcept {
+    if (this != &other) {
+        _size = other._size;
+        _weighted = other._weighted;
+        _offsets = std::move(other._offsets);
+        _targets = std::move(other._targets);
+        _weights = std::move(other._weights);
+        _storage = std::move(other._storage);
+        _offset_view = other._offset_view;
+        _target_view = other._target_view;
+        _weight_view = other._weight_view;
+        _fill = std::move(other._fill);
+        if (!_storage) rebind();
+        other.rebind();
+    }
+    return *this;
+}
+
+CsrAdjacency CsrAdjacency::build(int size, bool weighted, std::span<const int> from, std::span<const int> to,
+                                 std::span<const int> weights, bool symmetric, int threads) {
+    CsrAdjacency result(size, weighted);
+    result.append_edges(from.size(), [&](std::size_t e) {
+        return Arc(from[e], to[e], weighted ? weights[e] : 0);
+    }, symmetric, threads);
+    return result;
+}
+
+CsrAdjacency CsrAdjacency::borrow(int size, bool weighted, std::span<const int> offsets,
+                                  std::span<const int> targets, std::span<const int> weights,
+                                  std::shared_ptr<const void> storage) {
+    CsrAdjacency result;
+    result._size = size;
+    result._weighted = weighted;
+    result._storage = std::move(storage);
+    result._offset_view = offsets;
+    result._target_view = targets;
+    result._weight_view = weights;
+    return result;
+}
+
+void CsrAdjacency::check_arc_count(std::size_t arcs) {
+    if (arcs > static_cast<std::size_t>(std::numeric_limits<int>::max())) {
+        throw std::overflow_error("Number of arcs does not fit in the index type");
+    }
+}
+
+void CsrAdjacency::rebind() {
+    _offset_view = _offsets;
+    _target_view = _targets;
+    _weight_view = _weights;
+}
+
+void CsrAdjacency::append(const std::vector<Arc>& arcs) {
+    compact();
+    if (arcs.empty()) return;
+    check_arc_count(arc_count() + arcs.size());
+
+    std::vector<int> offsets, targets, weights;
+    merge_csr_arcs<int, int>(_offset_view, _target_view, _weight_view, _weighted, [&](auto&& fn) {
+        for (const auto& arc : arcs) fn(arc.from, arc.to, arc.weight);
+    }, offsets, targets, weights);
+
+    _offsets = std::move(offsets);
+    _targets = std::move(targets);
+    _weights = std::move(weights);
+    _storage.reset();
+    rebind();
+}
+
+void CsrAdjacency::reserve(std::span<const int> extra) {
+    std::vector<int> filled(_size);
+    std::size_t total = 0;
+    for (int v = 0; v < _size; ++v) {
+        filled[v] = (_fill.empty() ? _offset_view[v + 1] : _fill[v]) - _offset_view[v];
+        total += std::max<std::size_t>(static_cast<std::size_t>(filled[v]) + extra[v], degree(v));
+    }
+    check_arc_count(total);
+
+    std::vector<int> offsets(_size + 1, 0);
+    for (int v = 0; v < _size; ++v) {
+        offsets[v + 1] = offsets[v] + std::max(filled[v] + extra[v], degree(v));
+    }
+
+    std::vector<int> targets(offsets[_size]);
+    std::vector<int> weights(_weighted ? offsets[_size] : 0);
+    for (int v = 0; v < _size; ++v) {
+        std::copy_n(_target_view.begin() + _offset_view[v], filled[v], targets.begin() + offsets[v]);
+        if (_weighted) std::copy_n(_weight_view.begin() + _offset_view[v], filled[v], weights.begin() + offsets[v]);
+        filled[v] += offsets[v];
+    }
+
+    _offsets = std::move(offsets);
+    _targets = std::move(targets);
+    _weights = std::move(weights);
+    _fill = std::move(filled);
+    _storage.reset();
+    rebind();
+}
+
+void CsrAdjacency::compact() {
+    if (_fill.empty()) return;
+
+    int write = 0;
+    for (int v = 0; v < _size; ++v) {
+        int begin = _offsets[v], end = _fill[v];
+        _offsets[v] = write;
+        std::copy(_targets.begin() + begin, _targets.begin() + end, _targets.begin() + write);
+        if (_weighted) std::copy(_weights.begin() + begin, _weights.begin() + end, _weights.begin() + write);
+        write += end - begin;
+    }
+    _offsets[_size] = write;
+    _targets.resize(write);
+    _targets.shrink_to_fit();
+    if (_weighted) {
+        _weights.resize(write);
+        _weights.shrink_to_fit();
+    }
+    _fill.clear();
+    rebind();
+}
+
+CsrAdjacency CsrAdjacency::permuted(std::span<const int> new_id, int threads) const {
+    const int n = _size;
+    const bool weighted = _weighted;
+    threads = resolve_thread_count(threads);
+
+    std::vector<int> offsets(n + 1, 0);
+    for (int v = 0; v < n; ++v) offsets[new_id[v] + 1] = degree(v);
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    CsrAdjacency result(n, weighted);
+    result._targets.resize(offsets[n]);
+    result._weights.resize(weighted ? offsets[n] : 0);
+    parallel_for(0, n, threads, [&](int, int lo, int hi) {
+        std::vector<std::pair<int, int>> row;
+        for (int v = lo; v < hi; ++v) {
+            std::span<const int> row_targets = neighbours(v);
+            row.resize(row_targets.size());
+            for (std::size_t i = 0; i < row_targets.size(); ++i) {
+                row[i] = {new_id[row_targets[i]], weighted ? weights(v)[i] : 0};
+            }
+            std::ranges::sort(row);
+            int slot = offsets[new_id[v]];
+            for (auto [target, weight] : row) {
+                result._targets[slot] = target;
+                if (weighted) result._weights[slot] = weight;
+                ++slot;
+            }
+        }
+    }, 256);
+
+    result._offsets = std::move(offsets);
+    result.rebind();
+    return result;
+}
+
+CsrAdjacency CsrAdjacency::transposed() const {
+    CsrAdjacency result(_size, _weighted);
+    // Only called on compacted adjacencies; gaps would be read as arcs.
+    for (int target : _target_view) {
+        result._offsets[target + 1]++;
+    }
+    for (int v = 0; v < _size; ++v) {
+        result._offsets[v + 1] += result._offsets[v];
+    }
+
+    result._targets.resize(_target_view.size());
+    if (_weighted) result._weights.resize(_weight_view.size());
+    std::vector<int> cursor(result._offsets.begin(), result._offsets.end() - 1);
+
+    for (int u = 0; u < _size; ++u) {
+        for (int i = _offset_view[u]; i < _offset_view[u + 1]; ++i) {
+            int slot = cursor[_target_view[i]]++;
+            result._targets[slot] = u;
+            if (_weighted) result._weights[slot] = _weight_view[i];
+        }
+    }
+    result.rebind();
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,591 @@
+#ifndef CSR_H
+#define CSR_H
+
+#include <vector>
+#include <span>
+#include <utility>
+#include <cstddef>
+#include <memory>
+#include <limits>
+#include <stdexcept>
+#include <numeric>
+#include <algorithm>
+#include "src/graph/parallel.h"
+
+/**
+ * @brief Merge staged arcs into CSR rows with a counting pass and a single fill pass
+ *
+ * Shared by CsrAdjacency and TypedCsrAdjacency. Existing neighbours keep their position;
+ * staged arcs are placed after them in the order for_each_arc() yields them. The merged
+ * arrays must not alias the input ones.
+ *
+ * @param offsets Current row offsets, size + 1 entries
+ * @param targets Current concatenated neighbour lists
+ * @param weights Current weights parallel to targets (ignored if unweighted)
+ * @param weighted Whether weights are stored
+ * @param for_each_arc Called twice with a callback fn(from, to, weight) to apply to every
+ *                     staged arc, in the same order both times
+ * @param merged_offsets Receives the merged row offsets
+ * @param merged_targets Receives the merged neighbour lists
+ * @param merged_weights Receives the merged weights (empty if unweighted)
+ */
+template<typename Index, typename Weight, typename ForEachArc>
+void merge_csr_arcs(std::span<const Index> offsets, std::span<const Index> targets, std::span<const Weight> weights,
+                    bool weighted, ForEachArc&& for_each_arc, std::vector<Index>& merged_offsets,
+                    std::vector<Index>& merged_targets, std::vector<Weight>& merged_weights) {
+    const std::size_t size = offsets.size() - 1;
+    merged_offsets.assign(size + 1, 0);
+    for (std::size_t v = 0; v < size; ++v) merged_offsets[v + 1] = offsets[v + 1] - offsets[v];
+    for_each_arc([&](Index from, Index, Weight) { merged_offsets[from + 1]++; });
+    for (std::size_t v = 0; v < size; ++v) merged_offsets[v + 1] += merged_offsets[v];
+
+    merged_targets.assign(merged_offsets[size], Index{});
+    merged_weights.assign(weighted ? merged_offsets[size] : 0, Weight{});
+    std::vector<Index> cursor(merged_offsets.begin(), merged_offsets.end() - 1);
+    for (std::size_t v = 0; v < size; ++v) {
+        for (Index i = offsets[v]; i < offsets[v + 1]; ++i) {
+            merged_targets[cursor[v]] = targets[i];
+            if (weighted) merged_weights[cursor[v]] = weights[i];
+            cursor[v]++;
+        }
+    }
+    for_each_arc([&](Index from, Index to, Weight weight) {
+        Index slot = cursor[from]++;
+        merged_targets[slot] = to;
+        if (weighted) merged_weights[slot] = weight;
+    });
+}
+
+/**
+ * @class CsrAdjacency
+ * @brief Frozen compressed-sparse-row (CSR) adjacency storage shared by the graph classes.
+ *
+ * The out-neighbours of vertex v occupy targets[offsets[v] .. offsets[v + 1]) and, for
+ * weighted graphs, the same slots of the weights array. Keeping every neighbour list in one
+ * contiguous array avoids a heap allocation per vertex and lets traversals stream through
+ * memory instead of chasing pointers.
+ *
+ * Arcs are staged by the owning graph and merged in bulk with append(), which preserves the
+ * insertion order of each vertex's neighbours. Bulk insertions skip the staging and scatter
+ * their edges straight into the merged arrays with append_edges().
+ *
+ * The arrays are normally owned, but borrow() can wrap arrays that live elsewhere (e.g. in a
+ * memory-mapped graph file) without copying them. The first append() to a borrowed adjacency
+ * copies the arrays into owned storage.
+ *
+ * When the number of arcs each vertex will receive is known in advance, reserve() opens a gap
+ * at the end of every row and try_push() writes arcs straight into it, so they never pass
+ * through a staging buffer. Rows must not be read while gaps are open; compact() (or any
+ * append()) closes them.
+ *
+ * @note Vertices are zero-indexed.
+ */
+class CsrAdjacency {
+public:
+    using index_type = int;
+    using weight_type = int;
+
+    /**
+     * @struct Arc
+     * @brief A directed arc waiting to be merged into the CSR arrays
+     */
+    struct Arc {
+        int from;   ///< Source vertex
+        int to;     ///< Destination vertex
+        int weight; ///< Weight of the arc (ignored by unweighted storage)
+
+        Arc(int from, int to, int weight) : from(from), to(to), weight(weight) {}
+    };
+
+private:
+    int _size = 0;                ///< Number of vertices
+    bool _weighted = false;       ///< Whether the weights array is maintained
+    std::vector<int> _offsets;    ///< Owned row offsets, size() + 1 entries
+    std::vector<int> _targets;    ///< Owned concatenated neighbour lists
+    std::vector<int> _weights;    ///< Owned weights parallel to _targets (empty if unweighted)
+    std::shared_ptr<const void> _storage; ///< Keeps borrowed arrays alive (null when owned)
+    std::span<const int> _offset_view;    ///< Row offsets in use, owned or borrowed
+    std::span<const int> _target_view;    ///< Neighbour lists in use, owned or borrowed
+    std::span<const int> _weight_view;    ///< Weights in use, owned or borrowed
+    std::vector<int> _fill;               ///< End of each row's filled part while gaps are open
+
+    /**
+     * @brief Point the views at the owned arrays
+     */
+    void rebind();
+
+    /**
+     * @brief Check that a number of arcs can be addressed by the int row offsets
+     * @param arcs Number of arcs
+     * @throw std::overflow_error if arcs exceeds INT_MAX
+     */
+    static void check_arc_count(std::size_t arcs);
+
+public:
+    /**
+     * @brief Construct an empty CsrAdjacency with no vertices
+     */
+    CsrAdjacency() = default;
+
+    /**
+     * @brief Construct a CsrAdjacency with the given number of vertices and no arcs
+     * @param size Number of vertices
+     * @param weighted Whether arc weights should be stored
+     */
+    CsrAdjacency(int size, bool weighted);
+
+    CsrAdjacency(const CsrAdjacency& other);
+    CsrAdjacency(CsrAdjacency&& other) noexcept;
+    CsrAdjacency& operator=(const CsrAdjacency& other);
+    CsrAdjacency& operator=(CsrAdjacency&& other) noexcept;
+
+    /**
+     * @brief Build an adjacency from flat edge arrays in parallel (see append_edges())
+     *
+     * @param size Number of vertices
+     * @param weighted Whether arc weights should be stored
+     * @param from Source of each edge
+     * @param to Destination of each edge
+     * @param weights Weight of each edge (ignored if unweighted)
+     * @param symmetric If true every edge u - v yields the arcs u -> v and v -> u, in that order
+     * @param threads Number of worker threads (non-positive selects hardware concurrency)
+     * @return CsrAdjacency Adjacency holding the arcs
+     * @throw std::overflow_error if the number of arcs does not fit in an int
+     */
+    [[nodiscard]] static CsrAdjacency build(int size, bool weighted, std::span<const int> from,
+                                            std::span<const int> to, std::span<const int> weights,
+                                            bool symmetric, int threads = 0);
+
+    /**
+     * @brief Wrap CSR arrays stored outside the adjacency without copying them
+     * @param size Number of vertices
+     * @param weighted Whether weights is meaningful
+     * @param offsets Row offsets, size + 1 entries
+     * @param targets Concatenated neighbour lists
+     * @param weights Weights parallel to targets (empty if unweighted)
+     * @param storage Owner of the arrays; every copy of the adjacency keeps it alive
+     * @return CsrAdjacency Adjacency reading directly from the given arrays
+     */
+    [[nodiscard]] static CsrAdjacency borrow(int size, bool weighted, std::span<const int> offsets,
+                                             std::span<const int> targets, std::span<const int> weights,
+                                             std::shared_ptr<const void> storage);
+
+    /**
+     * @brief Merge staged arcs into the CSR arrays
+     *
+     * Runs a counting pass over the staged arcs followed by a single fill pass, so the arrays
+     * are allocated exactly once per call. Existing neighbours keep their position; staged arcs
+     * are placed after them in the order they were given.
+     *
+     * @param arcs Arcs to merge
+     * @throw std::overflow_error if the merged number of arcs does not fit in an int
+     */
+    void append(const std::vector<Arc>& arcs);
+
+    /**
+     * @brief Merge a batch of edges into the CSR arrays in parallel, without staging them
+     *
+     * Every worker counts the arcs of its contiguous range of edges per source vertex. Prefix
+     * sums over those counts give each (worker, vertex) pair its first slot, and a second pass
+     * writes every arc straight into the merged arrays. Existing neighbours keep their
+     * position and the new arcs follow in input order, so the result equals appending the
+     * arcs one by one. Workers are capped so that their counters hold at most one entry per
+     * two new arcs; peak memory is the old and the merged arrays plus those counters.
+     *
+     * @tparam ArcAt Callable taking an edge index and returning its Arc
+     * @param edges Number of edges
+     * @param arc_at Yields edge e as an Arc; called twice per edge, from several threads
+     * @param symmetric If true every edge u - v yields the arcs u -> v and v -> u, in that order
+     * @param threads Number of worker threads (non-positive selects hardware concurrency)
+     * @throw std::overflow_error if the merged number of arcs does not fit in an int
+     */
+    template<typename ArcAt>
+    void append_edges(std::size_t edges, ArcAt&& arc_at, bool symmetric, int threads = 0);
+
+    /**
+     * @brief Open room for extra arcs at the end of every row
+     * @param extra Number of further arcs expected for each vertex, size() entries
+     * @throw std::overflow_error if the reserved number of arcs does not fit in an int
+     */
+    void reserve(std::span<const int> extra);
+
+    /**
+     * @brief Place an arc into the reserved room of its source row
+     * @param from Source vertex
+     * @param to Destination vertex
+     * @param weight Weight of the arc (ignored by unweighted storage)
+     * @return bool False if the row has no reserved room left (the arc is not stored)
+     */
+    bool try_push(int from, int to, int weight) {
+        if (_fill.empty() || _fill[from] == _offsets[from + 1]) return false;
+        int slot = _fill[from]++;
+        _targets[slot] = to;
+        if (_weighted) _weights[slot] = weight;
+        return true;
+    }
+
+    /**
+     * @brief Close the gaps left by reserve(), releasing unused room
+     */
+    void compact();
+
+    /**
+     * @brief Check whether reserve() left rows with open gaps
+     * @return bool True until compact() or append() runs
+     */
+    [[nodiscard]] bool has_gaps() const { return !_fill.empty(); }
+
+    /**
+     * @brief Build the transpose of this adjacency (every arc u -> v becomes v -> u)
+     *
+     * In-neighbours of each vertex come out sorted by source vertex.
+     *
+     * @return CsrAdjacency Reversed adjacency with the same vertex count and weights
+     */
+    [[nodiscard]] CsrAdjacency transposed() const;
+
+    /**
+     * @brief Relabel the vertices
+     *
+     * Row new_id[v] of the result holds the arcs of v with their targets relabelled and
+     * sorted, so scanning a row walks memory forward.
+     *
+     * @param new_id New id of every vertex; must be a permutation of 0 .. size() - 1
+     * @param threads Number of worker threads (non-positive selects hardware concurrency)
+     * @return CsrAdjacency Relabelled adjacency
+     */
+    [[nodiscard]] CsrAdjacency permuted(std::span<const int> new_id, int threads = 0) const;
+
+    /**
+     * @class Cursor
+     * @brief Resumable position in a row, used by the explicit-stack DFS engine
+     */
+    class Cursor {
+    private:
+        const int* _next;
+        const int* _end;
+
+    public:
+        explicit Cursor(std::span<const int> row) : _next(row.data()), _end(row.data() + row.size()) {}
+
+        /**
+         * @brief Advance to the next neighbour
+         * @param u Receives the neighbour
+         * @return bool False once the row is exhausted
+         */
+        bool next(int& u) {
+            if (_next == _end) return false;
+            u = *_next++;
+            return true;
+        }
+    };
+
+    /**
+     * @brief Get a cursor positioned before the first out-neighbour of v
+     * @param v Vertex
+     * @return Cursor Cursor over the row of v
+     */
+    [[nodiscard]] Cursor cursor(int v) const { return Cursor(neighbours(v)); }
+
+    /**
+     * @brief Call fn(u) for every out-neighbour u of v, in stored order
+     *
+     * Shared interface with CompressedAdjacency, used by the traversal templates.
+     *
+     * @param v Vertex
+     * @param fn Callback receiving each neighbour
+     */
+    template<typename Fn>
+    void for_each_neighbour(int v, Fn&& fn) const {
+        for (int u : neighbours(v)) fn(u);
+    }
+
+    /**
+     * @brief Get the out-neighbours of a vertex
+     * @param v Vertex
+     * @return std::span<const int> Contiguous view of the neighbour ids
+     */
+    [[nodiscard]] std::span<const int> neighbours(int v) const {
+        return {_target_view.data() + _offset_view[v], static_cast<std::size_t>(_offset_view[v + 1] - _offset_view[v])};
+    }
+
+    /**
+     * @brief Get the weights of the out-arcs of a vertex, parallel to neighbours(v)
+     * @param v Vertex
+     * @return std::span<const int> Contiguous view of the arc weights
+     */
+    [[nodiscard]] std::span<const int> weights(int v) const {
+        return {_weight_view.data() + _offset_view[v], static_cast<std::size_t>(_offset_view[v + 1] - _offset_view[v])};
+    }
+
+    /**
+     * @brief Get the out-degree of a vertex
+     * @param v Vertex
+     * @return int Number of arcs leaving v
+     */
+    [[nodiscard]] int degree(int v) const { return _offset_view[v + 1] - _offset_view[v]; }
+
+    /**
+     * @brief Get the number of vertices
+     * @return int Number of vertices
+     */
+    [[nodiscard]] int size() const { return _size; }
+
+    /**
+     * @brief Get the total number of stored arcs
+     * @return std::size_t Number of arcs
+     */
+    [[nodiscard]] std::size_t arc_count() const { return _target_view.size(); }
+
+    /**
+     * @brief Check whether arc weights are stored
+     * @return bool True for weighted storage
+     */
+    [[nodiscard]] bool weighted() const { return _weighted; }
+
+    /**
+     * @brief Check whether the arrays are borrowed rather than owned
+     * @return bool True if the adjacency was created by borrow() and not modified since
+     */
+    [[nodiscard]] bool borrowed() const { return _storage != nullptr; }
+
+    /**
+     * @brief Get the raw row offsets array
+     * @return std::span<const int> Offsets, size() + 1 entries
+     */
+    [[nodiscard]] std::span<const int> offsets() const { return _offset_view; }
+
+    /**
+     * @brief Get the raw concatenated targets array
+     * @return std::span<const int> Neighbour ids of all vertices
+     */
+    [[nodiscard]] std::span<const int> targets() const { return _target_view; }
+
+    /**
+     * @brief Get the raw concatenated weights array
+     * @return std::span<const int> Arc weights (empty if unweighted)
+     */
+    [[nodiscard]] std::span<const int> all_weights() const { return _weight_view; }
+};
+
+template<typename ArcAt>
+void CsrAdjacency::append_edges(std::size_t edges, ArcAt&& arc_at, bool symmetric, int threads) {
+    compact();
+    if (edges == 0) return;
+    const std::size_t added = symmetric ? 2 * edges : edges;
+    check_arc_count(arc_count() + added);
+    const int n = _size;
+    const int count = static_cast<int>(edges);
+    const int grain = 1 << 14;
+    threads = std::clamp(static_cast<int>(added / (2 * std::max<std::size_t>(n, 1))), 1, resolve_thread_count(threads));
+
+    auto for_each_arc = [&](int e, auto&& fn) {
+        Arc arc = arc_at(static_cast<std::size_t>(e));
+        fn(arc.from, arc.to, arc.weight);
+        if (symmetric) fn(arc.to, arc.from, arc.weight);
+    };
+
+    // Pass 1: every worker counts the arcs of its edges per source vertex.
+    std::vector<std::vector<int>> cursor(threads);
+    int workers = parallel_for(0, count, threads, [&](int worker, int lo, int hi) {
+        std::vector<int>& row_count = cursor[worker];
+        row_count.assign(n, 0);
+        for (int e = lo; e < hi; ++e) {
+            for_each_arc(e, [&](int source, int, int) { row_count[source]++; });
+        }
+    }, grain);
+
+    std::vector<int> offsets(n + 1, 0);
+    parallel_for(0, n, threads, [&](int, int lo, int hi) {
+        for (int v = lo; v < hi; ++v) {
+            int row = degree(v);
+            for (int w = 0; w < workers; ++w) row += cursor[w][v];
+            offsets[v + 1] = row;
+        }
+    });
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    // Copy the existing rows and turn the counts into the first slot of every (worker, vertex)
+    // pair: worker w's arcs of v follow those of workers 0 .. w - 1.
+    std::vector<int> targets(offsets[n]);
+    std::vector<int> weights(_weighted ? offsets[n] : 0);
+    parallel_for(0, n, threads, [&](int, int lo, int hi) {
+        for (int v = lo; v < hi; ++v) {
+            std::ranges::copy(neighbours(v), targets.begin() + offsets[v]);
+            if (_weighted) std::ranges::copy(this->weights(v), weights.begin() + offsets[v]);
+            int slot = offsets[v] + degree(v);
+            for (int w = 0; w < workers; ++w) {
+                int row_count = cursor[w][v];
+                cursor[w][v] = slot;
+                slot += row_count;
+            }
+        }
+    });
+
+    // Pass 2: every worker scatters its arcs into its own slots, so no atomics are needed.
+    parallel_for(0, count, threads, [&](int worker, int lo, int hi) {
+        std::vector<int>& slot = cursor[worker];
+        for (int e = lo; e < hi; ++e) {
+            for_each_arc(e, [&](int source, int target, int weight) {
+                int i = slot[source]++;
+                targets[i] = target;
+                if (_weighted) weights[i] = weight;
+            });
+        }
+    }, grain);
+
+    _offsets = std::move(offsets);
+    _targets = std::move(targets);
+    _weights = std::move(weights);
+    _storage.reset();
+    rebind();
+}
+
+/**
+ * @class TypedCsrAdjacency
+ * @brief Owned CSR adjacency with configurable index and weight types.
+ *
+ * The storage behind TypedWeightedGraph: the same row layout and staged merge as
+ * CsrAdjacency (see merge_csr_arcs()), with Index used for vertex ids and offsets and Weight
+ * for the weights array. It offers the neighbours() / weights() interface of CsrAdjacency, so
+ * the searches in weighted_search.h run on both.
+ *
+ * @tparam Index Unsigned vertex-index type; must also hold the number of arcs
+ * @tparam Weight Arithmetic weight type
+ */
+template<typename Index, typename Weight>
+class TypedCsrAdjacency {
+private:
+    std::vector<Index> _offsets;  ///< Row offsets, size() + 1 entries
+    std::vector<Index> _targets;  ///< Concatenated neighbour lists
+    std::vector<Weight> _weights; ///< Weights parallel to _targets
+
+public:
+    using index_type = Index;
+    using weight_type = Weight;
+
+    /**
+     * @brief Construct a TypedCsrAdjacency with the given number of vertices and no arcs
+     * @param size Number of vertices
+     */
+    explicit TypedCsrAdjacency(Index size) : _offsets(static_cast<std::size_t>(size) + 1, 0) {}
+
+    /**
+     * @brief Merge staged arcs into the CSR arrays (see merge_csr_arcs())
+     * @param count Number of arcs for_each_arc() yields
+     * @param for_each_arc Called twice with a callback fn(from, to, weight) for every arc
+     * @throw std::overflow_error if the number of arcs does not fit in Index
+     */
+    template<typename ForEachArc>
+    void append(std::size_t count, ForEachArc&& for_each_arc) {
+        if (count == 0) return;
+        if (count > std::numeric_limits<Index>::max() - _targets.size()) {
+            throw std::overflow_error("Number of arcs does not fit in the index type");
+        }
+        std::vector<Index> offsets, targets;
+        std::vector<Weight> weights;
+        merge_csr_arcs<Index, Weight>(_offsets, _targets, _weights, true, for_each_arc, offsets, targets, weights);
+        _offsets = std::move(offsets);
+        _targets = std::move(targets);
+        _weights = std::move(weights);
+    }
+
+    [[nodiscard]] std::span<const Index> neighbours(Index v) const {
+        return {_targets.data() + _offsets[v], static_cast<std::size_t>(_offsets[v + 1] - _offsets[v])};
+    }
+
+    [[nodiscard]] std::span<const Weight> weights(Index v) const {
+        return {_weights.data() + _offsets[v], static_cast<std::size_t>(_offsets[v + 1] - _offsets[v])};
+    }
+
+    [[nodiscard]] Index size() const { return static_cast<Index>(_offsets.size() - 1); }
+
+    [[nodiscard]] std::size_t arc_count() const { return _targets.size(); }
+
+    /**
+     * @brief Get the memory used by the offset, target and weight arrays
+     * @return std::size_t Size in bytes
+     */
+    [[nodiscard]] std::size_t byte_size() const {
+        return _offsets.size() * sizeof(Index) + _targets.size() * sizeof(Index) + _weights.size() * sizeof(Weight);
+    }
+};
+
+/**
+ * @class NeighbourView
+ * @brief Read-only, span-based view of an unweighted CSR adjacency.
+ *
+ * Indexing with a vertex yields a std::span of its neighbours, which mirrors the
+ * get_adj_list()[v] access pattern of a nested-vector adjacency list.
+ */
+class NeighbourView {
+private:
+    const CsrAdjacency* _csr;
+
+public:
+    explicit NeighbourView(const CsrAdjacency& csr) : _csr(&csr) {}
+
+    [[nodiscard]] std::span<const int> operator[](int v) const { return _csr->neighbours(v); }
+
+    [[nodiscard]] std::size_t size() const { return static_cast<std::size_t>(_csr->size()); }
+};
+
+/**
+ * @class WeightedNeighbourView
+ * @brief Read-only view of a weighted CSR adjacency.
+ *
+ * Indexing with a vertex yields a range of (vertex, weight) pairs built on the fly from the
+ * parallel targets and weights spans, so `for (auto [v, w] : view[u])` keeps working.
+ */
+class WeightedNeighbourView {
+public:
+    /**
+     * @class Range
+     * @brief Iterable zip of one vertex's targets and weights
+     */
+    class Range {
+    public:
+        class iterator {
+        private:
+            const int* _target;
+            const int* _weight;
+
+        public:
+            using value_type = std::pair<int, int>;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() : _target(nullptr), _weight(nullptr) {}
+            iterator(const int* target, const int* weight) : _target(target), _weight(weight) {}
+
+            value_type operator*() const { return {*_target, *_weight}; }
+            iterator& operator++() { ++_target; ++_weight; return *this; }
+            iterator operator++(int) { iterator copy = *this; ++*this; return copy; }
+            bool operator==(const iterator& other) const { return _target == other._target; }
+        };
+
+    private:
+        std::span<const int> _targets;
+        std::span<const int> _weights;
+
+    public:
+        Range(std::span<const int> targets, std::span<const int> weights) : _targets(targets), _weights(weights) {}
+
+        [[nodiscard]] iterator begin() const { return {_targets.data(), _weights.data()}; }
+        [[nodiscard]] iterator end() const { return {_targets.data() + _targets.size(), _weights.data() + _weights.size()}; }
+        [[nodiscard]] std::size_t size() const { return _targets.size(); }
+        [[nodiscard]] bool empty() const { return _targets.empty(); }
+        [[nodiscard]] std::pair<int, int> operator[](std::size_t i) const { return {_targets[i], _weights[i]}; }
+    };
+
+private:
+    const CsrAdjacency* _csr;
+
+public:
+    explicit WeightedNeighbourView(const CsrAdjacency& csr) : _csr(&csr) {}
+
+    [[nodiscard]] Range operator[](int v) const { return {_csr->neighbours(v), _csr->weights(v)}; }
+
+    [[nodiscard]] std::size_t size() const { return static_cast<std::size_t>(_csr->size()); }
+};
+
+#endif // CSR_H
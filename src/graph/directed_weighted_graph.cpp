@@ -0,0 +1,257 @@
+#include "directed_weighted_graph.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+#include "src/graph/parallel.h"
+#include "src/graph/weighted_search.h"
+
+namespace {
+
+/**
+ * @brief Find a cycle in the predecessor graph
+ *
+ * Every vertex has at most one parent, so each walk up the parents either ends at a root,
+ * joins an earlier walk, or closes a cycle. O(V) time.
+ *
+ * @param parent Predecessor of each vertex (-1 for none)
+ * @return std::vector<int> Vertices of a cycle in arc order, or empty if there is none
+ */
+std::vector<int> find_parent_cycle(const std::vector<int>& parent) {
+    const int n = static_cast<int>(parent.size());
+    std::vector<int> walk(n, -1);
+    for (int start = 0; start < n; ++start) {
+        int v = start;
+        while (v != -1 && walk[v] == -1) {
+            walk[v] = start;
+            v = parent[v];
+        }
+        if (v == -1 || walk[v] != start) continue;
+
+        std::vector<int> cycle;
+        int u = v;
+        do {
+            cycle.push_back(u);
+            u = parent[u];
+        } while (u != v);
+        std::ranges::reverse(cycle);
+        return cycle;
+    }
+    return {};
+}
+
+} // namespace
+
+DirectedWeightedGraph::DirectedWeightedGraph(int size) : _size(size), _csr(size, true) {}
+
+void DirectedWeightedGraph::add_edge(int from, int to, int weight) {
+    if (from < 0 || from >= _size || to < 0 || to >= _size) {
+        throw std::out_of_range("Vertex index out of range");
+    }
+    if (!_csr.try_push(from, to, weight)) _pending.emplace_back(from, to, weight);
+}
+
+void DirectedWeightedGraph::add_edges(std::span<const Edge> edges, int threads) {
+    threads = resolve_thread_count(threads);
+    int count = static_cast<int>(edges.size());
+    std::vector<char> bad_vertex(threads, 0);
+
+    parallel_for(0, count, threads, [&](int worker, int lo, int hi) {
+        for (int i = lo; i < hi; ++i) {
+            const Edge& edge = edges[i];
+            if (edge.u < 0 || edge.u >= _size || edge.v < 0 || edge.v >= _size) bad_vertex[worker] = 1;
+        }
+    }, 1 << 14);
+
+    if (std::ranges::find(bad_vertex, 1) != bad_vertex.end()) {
+        throw std::out_of_range("Vertex index out of range");
+    }
+    if (count == 0) return;
+
+    adjacency();
+    _csr.append_edges(edges.size(), [edges](std::size_t e) {
+        return CsrAdjacency::Arc(edges[e].u, edges[e].v, edges[e].w);
+    }, false, threads);
+}
+
+void DirectedWeightedGraph::finalize() {
+    adjacency();
+    _pending.shrink_to_fit();
+}
+
+const CsrAdjacency& DirectedWeightedGraph::adjacency() const {
+    if (!_pending.empty() || _csr.has_gaps()) {
+        _csr.append(_pending);
+        _pending.clear();
+    }
+    return _csr;
+}
+
+DirectedWeightedGraph::ShortestPathTree DirectedWeightedGraph::bellman_ford(int start, int threads) const {
+    if (start < 0 || start >= _size) {
+        throw std::out_of_range("Start vertex index out of range");
+    }
+    return relax_rounds(std::span<const int>(&start, 1), resolve_thread_count(threads));
+}
+
+DirectedWeightedGraph::ShortestPathTree DirectedWeightedGraph::relax_rounds(std::span<const int> sources,
+                                                                            int threads) const {
+    const CsrAdjacency& adj = adjacency();
+
+    ShortestPathTree tree;
+    tree.distance.assign(_size, unreachable);
+    tree.parent.assign(_size, -1);
+    std::vector<long long>& dist = tree.distance;
+
+    std::vector<int> frontier;
+    for (int s : sources) {
+        if (dist[s] != 0) frontier.push_back(s);
+        dist[s] = 0;
+    }
+
+    struct Relaxation {
+        int vertex;         ///< Vertex whose distance was lowered
+        int parent;         ///< Tail of the relaxed arc
+        long long distance; ///< Distance it was lowered to
+    };
+    std::vector<std::vector<Relaxation>> log(threads);
+    std::vector<std::vector<int>> improved(threads);
+
+    for (int round = 1; !frontier.empty(); ++round) {
+        int used = parallel_for(0, static_cast<int>(frontier.size()), threads, [&](int worker, int lo, int hi) {
+            std::vector<Relaxation>& relaxed = log[worker];
+            relaxed.clear();
+            for (int i = lo; i < hi; ++i) {
+                int u = frontier[i];
+                // Tails only get shorter, so a stale read merely offers a longer candidate.
+                long long du = threads == 1 ? dist[u] : std::atomic_ref<long long>(dist[u]).load(std::memory_order_relaxed);
+                std::span<const int> targets = adj.neighbours(u), weights = adj.weights(u);
+                for (std::size_t a = 0; a < targets.size(); ++a) {
+                    int v = targets[a];
+                    long long candidate = du + weights[a];
+                    if (threads == 1) {
+                        if (candidate >= dist[v]) continue;
+                        dist[v] = candidate;
+                    } else {
+                        std::atomic_ref<long long> target(dist[v]);
+                        long long current = target.load(std::memory_order_relaxed);
+                        do {
+                            if (candidate >= current) break;
+                        } while (!target.compare_exchange_weak(current, candidate, std::memory_order_relaxed));
+                        if (candidate >= current) continue;
+                    }
+                    relaxed.push_back({v, u, candidate});
+                }
+            }
+        }, 256);
+
+        // Distances only decrease, so exactly one logged entry matches each improved vertex.
+        frontier.clear();
+        int resolved = parallel_for(0, used, threads, [&](int worker, int lo, int hi) {
+            improved[worker].clear();
+            for (int t = lo; t < hi; ++t) {
+                for (const Relaxation& r : log[t]) {
+                    if (dist[r.vertex] != r.distance) continue;
+                    tree.parent[r.vertex] = r.parent;
+                    improved[worker].push_back(r.vertex);
+                }
+            }
+        }, 1);
+        for (int t = 0; t < resolved; ++t) frontier.insert(frontier.end(), improved[t].begin(), improved[t].end());
+
+        // Without negative cycles every round after V - 1 is empty; before that, probing at
+        // powers of two keeps the checks to O(V log V) in total.
+        if (!frontier.empty() && (round >= _size || std::has_single_bit(static_cast<unsigned>(round)))) {
+            tree.negative_cycle = find_parent_cycle(tree.parent);
+            if (tree.has_negative_cycle()) return tree;
+        }
+    }
+    return tree;
+}
+
+DirectedWeightedGraph::ShortestPathTree DirectedWeightedGraph::spfa(int start) const {
+    if (start < 0 || start >= _size) {
+        throw std::out_of_range("Start vertex index out of range");
+    }
+    const CsrAdjacency& adj = adjacency();
+
+    ShortestPathTree tree;
+    tree.distance.assign(_size, unreachable);
+    tree.parent.assign(_size, -1);
+    std::vector<long long>& dist = tree.distance;
+
+    // Each vertex is queued at most once at a time, so a ring of V slots never overflows.
+    std::vector<int> queue(_size);
+    std::vector<char> queued(_size, 0);
+    std::size_t head = 0, tail = 0, relaxations = 0;
+    auto push = [&](int v) {
+        queued[v] = 1;
+        queue[tail++ % _size] = v;
+    };
+
+    dist[start] = 0;
+    push(start);
+    while (head != tail) {
+        int u = queue[head++ % _size];
+        queued[u] = 0;
+        std::span<const int> targets = adj.neighbours(u), weights = adj.weights(u);
+        for (std::size_t i = 0; i < targets.size(); ++i) {
+            int v = targets[i];
+            if (dist[u] + weights[i] >= dist[v]) continue;
+            dist[v] = dist[u] + weights[i];
+            tree.parent[v] = u;
+            if (!queued[v]) push(v);
+
+            if (++relaxations % _size == 0) {
+                tree.negative_cycle = find_parent_cycle(tree.parent);
+                if (tree.has_negative_cycle()) return tree;
+            }
+        }
+    }
+    return tree;
+}
+
+std::vector<long long> DirectedWeightedGraph::all_pairs_distances(int threads) const {
+    threads = resolve_thread_count(threads);
+    const CsrAdjacency& adj = adjacency();
+    const std::size_t arcs = adj.arc_count();
+
+    // Potentials from a virtual source joined to every vertex by a zero-weight arc.
+    std::vector<int> everyone(_size);
+    for (int v = 0; v < _size; ++v) everyone[v] = v;
+    ShortestPathTree potentials = relax_rounds(everyone, threads);
+    if (potentials.has_negative_cycle()) {
+        throw std::invalid_argument("Graph contains a negative cycle");
+    }
+    const std::vector<long long>& h = potentials.distance;
+
+    // Reweighted arcs are non-negative but need not fit in an int, and neither do the path
+    // lengths built from them, so the Dijkstras run on 64-bit weights and distances.
+    using Vertex = std::uint32_t;
+    TypedCsrAdjacency<Vertex, std::uint64_t> reweighted(static_cast<Vertex>(_size));
+    reweighted.append(arcs, [&](auto&& fn) {
+        for (int u = 0; u < _size; ++u) {
+            std::span<const int> targets = adj.neighbours(u), arc_weights = adj.weights(u);
+            for (std::size_t i = 0; i < targets.size(); ++i) {
+                fn(static_cast<Vertex>(u), static_cast<Vertex>(targets[i]),
+                   static_cast<std::uint64_t>(arc_weights[i] + h[u] - h[targets[i]]));
+            }
+        }
+    });
+
+    constexpr std::uint64_t unreached = std::numeric_limits<std::uint64_t>::max();
+    std::vector<long long> distances(static_cast<std::size_t>(_size) * _size);
+    parallel_for(0, _size, threads, [&](int, int lo, int hi) {
+        for (int u = lo; u < hi; ++u) {
+            std::vector<std::uint64_t> row =
+                dijkstra_distances<std::uint64_t, IndexedDaryHeapQueue<4, std::uint64_t, Vertex>>(
+                    reweighted, static_cast<Vertex>(u), 0);
+            for (int v = 0; v < _size; ++v) {
+                std::size_t i = static_cast<std::size_t>(u) * _size + v;
+                distances[i] = row[v] == unreached ? unreachable : static_cast<long long>(row[v]) - h[u] + h[v];
+            }
+        }
+    }, 1);
+    return distances;
+}
@@ -0,0 +1,175 @@
+#ifndef DIRECTED_WEIGHTED_GRAPH_H
+#define DIRECTED_WEIGHTED_GRAPH_H
+
+#include <vector>
+#include <span>
+#include <limits>
+#include <cstddef>
+#include "src/graph/csr.h"
+#include "src/graph/weighted_graph.h"
+
+/**
+ * @class DirectedWeightedGraph
+ * @brief Directed weighted graph that accepts negative edge weights.
+ *
+ * Shares the CSR storage scheme of the other graphs (edges are staged and merged on first
+ * read) and offers the shortest-path algorithms that remain correct with negative weights:
+ * Bellman-Ford, SPFA and Johnson's all-pairs reweighting. Distances are 64-bit, since sums
+ * of negative weights can leave the int range in both directions.
+ *
+ * When a negative cycle is reachable from the start, the algorithms stop as soon as one is
+ * found and report it; the distances are then meaningless.
+ *
+ * @note Vertices are zero-indexed. Edges are directed from Edge::u to Edge::v.
+ */
+class DirectedWeightedGraph {
+public:
+    using Edge = WeightedGraph::Edge;
+
+    /// Distance reported for vertices that cannot be reached
+    static constexpr long long unreachable = std::numeric_limits<long long>::max();
+
+    /**
+     * @struct ShortestPathTree
+     * @brief Result of a single-source search
+     */
+    struct ShortestPathTree {
+        std::vector<long long> distance; ///< Distance from the start (unreachable if none)
+        std::vector<int> parent;         ///< Predecessor on a shortest path (-1 for the start and unreached vertices)
+        std::vector<int> negative_cycle; ///< Vertices of a negative cycle in arc order, empty if none was found
+
+        /**
+         * @brief Check whether the search ran into a negative cycle
+         * @return bool True if negative_cycle is non-empty
+         */
+        [[nodiscard]] bool has_negative_cycle() const { return !negative_cycle.empty(); }
+    };
+
+private:
+    int _size; ///< Number of vertices in the graph
+    mutable CsrAdjacency _csr; ///< Frozen CSR adjacency of out-arcs
+    mutable std::vector<CsrAdjacency::Arc> _pending; ///< Edges added since the last merge
+
+public:
+    /**
+     * @brief Construct a graph without edges
+     * @param size Number of vertices in the graph
+     */
+    explicit DirectedWeightedGraph(int size);
+
+    /**
+     * @brief Add a directed edge; the weight may be negative
+     * @param from Source vertex
+     * @param to Destination vertex
+     * @param weight Weight of the edge
+     * @throw std::out_of_range if either vertex is out of range
+     */
+    void add_edge(int from, int to, int weight);
+
+    /**
+     * @brief Add a batch of directed edges, filling the CSR adjacency in one pass
+     * @param edges Edges to add (u -> v with weight w)
+     * @param threads Number of worker threads (non-positive selects hardware concurrency)
+     * @throw std::out_of_range if any vertex is out of range (the graph is left unchanged)
+     */
+    void add_edges(std::span<const Edge> edges, int threads = 0);
+
+    /**
+     * @brief Merge all staged edges into the CSR adjacency and release the staging buffer
+     */
+    void finalize();
+
+    /**
+     * @brief Single-source shortest paths with parallel, round-based Bellman-Ford
+     *
+     * Every round, the workers relax the out-arcs of the vertices improved in the previous
+     * round, lowering distances in place with an atomic minimum, so improvements already
+     * propagate within a round. Each worker logs its successful relaxations; after the round,
+     * the entry that produced a vertex's final distance sets its predecessor and queues it
+     * for the next round. The search ends as soon as a round improves nothing, having examined
+     * only the arcs of improved vertices. Distances do not depend on the thread count; among
+     * equally short paths the predecessors may.
+     *
+     * A cycle in the predecessor graph always has negative weight, so the predecessor graph
+     * is checked at power-of-two rounds and from round V on; a reachable negative cycle is
+     * reported as soon as it shows up there.
+     *
+     * @param start Starting vertex
+     * @param threads Number of worker threads (non-positive selects hardware concurrency)
+     * @return ShortestPathTree Distances, predecessors and any negative cycle found
+     * @throw std::out_of_range if start vertex is out of range
+     */
+    [[nodiscard]] ShortestPathTree bellman_ford(int start, int threads = 0) const;
+
+    /**
+     * @brief Single-source shortest paths with the queue-based Bellman-Ford (SPFA)
+     *
+     * Only vertices whose distance dropped are queued for relaxation, which on most inputs
+     * touches each arc a few times instead of once per round. Every V relaxations the
+     * predecessor graph is checked for a cycle, which bounds the time to detect a negative
+     * cycle.
+     *
+     * @param start Starting vertex
+     * @return ShortestPathTree Distances, predecessors and any negative cycle found
+     * @throw std::out_of_range if start vertex is out of range
+     */
+    [[nodiscard]] ShortestPathTree spfa(int start) const;
+
+    /**
+     * @brief All-pairs shortest distances with Johnson's reweighting
+     *
+     * Potentials h from a Bellman-Ford run out of a virtual source (every vertex starting at
+     * 0) make every reweighted edge w + h(u) - h(v) non-negative. One Dijkstra per source runs
+     * in parallel on the reweighted arcs with 64-bit weights and distances (see
+     * dijkstra_distances()), and the potentials are subtracted again.
+     *
+     * @param threads Number of worker threads (non-positive selects hardware concurrency)
+     * @return std::vector<long long> Row-major V x V matrix; entry u * V + v is the distance
+     *         from u to v (unreachable if no path exists)
+     * @throw std::invalid_argument if the graph contains a negative cycle
+     */
+    [[nodiscard]] std::vector<long long> all_pairs_distances(int threads = 0) const;
+
+    /**
+     * @brief Get the number of vertices in the graph
+     * @return int Number of vertices
+     */
+    [[nodiscard]] int size() const { return _size; }
+
+    /**
+     * @brief Get the number of directed edges
+     * @return std::size_t Number of edges
+     */
+    [[nodiscard]] std::size_t edge_count() const { return adjacency().arc_count(); }
+
+    /**
+     * @brief Get the out-neighbours of a vertex
+     * @param v Vertex
+     * @return std::span<const int> Contiguous view of the out-neighbours of v
+     */
+    [[nodiscard]] std::span<const int> neighbours(int v) const { return adjacency().neighbours(v); }
+
+    /**
+     * @brief Get the weights of the out-arcs of a vertex, parallel to neighbours(v)
+     * @param v Vertex
+     * @return std::span<const int> Contiguous view of the arc weights
+     */
+    [[nodiscard]] std::span<const int> neighbour_weights(int v) const { return adjacency().weights(v); }
+
+private:
+    /**
+     * @brief Get the CSR adjacency, merging staged edges first if necessary
+     * @return const CsrAdjacency& Up-to-date adjacency
+     */
+    const CsrAdjacency& adjacency() const;
+
+    /**
+     * @brief Round-based parallel Bellman-Ford from several sources at distance 0
+     * @param sources Start vertices
+     * @param threads Number of worker threads (already resolved)
+     * @return ShortestPathTree Distances, predecessors and any negative cycle found
+     */
+    ShortestPathTree relax_rounds(std::span<const int> sources, int threads) const;
+};
+
+#endif // DIRECTED_WEIGHTED_GRAPH_H
@@ -0,0 +1,117 @@
+#include "dynamic_topological_order.h"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include "src/graph/unweighted_graph.h"
+
+DynamicTopologicalOrder::DynamicTopologicalOrder(int size)
+    : DynamicTopologicalOrder(CsrAdjacency(size, false), CsrAdjacency(size, false), [size] {
+          std::vector<int> order(size);
+          std::iota(order.begin(), order.end(), 0);
+          return order;
+      }()) {}
+
+DynamicTopologicalOrder::DynamicTopologicalOrder(CsrAdjacency adjacency, CsrAdjacency reverse, std::vector<int> order)
+    : _size(adjacency.size()), _base(std::move(adjacency)), _base_reverse(std::move(reverse)),
+      _out(_size), _in(_size), _order(std::move(order)), _position(_size), _mark(_size, 0) {
+    for (int i = 0; i < _size; ++i) _position[_order[i]] = i;
+}
+
+bool DynamicTopologicalOrder::add_edge(int from, int to) {
+    if (from < 0 || from >= _size || to < 0 || to >= _size) {
+        throw std::out_of_range("Vertex index out of range");
+    }
+    _slots.clear();
+    if (from == to) {
+        _cycle.assign(1, from);
+        return false;
+    }
+
+    int lower = _position[to], upper = _position[from];
+    if (lower < upper) {
+        begin_search();
+        // A path to -> ... -> from closes a cycle; it can only use positions in [lower, upper].
+        if (!search(to, true, upper, from, _forward)) {
+            _cycle.clear();
+            for (const auto& frame : _stack) _cycle.push_back(frame.first);
+            _cycle.push_back(from);
+            return false;
+        }
+        search(from, false, lower, -1, _backward);
+
+        auto by_position = [&](int a, int b) { return _position[a] < _position[b]; };
+        std::sort(_forward.begin(), _forward.end(), by_position);
+        std::sort(_backward.begin(), _backward.end(), by_position);
+        for (int v : _backward) _slots.push_back(_position[v]);
+        for (int v : _forward) _slots.push_back(_position[v]);
+        std::inplace_merge(_slots.begin(), _slots.begin() + static_cast<std::ptrdiff_t>(_backward.size()), _slots.end());
+
+        // Everything reaching from now precedes everything reachable from to.
+        std::size_t i = 0;
+        for (const std::vector<int>* group : {&_backward, &_forward}) {
+            for (int v : *group) {
+                _position[v] = _slots[i];
+                _order[_slots[i++]] = v;
+            }
+        }
+    }
+
+    _out[from].push_back(to);
+    _in[to].push_back(from);
+    ++_inserted;
+    return true;
+}
+
+UnweightedGraph DynamicTopologicalOrder::graph() const {
+    std::vector<std::pair<int, int>> arcs;
+    arcs.reserve(arc_count());
+    for (int v = 0; v < _size; ++v) {
+        for (int u : _base.neighbours(v)) arcs.emplace_back(v, u);
+    }
+    for (int v = 0; v < _size; ++v) {
+        for (int u : _out[v]) arcs.emplace_back(v, u);
+    }
+    UnweightedGraph result(_size);
+    result.add_edges(arcs);
+    return result;
+}
+
+void DynamicTopologicalOrder::begin_search() {
+    if (++_generation == 0) {
+        // The counter wrapped around: clear stale marks once every 2^32 insertions.
+        std::fill(_mark.begin(), _mark.end(), 0);
+        _generation = 1;
+    }
+}
+
+bool DynamicTopologicalOrder::search(int start, bool forward, int bound, int stop, std::vector<int>& found) {
+    const CsrAdjacency& base = forward ? _base : _base_reverse;
+    const std::vector<std::vector<int>>& added = forward ? _out : _in;
+    found.assign(1, start);
+    _mark[start] = _generation;
+    _stack.assign(1, {start, 0});
+
+    while (!_stack.empty()) {
+        int u = _stack.back().first;
+        int arc = _stack.back().second++;
+        std::span<const int> row = base.neighbours(u);
+        int w;
+        if (arc < static_cast<int>(row.size())) {
+            w = row[arc];
+        } else if (std::size_t extra = arc - row.size(); extra < added[u].size()) {
+            w = added[u][extra];
+        } else {
+            _stack.pop_back();
+            continue;
+        }
+
+        if (w == stop) return false;
+        bool inside = forward ? _position[w] < bound : _position[w] > bound;
+        if (inside && _mark[w] != _generation) {
+            _mark[w] = _generation;
+            found.push_back(w);
+            _stack.emplace_back(w, 0);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,140 @@
+#ifndef DYNAMIC_TOPOLOGICAL_ORDER_H
+#define DYNAMIC_TOPOLOGICAL_ORDER_H
+
+#include <vector>
+#include <span>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+#include "src/graph/csr.h"
+
+class UnweightedGraph;
+
+/**
+ * @class DynamicTopologicalOrder
+ * @brief Topological order of a DAG maintained under edge insertions (Pearce–Kelly).
+ *
+ * Inserting u -> v when u already precedes v costs O(1). Otherwise only the affected region
+ * between the positions of v and u is examined: a forward search from v over vertices placed
+ * before u, and a backward search from u over vertices placed after v. If the forward search
+ * reaches u the edge would close a cycle and is rejected; otherwise the vertices found are
+ * moved, in their existing relative order, onto the positions they already occupy, the
+ * backward set first. The cost is proportional to the arcs of the affected region rather
+ * than O(V + E) for sorting from scratch.
+ *
+ * Arcs present at construction stay in CSR form; inserted arcs are kept in per-vertex lists.
+ * Obtain one for an existing graph with UnweightedGraph::dynamic_topological_order().
+ *
+ * @note Vertices are zero-indexed. Parallel arcs are allowed.
+ */
+class DynamicTopologicalOrder {
+private:
+    int _size;                               ///< Number of vertices
+    CsrAdjacency _base;                      ///< Arcs present at construction
+    CsrAdjacency _base_reverse;              ///< Transposed _base
+    std::vector<std::vector<int>> _out;      ///< Inserted arcs by source
+    std::vector<std::vector<int>> _in;       ///< Inserted arcs by target
+    std::size_t _inserted = 0;               ///< Number of inserted arcs
+    std::vector<int> _order;                 ///< Vertex at each position
+    std::vector<int> _position;              ///< Position of each vertex
+
+    std::vector<std::uint32_t> _mark;        ///< Generation that last visited each vertex
+    std::uint32_t _generation = 0;           ///< Generation of the current insertion
+    std::vector<std::pair<int, int>> _stack; ///< (vertex, next arc) frames of the searches
+    std::vector<int> _forward;               ///< Affected vertices reachable from the new target
+    std::vector<int> _backward;              ///< Affected vertices reaching the new source
+    std::vector<int> _slots;                 ///< Positions freed by the affected vertices
+    std::vector<int> _cycle;                 ///< Cycle found by the last rejected insertion
+
+public:
+    /**
+     * @brief Construct an order over vertices without arcs
+     * @param size Number of vertices
+     */
+    explicit DynamicTopologicalOrder(int size);
+
+    /**
+     * @brief Construct an order for an existing DAG
+     * @param adjacency Arcs of the DAG
+     * @param reverse Transposed adjacency
+     * @param order A topological order of the DAG (checked by the caller)
+     */
+    DynamicTopologicalOrder(CsrAdjacency adjacency, CsrAdjacency reverse, std::vector<int> order);
+
+    /**
+     * @brief Insert the arc from -> to, updating the order, unless it would close a cycle
+     * @param from Source vertex
+     * @param to Target vertex
+     * @return bool True if the arc was inserted; false if it would create a cycle, in which case
+     *         nothing changes and cycle() returns the offending cycle
+     * @throw std::out_of_range if either vertex is out of range
+     */
+    [[nodiscard]] bool add_edge(int from, int to);
+
+    /**
+     * @brief Get the current topological order
+     * @return std::span<const int> Vertices in topological order
+     */
+    [[nodiscard]] std::span<const int> order() const { return _order; }
+
+    /**
+     * @brief Get the position of a vertex in the current order
+     * @param v Vertex
+     * @return int Position of v
+     */
+    [[nodiscard]] int position(int v) const { return _position[v]; }
+
+    /**
+     * @brief Get the cycle that made the last rejected insertion fail
+     *
+     * For a rejected arc from -> to this is a path to, ..., from of existing arcs, which the
+     * arc would have closed into a cycle (just {from} for a self-loop).
+     *
+     * @return std::span<const int> Vertices of the cycle (empty if nothing was rejected yet)
+     */
+    [[nodiscard]] std::span<const int> cycle() const { return _cycle; }
+
+    /**
+     * @brief Get the number of vertices moved by the last insertion
+     * @return std::size_t Size of the reordered region (0 if the order was already valid)
+     */
+    [[nodiscard]] std::size_t last_reordered() const { return _slots.size(); }
+
+    /**
+     * @brief Get the number of vertices
+     * @return int Number of vertices
+     */
+    [[nodiscard]] int size() const { return _size; }
+
+    /**
+     * @brief Get the number of arcs, including those present at construction
+     * @return std::size_t Number of arcs
+     */
+    [[nodiscard]] std::size_t arc_count() const { return _base.arc_count() + _inserted; }
+
+    /**
+     * @brief Build a static graph holding all arcs
+     * @return UnweightedGraph Graph with the construction arcs followed by the inserted ones
+     */
+    [[nodiscard]] UnweightedGraph graph() const;
+
+private:
+    /**
+     * @brief Start a new search generation, clearing stale marks on wrap-around
+     */
+    void begin_search();
+
+    /**
+     * @brief Depth-first search over arcs (forward) or reversed arcs (backward) restricted to
+     *        positions strictly between bounds, marking and collecting the vertices reached
+     * @param start Starting vertex
+     * @param forward Whether to follow arcs forwards
+     * @param bound Exclusive position bound: upper for forward, lower for backward searches
+     * @param stop Vertex whose discovery aborts the search (-1 for none)
+     * @param found Receives the visited vertices
+     * @return bool False if stop was reached; _stack then holds the path to it
+     */
+    bool search(int start, bool forward, int bound, int stop, std::vector<int>& found);
+};
+
+#endif // DYNAMIC_TOPOLOGICAL_ORDER_H
@@ -0,0 +1,205 @@
+#include "edge_list.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include "src/graph/mapped_file.h"
+#include "src/graph/parallel.h"
+
+namespace {
+
+constexpr std::size_t no_error = std::numeric_limits<std::size_t>::max();
+constexpr std::size_t min_chunk_bytes = 1 << 18; ///< Smaller files are parsed by fewer threads
+constexpr std::size_t binary_edge_bytes = 3 * sizeof(std::int32_t);
+
+/**
+ * @struct Chunk
+ * @brief A line-aligned byte range of the file and what the counting pass found in it
+ */
+struct Chunk {
+    std::size_t begin;
+    std::size_t end;
+    std::size_t first_edge = 0;
+    std::size_t edges = 0;
+    int min_vertex = 0;
+    int max_vertex = -1;
+    std::size_t error = no_error; ///< Byte offset of the first malformed line
+};
+
+bool is_blank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+/**
+ * @brief Advance pos to the start of a line (pos itself if a line starts there)
+ */
+std::size_t line_start(const char* data, std::size_t length, std::size_t pos) {
+    if (pos == 0 || pos >= length || data[pos - 1] == '\n') return std::min(pos, length);
+    const void* newline = std::memchr(data + pos, '\n', length - pos);
+    return newline ? static_cast<const char*>(newline) - data + 1 : length;
+}
+
+/**
+ * @brief Parse the edge lines of data[begin, end), calling emit(u, v, w) for each edge
+ * @return std::size_t Byte offset of the first malformed line, or no_error
+ */
+template<typename Emit>
+std::size_t parse_lines(const char* data, std::size_t begin, std::size_t end, bool csv, bool weighted, Emit&& emit) {
+    const char* p = data + begin;
+    const char* const stop = data + end;
+    bool may_be_header = csv && begin == 0;
+
+    while (p < stop) {
+        const char* line = p;
+        const auto* newline = static_cast<const char*>(std::memchr(p, '\n', stop - p));
+        const char* eol = newline ? newline : stop;
+        p = newline ? newline + 1 : stop;
+
+        const char* q = line;
+        while (q < eol && is_blank(*q)) ++q;
+        if (q == eol || *q == '#' || *q == '%') continue;
+
+        int values[3] = {0, 0, 1};
+        int needed = weighted ? 3 : 2;
+        int count = 0;
+        bool valid = true;
+        while (count < needed && q < eol) {
+            auto [next, ec] = std::from_chars(q, eol, values[count]);
+            if (ec != std::errc() || (next < eol && !is_blank(*next) && *next != ',')) {
+                valid = false;
+                break;
+            }
+            ++count;
+            q = next;
+            while (q < eol && is_blank(*q)) ++q;
+            if (csv && q < eol && *q == ',') {
+                ++q;
+                while (q < eol && is_blank(*q)) ++q;
+            }
+        }
+
+        if (!valid || count < 2) {
+            if (may_be_header) {
+                may_be_header = false;
+                continue;
+            }
+            return line - data;
+        }
+        may_be_header = false;
+        emit(values[0], values[1], values[2]);
+    }
+    return no_error;
+}
+
+} // namespace
+
+EdgeList read_edge_list(const std::string& filename, EdgeListFormat format, bool weighted, int vertices, int threads,
+                        std::size_t max_edges) {
+    max_edges = std::min<std::size_t>(max_edges, std::numeric_limits<int>::max());
+    std::size_t length = 0;
+    std::shared_ptr<const void> mapping = map_file(filename, length, true);
+    const char* data = static_cast<const char*>(mapping.get());
+    threads = resolve_thread_count(threads);
+
+    std::vector<Chunk> chunks;
+    if (format == EdgeListFormat::Binary) {
+        if (length % binary_edge_bytes != 0) {
+            throw std::runtime_error("Truncated binary edge list: " + filename);
+        }
+        std::size_t edges = length / binary_edge_bytes;
+        if (edges > max_edges) {
+            throw std::overflow_error("Too many edges in " + filename);
+        }
+        std::size_t pieces = std::clamp<std::size_t>(length / min_chunk_bytes, 1, threads);
+        for (std::size_t i = 0; i < pieces; ++i) {
+            Chunk chunk{edges * i / pieces, edges * (i + 1) / pieces};
+            chunk.first_edge = chunk.begin;
+            chunk.edges = chunk.end - chunk.begin;
+            chunks.push_back(chunk);
+        }
+    } else {
+        std::size_t pieces = std::clamp<std::size_t>(length / min_chunk_bytes, 1, threads);
+        std::size_t begin = 0;
+        for (std::size_t i = 1; i <= pieces; ++i) {
+            std::size_t end = line_start(data, length, length * i / pieces);
+            if (end > begin) chunks.push_back({begin, end});
+            begin = std::max(begin, end);
+        }
+    }
+    const int chunk_count = static_cast<int>(chunks.size());
+    const bool csv = format == EdgeListFormat::Csv;
+
+    auto read_triple = [data](std::size_t edge, int (&values)[3]) {
+        std::memcpy(values, data + edge * binary_edge_bytes, binary_edge_bytes);
+    };
+
+    // Pass 1: count the edges of every chunk and the range of vertex ids.
+    parallel_for(0, chunk_count, threads, [&](int, int lo, int hi) {
+        for (int c = lo; c < hi; ++c) {
+            Chunk& chunk = chunks[c];
+            auto track = [&chunk](int u, int v) {
+                chunk.min_vertex = std::min({chunk.min_vertex, u, v});
+                chunk.max_vertex = std::max({chunk.max_vertex, u, v});
+            };
+            if (format == EdgeListFormat::Binary) {
+                int values[3];
+                for (std::size_t e = chunk.begin; e < chunk.end; ++e) {
+                    read_triple(e, values);
+                    track(values[0], values[1]);
+                }
+            } else {
+                chunk.error = parse_lines(data, chunk.begin, chunk.end, csv, weighted, [&](int u, int v, int) {
+                    track(u, v);
+                    ++chunk.edges;
+                });
+            }
+        }
+    }, 1);
+
+    EdgeList result;
+    int max_vertex = -1;
+    std::size_t total = 0;
+    for (Chunk& chunk : chunks) {
+        if (chunk.error != no_error) {
+            throw std::runtime_error("Malformed edge list at byte " + std::to_string(chunk.error) + ": " + filename);
+        }
+        if (chunk.min_vertex < 0 || (vertices > 0 && chunk.max_vertex >= vertices)) {
+            throw std::out_of_range("Vertex index out of range");
+        }
+        max_vertex = std::max(max_vertex, chunk.max_vertex);
+        chunk.first_edge = total;
+        total += chunk.edges;
+    }
+    if (total > max_edges) {
+        throw std::overflow_error("Too many edges in " + filename);
+    }
+    result.vertices = vertices > 0 ? vertices : max_vertex + 1;
+    result.from.resize(total);
+    result.to.resize(total);
+    if (weighted) result.weights.resize(total);
+
+    // Pass 2: parse every chunk straight into its slice of the output.
+    parallel_for(0, chunk_count, threads, [&](int, int lo, int hi) {
+        for (int c = lo; c < hi; ++c) {
+            std::size_t slot = chunks[c].first_edge;
+            auto store = [&](int u, int v, int w) {
+                result.from[slot] = u;
+                result.to[slot] = v;
+                if (weighted) result.weights[slot] = w;
+                ++slot;
+            };
+            if (format == EdgeListFormat::Binary) {
+                int values[3];
+                for (std::size_t e = chunks[c].begin; e < chunks[c].end; ++e) {
+                    read_triple(e, values);
+                    store(values[0], values[1], values[2]);
+                }
+            } else {
+                parse_lines(data, chunks[c].begin, chunks[c].end, csv, weighted, store);
+            }
+        }
+    }, 1);
+
+    return result;
+}
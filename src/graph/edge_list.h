@@ -0,0 +1,56 @@
+#ifndef EDGE_LIST_H
+#define EDGE_LIST_H
+
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <limits>
+
+/**
+ * @brief On-disk edge-list formats understood by read_edge_list()
+ */
+enum class EdgeListFormat {
+    Text,   ///< One edge per line: "u v [w]" separated by spaces or tabs; '#' and '%' start comments
+    Csv,    ///< One edge per line: "u,v[,w]"; a non-numeric first line is taken as a header
+    Binary, ///< Packed native-endian int32 triples (u, v, w) with no header
+};
+
+/**
+ * @struct EdgeList
+ * @brief Edges read from a file, stored as parallel arrays
+ */
+struct EdgeList {
+    int vertices = 0;         ///< Number of vertices (largest id + 1 unless given explicitly)
+    std::vector<int> from;    ///< First endpoint of each edge
+    std::vector<int> to;      ///< Second endpoint of each edge
+    std::vector<int> weights; ///< Weight of each edge (empty if weights were not requested)
+};
+
+/**
+ * @brief Read an edge list with several threads
+ *
+ * The file is memory-mapped and split into line-aligned chunks. A first parallel pass counts
+ * the edges of every chunk, the output arrays are allocated once at their exact size, and a
+ * second parallel pass parses each chunk straight into its slice, so nothing is regrown or
+ * merged. Edges keep their file order.
+ *
+ * Text lines with a missing weight get weight 1; columns beyond the ones needed are ignored.
+ *
+ * @param filename Source path
+ * @param format File format
+ * @param weighted Whether to read the weight column
+ * @param vertices Number of vertices; non-positive infers it from the largest vertex id
+ * @param threads Number of worker threads (non-positive selects hardware concurrency)
+ * @param max_edges Largest number of edges accepted (never more than INT_MAX); callers that
+ *                  store every edge as two arcs pass half the arc limit. Binary files are
+ *                  checked before any edge is read
+ * @return EdgeList Parsed edges
+ * @throw std::runtime_error if the file cannot be read or is malformed (the message names the byte offset)
+ * @throw std::out_of_range if a vertex id is negative or not below the given vertex count
+ * @throw std::overflow_error if the file holds more than max_edges edges
+ */
+[[nodiscard]] EdgeList read_edge_list(const std::string& filename, EdgeListFormat format, bool weighted,
+                                      int vertices = 0, int threads = 0,
+                                      std::size_t max_edges = std::numeric_limits<int>::max());
+
+#endif // EDGE_LIST_H
@@ -0,0 +1,168 @@
+#include "floyd_warshall.h"
+#include <algorithm>
+#include <limits>
+#include "src/graph/parallel.h"
+
+// The ifunc resolver behind target_clones runs before ThreadSanitizer is initialised and
+// crashes every binary linking this file, so sanitizer builds use the default kernel only.
+#if defined(__has_feature)
+#if __has_feature(thread_sanitizer)
+#define MIN_PLUS_NO_CLONES
+#endif
+#endif
+
+#if defined(__GNUC__) && defined(__x86_64__) && !defined(__SANITIZE_THREAD__) && !defined(MIN_PLUS_NO_CLONES)
+#define MIN_PLUS_CLONES [[gnu::target_clones("avx512f", "avx2", "default")]]
+#else
+#define MIN_PLUS_CLONES
+#endif
+
+namespace {
+
+constexpr int tile = 64;
+
+/// Sentinel for "no path"; the sum of two sentinels still fits in T
+template<typename T>
+constexpr T infinity = std::numeric_limits<T>::max() / 2;
+
+/**
+ * @brief c_row = min(c_row, a_ik + b_row), element-wise over cols entries
+ *
+ * The rows never overlap and full tiles pass a compile-time width, so the loop vectorises
+ * without runtime alias checks or a scalar tail.
+ */
+template<typename T, int Cols>
+inline void relax_row(T* __restrict c_row, const T* __restrict b_row, T a_ik, int cols) {
+    const int count = Cols > 0 ? Cols : cols;
+    for (int j = 0; j < count; ++j) c_row[j] = std::min(c_row[j], static_cast<T>(a_ik + b_row[j]));
+}
+
+/**
+ * @brief c = min(c, a (min-plus) b) for one tile, processed one k at a time
+ *
+ * Keeping k outermost makes the update valid when c aliases a or b, as in the diagonal,
+ * row and column phases. The only row that could then be both read and written is row k of
+ * a tile updated with itself, where a_ik = d(k, k) = 0 makes the update a no-op, so it is
+ * skipped. Entries never exceed infinity<T>, so the sums cannot overflow.
+ */
+template<typename T>
+inline void relax_tile_impl(T* c, const T* a, const T* b, std::size_t stride, int rows, int cols, int depth) {
+    for (int k = 0; k < depth; ++k) {
+        const T* b_row = b + k * stride;
+        for (int i = 0; i < rows; ++i) {
+            T a_ik = a[i * stride + k];
+            T* c_row = c + i * stride;
+            if (a_ik >= infinity<T> || c_row == b_row) continue;
+            if (cols == tile) {
+                relax_row<T, tile>(c_row, b_row, a_ik, cols);
+            } else {
+                relax_row<T, 0>(c_row, b_row, a_ik, cols);
+            }
+        }
+    }
+}
+
+MIN_PLUS_CLONES
+void relax_tile(int* c, const int* a, const int* b, std::size_t stride, int rows, int cols, int depth) {
+    relax_tile_impl(c, a, b, stride, rows, cols, depth);
+}
+
+MIN_PLUS_CLONES
+void relax_tile(long long* c, const long long* a, const long long* b, std::size_t stride, int rows, int cols,
+                int depth) {
+    relax_tile_impl(c, a, b, stride, rows, cols, depth);
+}
+
+/**
+ * @brief Run blocked Floyd–Warshall, leaving the n x n result contiguous in d
+ *
+ * Rows are padded while the tiles are processed: with a power-of-two row length, every row
+ * of a tile would map to the same cache sets and evict the others.
+ */
+template<typename T>
+void blocked_floyd_warshall(const CsrAdjacency& adjacency, std::vector<T>& d, int threads) {
+    const int n = adjacency.size();
+    std::size_t stride = (static_cast<std::size_t>(n) + 15) / 16 * 16;
+    if (stride % 256 == 0) stride += 16;
+    d.resize(static_cast<std::size_t>(n) * stride);
+    const int tiles = (n + tile - 1) / tile;
+    auto width = [&](int t) { return std::min(tile, n - t * tile); };
+    auto at = [&](int ti, int tj) { return d.data() + static_cast<std::size_t>(ti) * tile * stride + tj * tile; };
+
+    parallel_for(0, n, threads, [&](int, int lo, int hi) {
+        for (int v = lo; v < hi; ++v) {
+            T* row = d.data() + v * stride;
+            std::fill(row, row + n, infinity<T>);
+            row[v] = 0;
+            std::span<const int> targets = adjacency.neighbours(v), weights = adjacency.weights(v);
+            for (std::size_t i = 0; i < targets.size(); ++i) {
+                row[targets[i]] = std::min(row[targets[i]], static_cast<T>(weights[i]));
+            }
+        }
+    }, 64);
+
+    for (int k = 0; k < tiles; ++k) {
+        const int kw = width(k);
+        T* diagonal = at(k, k);
+        relax_tile(diagonal, diagonal, diagonal, stride, kw, kw, kw);
+
+        // Row k and column k only depend on the closed diagonal tile.
+        parallel_for(0, 2 * tiles, threads, [&](int, int lo, int hi) {
+            for (int t = lo; t < hi; ++t) {
+                int other = t / 2;
+                if (other == k) continue;
+                if (t % 2 == 0) {
+                    T* c = at(k, other);
+                    relax_tile(c, diagonal, c, stride, kw, width(other), kw);
+                } else {
+                    T* c = at(other, k);
+                    relax_tile(c, c, diagonal, stride, width(other), kw, kw);
+                }
+            }
+        }, 1);
+
+        // Every other tile reads row k and column k, which no longer change.
+        parallel_for(0, tiles * tiles, threads, [&](int, int lo, int hi) {
+            for (int t = lo; t < hi; ++t) {
+                int i = t / tiles, j = t % tiles;
+                if (i == k || j == k) continue;
+                relax_tile(at(i, j), at(i, k), at(k, j), stride, width(i), width(j), kw);
+            }
+        }, 1);
+    }
+
+    for (int v = 1; v < n; ++v) {
+        std::copy(d.begin() + v * stride, d.begin() + v * stride + n, d.begin() + static_cast<std::size_t>(v) * n);
+    }
+    d.resize(static_cast<std::size_t>(n) * n);
+}
+
+} // namespace
+
+DistanceMatrix floyd_warshall(const CsrAdjacency& adjacency, int max_weight, int threads) {
+    threads = resolve_thread_count(threads);
+    const int n = adjacency.size();
+    const std::size_t entries = static_cast<std::size_t>(n) * n;
+    std::vector<int> distances;
+
+    if (static_cast<long long>(std::max(n - 1, 0)) * max_weight < infinity<int>) {
+        blocked_floyd_warshall(adjacency, distances, threads);
+        parallel_for(0, n, threads, [&](int, int lo, int hi) {
+            for (std::size_t i = static_cast<std::size_t>(lo) * n; i < static_cast<std::size_t>(hi) * n; ++i) {
+                if (distances[i] == infinity<int>) distances[i] = -1;
+            }
+        }, 64);
+    } else {
+        std::vector<long long> wide;
+        distances.resize(entries);
+        blocked_floyd_warshall(adjacency, wide, threads);
+        parallel_for(0, n, threads, [&](int, int lo, int hi) {
+            for (std::size_t i = static_cast<std::size_t>(lo) * n; i < static_cast<std::size_t>(hi) * n; ++i) {
+                distances[i] = wide[i] == infinity<long long>
+                                   ? -1
+                                   : static_cast<int>(std::min<long long>(wide[i], std::numeric_limits<int>::max()));
+            }
+        }, 64);
+    }
+    return DistanceMatrix(n, std::move(distances));
+}
@@ -0,0 +1,139 @@
+#include "graph_file.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "src/graph/mapped_file.h"
+
+namespace {
+
+constexpr char graph_magic[8] = {'D', 'S', 'A', '-', 'C', 'S', 'R', '\0'};
+constexpr std::uint32_t graph_version = 1;
+constexpr std::uint32_t byte_order_mark = 0x01020304;
+
+struct GraphFileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint32_t kind;
+    std::int32_t max_weight;
+    std::uint64_t vertices;
+    std::uint64_t arcs;
+    std::uint64_t payload_checksum;
+    std::uint64_t header_checksum; ///< Checksum of every preceding header byte
+    std::uint64_t reserved;
+};
+static_assert(sizeof(GraphFileHeader) == 64, "Graph file header must stay 64 bytes");
+
+constexpr std::uint64_t checksum_seed = 14695981039346656037ull;
+
+/**
+ * @brief FNV-1a style hash over 32-bit words, continuing from hash
+ */
+std::uint64_t checksum_words(std::span<const int> words, std::uint64_t hash) {
+    for (int word : words) {
+        hash = (hash ^ static_cast<std::uint32_t>(word)) * 1099511628211ull;
+    }
+    return hash;
+}
+
+std::uint64_t checksum_header(const GraphFileHeader& header) {
+    std::uint64_t hash = checksum_seed;
+    const auto* bytes = reinterpret_cast<const unsigned char*>(&header);
+    for (std::size_t i = 0; i < offsetof(GraphFileHeader, header_checksum); ++i) {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+std::uint64_t checksum_payload(std::span<const int> offsets, std::span<const int> targets,
+                               std::span<const int> weights) {
+    return checksum_words(weights, checksum_words(targets, checksum_words(offsets, checksum_seed)));
+}
+
+} // namespace
+
+void write_graph_file(const std::string& filename, const CsrAdjacency& csr, GraphFileKind kind, int max_weight) {
+    std::ofstream out(filename, std::ios::binary);
+    if (!out) {
+        throw std::runtime_error("Cannot open file for writing: " + filename);
+    }
+
+    GraphFileHeader header{};
+    std::memcpy(header.magic, graph_magic, sizeof(graph_magic));
+    header.version = graph_version;
+    header.byte_order = byte_order_mark;
+    header.kind = static_cast<std::uint32_t>(kind);
+    header.max_weight = max_weight;
+    header.vertices = static_cast<std::uint64_t>(csr.size());
+    header.arcs = csr.arc_count();
+    header.payload_checksum = checksum_payload(csr.offsets(), csr.targets(), csr.all_weights());
+    header.header_checksum = checksum_header(header);
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (std::span<const int> section : {csr.offsets(), csr.targets(), csr.all_weights()}) {
+        out.write(reinterpret_cast<const char*>(section.data()),
+                  static_cast<std::streamsize>(section.size_bytes()));
+    }
+
+    if (!out) {
+        throw std::runtime_error("Failed to write graph file: " + filename);
+    }
+}
+
+std::pair<CsrAdjacency, int> map_graph_file(const std::string& filename, GraphFileKind kind, bool verify) {
+    std::size_t length = 0;
+    std::shared_ptr<const void> mapping = map_file(filename, length);
+    if (length < sizeof(GraphFileHeader)) {
+        throw std::runtime_error("Not a graph file: " + filename);
+    }
+
+    GraphFileHeader header{};
+    std::memcpy(&header, mapping.get(), sizeof(header));
+    if (std::memcmp(header.magic, graph_magic, sizeof(graph_magic)) != 0) {
+        throw std::runtime_error("Not a graph file: " + filename);
+    }
+    if (header.version != graph_version) {
+        throw std::runtime_error("Unsupported graph file version in " + filename);
+    }
+    if (header.byte_order != byte_order_mark) {
+        throw std::runtime_error("Graph file was written with a different byte order: " + filename);
+    }
+    if (header.header_checksum != checksum_header(header)) {
+        throw std::runtime_error("Corrupt graph file header in " + filename);
+    }
+    if (header.kind != static_cast<std::uint32_t>(kind)) {
+        throw std::runtime_error("Graph file holds a different kind of graph: " + filename);
+    }
+
+    constexpr auto limit = static_cast<std::uint64_t>(std::numeric_limits<int>::max());
+    bool weighted = kind == GraphFileKind::Undirected;
+    if (header.vertices >= limit || header.arcs > limit
+        || length != sizeof(header) + sizeof(int) * (header.vertices + 1 + header.arcs * (weighted ? 2 : 1))) {
+        throw std::runtime_error("Truncated or oversized graph file: " + filename);
+    }
+
+    const int* base = reinterpret_cast<const int*>(static_cast<const char*>(mapping.get()) + sizeof(header));
+    std::span<const int> offsets(base, header.vertices + 1);
+    std::span<const int> targets(offsets.data() + offsets.size(), header.arcs);
+    std::span<const int> weights(targets.data() + targets.size(), weighted ? header.arcs : 0);
+    int size = static_cast<int>(header.vertices);
+
+    bool valid = offsets.front() == 0 && offsets.back() == static_cast<int>(header.arcs) && header.max_weight >= 0;
+    if (valid && verify) {
+        valid = header.payload_checksum == checksum_payload(offsets, targets, weights)
+                && std::is_sorted(offsets.begin(), offsets.end())
+                && std::all_of(targets.begin(), targets.end(), [size](int v) { return v >= 0 && v < size; })
+                && std::all_of(weights.begin(), weights.end(), [&](int w) { return w >= 0 && w <= header.max_weight; });
+    }
+    if (!valid) {
+        throw std::runtime_error("Corrupt graph file payload in " + filename);
+    }
+
+    return {CsrAdjacency::borrow(size, weighted, offsets, targets, weights, std::move(mapping)), header.max_weight};
+}
@@ -0,0 +1,65 @@
+#ifndef GRAPH_FILE_H
+#define GRAPH_FILE_H
+
+#include <string>
+#include <utility>
+#include <cstdint>
+#include "src/graph/csr.h"
+
+/**
+ * @file graph_file.h
+ * @brief Versioned binary CSR graph files that can be memory-mapped and queried in place.
+ *
+ * Layout (native byte order, checked on load):
+ *
+ *  - 64-byte header: magic "DSA-CSR", format version, byte-order mark, graph kind, largest
+ *    weight, vertex count, arc count, payload checksum and a checksum of the header itself
+ *  - row offsets: vertices + 1 int32 values
+ *  - targets: arcs int32 values
+ *  - weights: arcs int32 values (weighted kinds only)
+ *
+ * Every section starts on a 4-byte boundary of a page-aligned mapping, so the arrays are
+ * handed to CsrAdjacency::borrow() without copying or parsing. The mapping stays alive as
+ * long as any adjacency (or graph) built from it does.
+ */
+
+/**
+ * @brief Kind of graph stored in a file, so a file is never loaded as the wrong graph type
+ */
+enum class GraphFileKind : std::uint32_t {
+    Undirected = 1, ///< WeightedGraph: both directions of every edge, with weights
+    Directed = 2,   ///< UnweightedGraph: directed arcs without weights
+};
+
+/**
+ * @brief Write a CSR adjacency to a graph file
+ * @param filename Destination path
+ * @param csr Adjacency to write
+ * @param kind Graph kind recorded in the header
+ * @param max_weight Largest arc weight (0 for unweighted graphs)
+ * @throw std::runtime_error if the file cannot be written
+ */
+void write_graph_file(const std::string& filename, const CsrAdjacency& csr, GraphFileKind kind, int max_weight);
+
+/**
+ * @brief Memory-map a graph file and wrap its arrays without copying them
+ *
+ * The header checksum, sizes and kind are always checked; without verify nothing else is
+ * read, so loading costs O(1) and pages are faulted in only as queries touch them. With
+ * verify set, the payload checksum, the monotonicity of the offsets, the range of every
+ * target and the range 0 .. max_weight of every weight are checked too, which reads the
+ * whole file once. Skip it only for files from a trusted writer: a corrupt payload loaded
+ * without verification leads to out-of-bounds reads.
+ *
+ * @param filename Source path
+ * @param kind Graph kind the caller expects
+ * @param verify Whether to validate the payload as well as the header
+ * @return std::pair<CsrAdjacency, int>
+ *         First: adjacency borrowing the mapped arrays
+ *         Second: largest arc weight recorded in the header
+ * @throw std::runtime_error if the file cannot be read or is not a valid graph file of that kind
+ */
+[[nodiscard]] std::pair<CsrAdjacency, int> map_graph_file(const std::string& filename, GraphFileKind kind,
+                                                          bool verify = true);
+
+#endif // GRAPH_FILE_H
@@ -0,0 +1,49 @@
+#include "mapped_file.h"
+#include <stdexcept>
+#if defined(_WIN32)
+#include <fstream>
+#include <iterator>
+#include <vector>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+std::shared_ptr<const void> map_file(const std::string& filename, std::size_t& length, bool sequential) {
+#if defined(_WIN32)
+    // No mmap here: fall back to reading the file into one heap block.
+    std::ifstream in(filename, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Cannot open file for reading: " + filename);
+    }
+    auto data = std::make_shared<std::vector<char>>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    length = data->size();
+    if (length == 0) return nullptr;
+    return {data, data->data()};
+#else
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open file for reading: " + filename);
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot read file size: " + filename);
+    }
+    length = static_cast<std::size_t>(info.st_size);
+    if (length == 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    void* address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        throw std::runtime_error("Cannot map file: " + filename);
+    }
+    // Without a hint the kernel keeps its default readahead, which suits random access too.
+    if (sequential) ::madvise(address, length, MADV_SEQUENTIAL);
+    return {address, [length](const void* p) { ::munmap(const_cast<void*>(p), length); }};
+#endif
+}
@@ -0,0 +1,25 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <memory>
+#include <string>
+#include <cstddef>
+
+/**
+ * @brief Map a whole file into memory read-only
+ *
+ * Uses mmap on POSIX systems; elsewhere the file is read into a single heap block. The file
+ * stays mapped until the last copy of the returned pointer is released, so the pointer can be
+ * handed to anything that borrows the file's contents.
+ *
+ * @param filename Path of the file
+ * @param length Receives the file size in bytes
+ * @param sequential Whether the contents will be read once from front to back; pages behind
+ *                   the reader may then be dropped early, which hurts random access
+ * @return std::shared_ptr<const void> Start of the file contents (null for an empty file)
+ * @throw std::runtime_error if the file cannot be opened or mapped
+ */
+[[nodiscard]] std::shared_ptr<const void> map_file(const std::string& filename, std::size_t& length,
+                                                  bool sequential = false);
+
+#endif // MAPPED_FILE_H
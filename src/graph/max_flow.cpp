@@ -0,0 +1,396 @@
+#include "max_flow.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include "src/graph/weighted_graph.h"
+
+namespace {
+
+using Arc = FlowNetwork::Arc;
+
+/**
+ * @brief Highest-label push-relabel over a flat residual arc array
+ *
+ * Vertices with label below V are kept in one doubly linked list per label, which makes the
+ * gap test O(1), and active vertices additionally in one stack per label. A vertex that can
+ * no longer reach the sink gets label V and leaves both.
+ */
+class HighestLabelPushRelabel {
+private:
+    const std::vector<int>& _offsets;
+    std::vector<Arc>& _arcs;
+    const int _n, _source, _sink;
+    std::vector<int> _label, _current;
+    std::vector<long long> _excess;
+    std::vector<int> _active_head, _active_next;
+    std::vector<int> _bucket_head, _bucket_next, _bucket_prev;
+    std::vector<int> _queue;
+    int _max_active = -1, _max_label = 0;
+    long long _work = 0;
+
+public:
+    HighestLabelPushRelabel(const std::vector<int>& offsets, std::vector<Arc>& arcs, int n, int source, int sink)
+        : _offsets(offsets), _arcs(arcs), _n(n), _source(source), _sink(sink), _label(n), _current(n), _excess(n, 0),
+          _active_head(n), _active_next(n), _bucket_head(n), _bucket_next(n), _bucket_prev(n), _queue(n) {}
+
+    /**
+     * @brief Run both phases
+     * @return long long Flow value
+     */
+    long long run() {
+        for (int a = _offsets[_source]; a < _offsets[_source + 1]; ++a) {
+            Arc& arc = _arcs[a];
+            _excess[arc.head] += arc.residual;
+            _arcs[arc.reverse].residual += arc.residual;
+            arc.residual = 0;
+        }
+        global_relabel();
+
+        // Relabeling work between two global relabels; V + E keeps them at O(1) amortised.
+        const long long budget = 6LL * _n + static_cast<long long>(_arcs.size()) / 2;
+        while (_max_active >= 0) {
+            int v = _active_head[_max_active];
+            if (v == -1) {
+                --_max_active;
+                continue;
+            }
+            _active_head[_max_active] = _active_next[v];
+            discharge(v);
+            if (_work > budget) global_relabel();
+        }
+
+        long long value = _excess[_sink];
+        return_excess();
+        return value;
+    }
+
+private:
+    void insert(int v) {
+        int l = _label[v];
+        _bucket_prev[v] = -1;
+        _bucket_next[v] = _bucket_head[l];
+        if (_bucket_head[l] != -1) _bucket_prev[_bucket_head[l]] = v;
+        _bucket_head[l] = v;
+        _max_label = std::max(_max_label, l);
+    }
+
+    void erase(int v) {
+        if (_bucket_prev[v] != -1) {
+            _bucket_next[_bucket_prev[v]] = _bucket_next[v];
+        } else {
+            _bucket_head[_label[v]] = _bucket_next[v];
+        }
+        if (_bucket_next[v] != -1) _bucket_prev[_bucket_next[v]] = _bucket_prev[v];
+    }
+
+    void activate(int v) {
+        _active_next[v] = _active_head[_label[v]];
+        _active_head[_label[v]] = v;
+        _max_active = std::max(_max_active, _label[v]);
+    }
+
+    /**
+     * @brief Reset every label to the exact residual distance to the sink
+     */
+    void global_relabel() {
+        std::fill(_label.begin(), _label.end(), _n);
+        _label[_sink] = 0;
+        _queue[0] = _sink;
+        for (int head = 0, tail = 1; head < tail; ++head) {
+            int w = _queue[head];
+            for (int a = _offsets[w]; a < _offsets[w + 1]; ++a) {
+                int u = _arcs[a].head;
+                if (_label[u] == _n && u != _source && _arcs[_arcs[a].reverse].residual > 0) {
+                    _label[u] = _label[w] + 1;
+                    _queue[tail++] = u;
+                }
+            }
+        }
+
+        std::fill(_bucket_head.begin(), _bucket_head.end(), -1);
+        std::fill(_active_head.begin(), _active_head.end(), -1);
+        _max_active = -1;
+        _max_label = 0;
+        for (int v = 0; v < _n; ++v) {
+            if (_label[v] == _n) continue;
+            insert(v);
+            _current[v] = _offsets[v];
+            if (_excess[v] > 0 && v != _sink) activate(v);
+        }
+        _work = 0;
+    }
+
+    void discharge(int v) {
+        while (true) {
+            const int end = _offsets[v + 1];
+            for (int& a = _current[v]; a < end; ++a) {
+                Arc& arc = _arcs[a];
+                int w = arc.head;
+                if (arc.residual == 0 || _label[w] + 1 != _label[v]) continue;
+                int amount = static_cast<int>(std::min<long long>(_excess[v], arc.residual));
+                if (_excess[w] == 0 && w != _sink) activate(w);
+                arc.residual -= amount;
+                _arcs[arc.reverse].residual += amount;
+                _excess[v] -= amount;
+                _excess[w] += amount;
+                if (_excess[v] == 0) return;
+            }
+            relabel(v);
+            if (_label[v] == _n) return;
+        }
+    }
+
+    void relabel(int v) {
+        const int old = _label[v];
+        erase(v);
+        if (_bucket_head[old] == -1) {
+            // Gap: nothing is left at label old, so nothing above it reaches the sink. v is the
+            // highest active vertex, so every vertex lifted here is inactive.
+            for (int l = old + 1; l <= _max_label; ++l) {
+                for (int u = _bucket_head[l]; u != -1; u = _bucket_next[u]) _label[u] = _n;
+                _bucket_head[l] = -1;
+            }
+            _max_label = old - 1;
+            _label[v] = _n;
+            return;
+        }
+
+        int best = _n, best_arc = _offsets[v];
+        for (int a = _offsets[v]; a < _offsets[v + 1]; ++a) {
+            if (_arcs[a].residual > 0 && _label[_arcs[a].head] + 1 < best) {
+                best = _label[_arcs[a].head] + 1;
+                best_arc = a;
+            }
+        }
+        _work += _offsets[v + 1] - _offsets[v] + 12;
+        _label[v] = best;
+        if (best < _n) {
+            _current[v] = best_arc;
+            insert(v);
+        }
+    }
+
+    /**
+     * @brief Second phase: push the excess stranded on the source side back to the source
+     *
+     * Labels become residual distances to the source and vertices are discharged in FIFO
+     * order. Every push stays inside the set that cannot reach the sink, so the flow value
+     * does not change.
+     */
+    void return_excess() {
+        std::fill(_label.begin(), _label.end(), -1);
+        _label[_source] = 0;
+        _queue[0] = _source;
+        for (int head = 0, tail = 1; head < tail; ++head) {
+            int w = _queue[head];
+            for (int a = _offsets[w]; a < _offsets[w + 1]; ++a) {
+                int u = _arcs[a].head;
+                if (_label[u] == -1 && _arcs[_arcs[a].reverse].residual > 0) {
+                    _label[u] = _label[w] + 1;
+                    _queue[tail++] = u;
+                }
+            }
+        }
+
+        // Each vertex is queued at most once at a time, so a ring of V slots suffices.
+        std::vector<char> queued(_n, 0);
+        std::size_t head = 0, tail = 0;
+        for (int v = 0; v < _n; ++v) {
+            _current[v] = _offsets[v];
+            if (_excess[v] > 0 && v != _source && v != _sink) {
+                queued[v] = 1;
+                _queue[tail++ % _n] = v;
+            }
+        }
+        while (head != tail) {
+            int v = _queue[head++ % _n];
+            queued[v] = 0;
+            while (_excess[v] > 0) {
+                if (_current[v] == _offsets[v + 1]) {
+                    int best = std::numeric_limits<int>::max();
+                    for (int a = _offsets[v]; a < _offsets[v + 1]; ++a) {
+                        int u = _arcs[a].head;
+                        if (_arcs[a].residual > 0 && _label[u] >= 0) best = std::min(best, _label[u] + 1);
+                    }
+                    _label[v] = best;
+                    _current[v] = _offsets[v];
+                }
+                Arc& arc = _arcs[_current[v]];
+                int w = arc.head;
+                if (arc.residual == 0 || _label[w] < 0 || _label[w] + 1 != _label[v]) {
+                    ++_current[v];
+                    continue;
+                }
+                int amount = static_cast<int>(std::min<long long>(_excess[v], arc.residual));
+                arc.residual -= amount;
+                _arcs[arc.reverse].residual += amount;
+                _excess[v] -= amount;
+                _excess[w] += amount;
+                if (w != _source && !queued[w]) {
+                    queued[w] = 1;
+                    _queue[tail++ % _n] = w;
+                }
+            }
+        }
+    }
+};
+
+} // namespace
+
+FlowNetwork::FlowNetwork(int size) : _size(size) {}
+
+FlowNetwork FlowNetwork::from_graph(const WeightedGraph& graph) {
+    FlowNetwork network(graph.size());
+    for (int u = 0; u < graph.size(); ++u) {
+        std::span<const int> targets = graph.neighbours(u), weights = graph.neighbour_weights(u);
+        for (std::size_t i = 0; i < targets.size(); ++i) network._edges.push_back({u, targets[i], weights[i]});
+    }
+    return network;
+}
+
+int FlowNetwork::add_edge(int from, int to, int capacity) {
+    if (from < 0 || from >= _size || to < 0 || to >= _size) {
+        throw std::out_of_range("Vertex index out of range");
+    }
+    if (capacity < 0) {
+        throw std::invalid_argument("Edge capacity cannot be negative");
+    }
+    _edges.push_back({from, to, capacity});
+    _packed = false;
+    return static_cast<int>(_edges.size()) - 1;
+}
+
+void FlowNetwork::reserve_edges(std::size_t edges) {
+    _edges.reserve(_edges.size() + edges);
+}
+
+void FlowNetwork::pack() const {
+    if (_packed) return;
+    _offsets.assign(_size + 1, 0);
+    for (const Edge& e : _edges) {
+        ++_offsets[e.from + 1];
+        ++_offsets[e.to + 1];
+    }
+    for (int v = 0; v < _size; ++v) _offsets[v + 1] += _offsets[v];
+
+    std::vector<int> cursor(_offsets.begin(), _offsets.end() - 1);
+    _arcs.resize(2 * _edges.size());
+    _edge_arc.resize(_edges.size());
+    for (std::size_t i = 0; i < _edges.size(); ++i) {
+        const Edge& e = _edges[i];
+        int forward = cursor[e.from]++, backward = cursor[e.to]++;
+        _arcs[forward] = {e.to, backward, e.capacity};
+        _arcs[backward] = {e.from, forward, 0};
+        _edge_arc[i] = forward;
+    }
+    _packed = true;
+}
+
+void FlowNetwork::check_terminals(int source, int sink) const {
+    if (source < 0 || source >= _size || sink < 0 || sink >= _size) {
+        throw std::out_of_range("Vertex index out of range");
+    }
+    if (source == sink) {
+        throw std::invalid_argument("Source and sink must differ");
+    }
+}
+
+FlowNetwork::MaxFlow FlowNetwork::collect(const std::vector<Arc>& arcs, int source, long long value) const {
+    MaxFlow result;
+    result.value = value;
+    result.flow.resize(_edges.size());
+    for (std::size_t i = 0; i < _edges.size(); ++i) {
+        // The reverse arc starts empty, so its residual is the flow pushed over the edge.
+        result.flow[i] = arcs[arcs[_edge_arc[i]].reverse].residual;
+    }
+
+    result.source_side.assign(_size, 0);
+    std::vector<int> queue{source};
+    result.source_side[source] = 1;
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        int v = queue[head];
+        for (int a = _offsets[v]; a < _offsets[v + 1]; ++a) {
+            if (arcs[a].residual > 0 && !result.source_side[arcs[a].head]) {
+                result.source_side[arcs[a].head] = 1;
+                queue.push_back(arcs[a].head);
+            }
+        }
+    }
+    return result;
+}
+
+FlowNetwork::MaxFlow FlowNetwork::dinic(int source, int sink) const {
+    check_terminals(source, sink);
+    pack();
+    std::vector<Arc> arcs = _arcs;
+    std::vector<int> level(_size), current(_size), queue(_size), path;
+    long long value = 0;
+
+    // Levels are residual distances to the sink, found by a backward BFS that stops at the
+    // source: the depth-first search then only enters vertices that can still reach the sink.
+    auto build_levels = [&] {
+        std::fill(level.begin(), level.end(), -1);
+        level[sink] = 0;
+        queue[0] = sink;
+        for (int head = 0, tail = 1; head < tail; ++head) {
+            int w = queue[head];
+            for (int a = _offsets[w]; a < _offsets[w + 1]; ++a) {
+                int u = arcs[a].head;
+                if (level[u] != -1 || arcs[arcs[a].reverse].residual == 0) continue;
+                level[u] = level[w] + 1;
+                if (u == source) return true;
+                queue[tail++] = u;
+            }
+        }
+        return false;
+    };
+
+    while (build_levels()) {
+        std::copy(_offsets.begin(), _offsets.end() - 1, current.begin());
+        path.clear();
+        int v = source;
+        while (true) {
+            if (v == sink) {
+                int bottleneck = std::numeric_limits<int>::max();
+                for (int a : path) bottleneck = std::min(bottleneck, arcs[a].residual);
+                std::size_t retreat = path.size();
+                for (std::size_t i = 0; i < path.size(); ++i) {
+                    Arc& arc = arcs[path[i]];
+                    arc.residual -= bottleneck;
+                    arcs[arc.reverse].residual += bottleneck;
+                    if (arc.residual == 0 && retreat == path.size()) retreat = i;
+                }
+                value += bottleneck;
+                // Resume from the tail of the first saturated arc.
+                path.resize(retreat);
+                v = path.empty() ? source : arcs[path.back()].head;
+                continue;
+            }
+
+            int& a = current[v];
+            const int end = _offsets[v + 1];
+            while (a < end && (arcs[a].residual == 0 || level[arcs[a].head] != level[v] - 1)) ++a;
+            if (a < end) {
+                path.push_back(a);
+                v = arcs[a].head;
+                continue;
+            }
+
+            // Dead end: v cannot reach the sink in this level graph any more.
+            level[v] = -1;
+            if (path.empty()) break;
+            v = arcs[arcs[path.back()].reverse].head;
+            path.pop_back();
+            ++current[v];
+        }
+    }
+    return collect(arcs, source, value);
+}
+
+FlowNetwork::MaxFlow FlowNetwork::push_relabel(int source, int sink) const {
+    check_terminals(source, sink);
+    pack();
+    std::vector<Arc> arcs = _arcs;
+    long long value = HighestLabelPushRelabel(_offsets, arcs, _size, source, sink).run();
+    return collect(arcs, source, value);
+}
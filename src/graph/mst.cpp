@@ -1,4 +1,5 @@
 #include "mst.h"
+#include "src/graph/boruvka.h"
 
 MSTGraph::MSTGraph(int vertices) : _size(vertices), adj_list(vertices) {}
 
@@ -30,7 +31,7 @@ std::vector<MSTGraph::Edge> MSTGraph::kruskal_mst() {
         }
     }
 
-    return mst.size() == _size - 1 ? mst : std::vector<Edge>();
+    return mst.size() == static_cast<std::size_t>(_size) - 1 ? mst : std::vector<Edge>();
 }
 
 std::vector<MSTGraph::Edge> MSTGraph::prim_mst() {
@@ -66,5 +67,24 @@ std::vector<MSTGraph::Edge> MSTGraph::prim_mst() {
         }
     }
 
-    return mst.size() == _size - 1 ? mst : std::vector<Edge>();
+    return mst.size() == static_cast<std::size_t>(_size) - 1 ? mst : std::vector<Edge>();
+}
+
+std::vector<MSTGraph::Edge> MSTGraph::boruvka_mst(int threads) const {
+    std::vector<int> from, to, weights;
+    for (int u = 0; u < _size; ++u) {
+        for (const auto& [v, w] : adj_list[u]) {
+            if (u < v) {
+                from.push_back(u);
+                to.push_back(v);
+                weights.push_back(w);
+            }
+        }
+    }
+
+    std::vector<Edge> forest;
+    for (std::size_t e : boruvka_forest(_size, from, to, weights, threads)) {
+        forest.emplace_back(from[e], to[e], weights[e]);
+    }
+    return forest;
 }
\ No newline at end of file
@@ -68,6 +68,17 @@ public:
      */
     std::vector<Edge> prim_mst();
 
+    /**
+     * @brief Parallel Borůvka algorithm to find a minimum spanning forest
+     *
+     * Unlike kruskal_mst() and prim_mst(), a disconnected graph yields one tree per connected
+     * component instead of an empty vector.
+     *
+     * @param threads Number of worker threads (non-positive selects hardware concurrency)
+     * @return Vector of Edges representing the minimum spanning forest
+     */
+    std::vector<Edge> boruvka_mst(int threads = 0) const;
+
     /**
      * @brief Get the number of vertices in the graph
      * @return Number of vertices
@@ -0,0 +1,278 @@
+#include "multi_source_bfs.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+#include "src/graph/parallel.h"
+
+namespace {
+
+constexpr long long alpha = 14;
+constexpr long long beta = 24;
+
+/**
+ * @brief Bit-parallel breadth-first search of up to Words * 64 sources at once
+ *
+ * Invariants between levels: frontier holds the bits discovered at the previous level and is
+ * zero outside the active list; next and touched are zero everywhere. The buffers are reused
+ * across batches.
+ */
+template<int Words>
+class MultiSourceSearch {
+public:
+    using Bits = std::array<std::uint64_t, Words>;
+    static constexpr int width = Words * 64;
+
+    MultiSourceSearch(const CsrAdjacency& adjacency, const CsrAdjacency& reverse, int threads)
+        : _adj(adjacency), _radj(reverse), _threads(threads), _seen(adjacency.size()),
+          _frontier(adjacency.size()), _next(adjacency.size()), _touched(adjacency.size(), 0),
+          _candidates(threads), _local_edges(threads), _local_settled(threads) {}
+
+    /**
+     * @brief Search from up to width sources, reporting every (source, vertex) pair once
+     *
+     * visit(worker, i, vertex, distance) is called when the search from sources[i] reaches
+     * vertex; calls from one worker never overlap, calls for one source may come from any
+     * worker.
+     */
+    template<typename Visit>
+    void run(std::span<const int> sources, Visit&& visit) {
+        const int n = _adj.size();
+        const int count = static_cast<int>(sources.size());
+        Bits full{};
+        for (int i = 0; i < count; ++i) full[i >> 6] |= std::uint64_t{1} << (i & 63);
+        parallel_for(0, n, _threads, [&](int, int lo, int hi) {
+            std::fill(_seen.begin() + lo, _seen.begin() + hi, Bits{});
+        }, 4096);
+
+        _active.clear();
+        for (int i = 0; i < count; ++i) {
+            int v = sources[i];
+            if (empty(_frontier[v])) _active.push_back(v);
+            _frontier[v][i >> 6] |= std::uint64_t{1} << (i & 63);
+            _seen[v][i >> 6] |= std::uint64_t{1} << (i & 63);
+            visit(0, i, v, 0);
+        }
+        long long frontier_edges = 0;
+        long long unexplored_edges = static_cast<long long>(_adj.arc_count());
+        for (int v : _active) {
+            frontier_edges += _adj.degree(v);
+            if (_seen[v] == full) unexplored_edges -= _adj.degree(v);
+        }
+
+        bool bottom_up = false;
+        for (int level = 1; !_active.empty(); ++level) {
+            if (!bottom_up && frontier_edges > unexplored_edges / alpha) {
+                bottom_up = true;
+            } else if (bottom_up && static_cast<long long>(_active.size()) < n / beta) {
+                bottom_up = false;
+            }
+            int used = bottom_up ? pull(full) : push();
+
+            // The old frontier is cleared before the new one is written, since a vertex can be
+            // in both for different sources.
+            parallel_for(0, static_cast<int>(_active.size()), _threads, [&](int, int lo, int hi) {
+                for (int i = lo; i < hi; ++i) _frontier[_active[i]] = Bits{};
+            }, 1024);
+            _active.clear();
+            for (int t = 0; t < used; ++t) _active.insert(_active.end(), _candidates[t].begin(), _candidates[t].end());
+
+            std::fill(_local_edges.begin(), _local_edges.end(), 0);
+            std::fill(_local_settled.begin(), _local_settled.end(), 0);
+            used = parallel_for(0, static_cast<int>(_active.size()), _threads, [&](int worker, int lo, int hi) {
+                for (int i = lo; i < hi; ++i) {
+                    int v = _active[i];
+                    Bits fresh;
+                    for (int k = 0; k < Words; ++k) {
+                        fresh[k] = _next[v][k] & ~_seen[v][k];
+                        _seen[v][k] |= fresh[k];
+                    }
+                    _frontier[v] = fresh;
+                    _next[v] = Bits{};
+                    _touched[v] = 0;
+                    _local_edges[worker] += _adj.degree(v);
+                    if (_seen[v] == full) _local_settled[worker] += _adj.degree(v);
+                    for (int k = 0; k < Words; ++k) {
+                        for (std::uint64_t bits = fresh[k]; bits; bits &= bits - 1) {
+                            visit(worker, k * 64 + std::countr_zero(bits), v, level);
+                        }
+                    }
+                }
+            }, 256);
+            frontier_edges = 0;
+            for (int t = 0; t < used; ++t) {
+                frontier_edges += _local_edges[t];
+                unexplored_edges -= _local_settled[t];
+            }
+        }
+    }
+
+private:
+    static bool empty(const Bits& bits) {
+        return std::ranges::all_of(bits, [](std::uint64_t word) { return word == 0; });
+    }
+
+    /**
+     * @brief Top-down level: OR each frontier vertex's bits into its out-neighbours
+     *
+     * Only bits the neighbour has not seen are sent, so every candidate gains at least one
+     * source. The first worker to touch a neighbour claims it as a candidate.
+     */
+    int push() {
+        return parallel_for(0, static_cast<int>(_active.size()), _threads, [&](int worker, int lo, int hi) {
+            std::vector<int>& candidates = _candidates[worker];
+            candidates.clear();
+            for (int i = lo; i < hi; ++i) {
+                const Bits& bits = _frontier[_active[i]];
+                for (int w : _adj.neighbours(_active[i])) {
+                    Bits send;
+                    std::uint64_t any = 0;
+                    for (int k = 0; k < Words; ++k) {
+                        send[k] = bits[k] & ~_seen[w][k];
+                        any |= send[k];
+                    }
+                    if (!any) continue;
+                    if (_threads == 1) {
+                        for (int k = 0; k < Words; ++k) _next[w][k] |= send[k];
+                        if (!_touched[w]) {
+                            _touched[w] = 1;
+                            candidates.push_back(w);
+                        }
+                    } else {
+                        for (int k = 0; k < Words; ++k) {
+                            if (send[k] & ~std::atomic_ref<std::uint64_t>(_next[w][k]).load(std::memory_order_relaxed)) {
+                                std::atomic_ref<std::uint64_t>(_next[w][k]).fetch_or(send[k], std::memory_order_relaxed);
+                            }
+                        }
+                        std::atomic_ref<int> touched(_touched[w]);
+                        if (!touched.load(std::memory_order_relaxed) && !touched.exchange(1, std::memory_order_relaxed)) {
+                            candidates.push_back(w);
+                        }
+                    }
+                }
+            }
+        }, 256);
+    }
+
+    /**
+     * @brief Bottom-up level: every vertex still missing some sources ORs in the frontier
+     *        bits of its in-neighbours, stopping once all missing sources are found
+     *
+     * Each vertex is written only by the worker that owns it, so no atomics are needed.
+     */
+    int pull(const Bits& full) {
+        return parallel_for(0, _adj.size(), _threads, [&](int worker, int lo, int hi) {
+            std::vector<int>& candidates = _candidates[worker];
+            candidates.clear();
+            for (int v = lo; v < hi; ++v) {
+                Bits missing;
+                std::uint64_t any = 0;
+                for (int k = 0; k < Words; ++k) {
+                    missing[k] = full[k] & ~_seen[v][k];
+                    any |= missing[k];
+                }
+                if (!any) continue;
+                Bits found{};
+                for (int u : _radj.neighbours(v)) {
+                    std::uint64_t left = 0;
+                    for (int k = 0; k < Words; ++k) {
+                        found[k] |= _frontier[u][k] & missing[k];
+                        left |= missing[k] & ~found[k];
+                    }
+                    if (!left) break;
+                }
+                if (!empty(found)) {
+                    _next[v] = found;
+                    candidates.push_back(v);
+                }
+            }
+        }, 256);
+    }
+
+    const CsrAdjacency& _adj;
+    const CsrAdjacency& _radj;
+    int _threads;
+    std::vector<Bits> _seen, _frontier, _next;
+    std::vector<int> _touched;
+    std::vector<int> _active;
+    std::vector<std::vector<int>> _candidates;
+    std::vector<long long> _local_edges, _local_settled;
+};
+
+/**
+ * @brief Run the searches batch by batch with the engine matching batch_width
+ *
+ * visit(worker, source, vertex, distance) receives the index of the source in @p sources.
+ */
+template<typename Visit>
+void for_each_batch(const CsrAdjacency& adjacency, const CsrAdjacency& reverse, std::span<const int> sources,
+                    int batch_width, int threads, Visit&& visit) {
+    auto run = [&]<int Words>() {
+        MultiSourceSearch<Words> search(adjacency, reverse, threads);
+        constexpr int width = MultiSourceSearch<Words>::width;
+        for (std::size_t first = 0; first < sources.size(); first += width) {
+            const int offset = static_cast<int>(first);
+            search.run(sources.subspan(first, std::min<std::size_t>(width, sources.size() - first)),
+                       [&](int worker, int i, int v, int distance) { visit(worker, offset + i, v, distance); });
+        }
+    };
+    switch (batch_width) {
+    case 64: run.template operator()<1>(); break;
+    case 256: run.template operator()<4>(); break;
+    case 512: run.template operator()<8>(); break;
+    default: throw std::invalid_argument("Batch width must be 64, 256 or 512");
+    }
+}
+
+} // namespace
+
+std::vector<std::vector<int>> multi_source_distances(const CsrAdjacency& adjacency, const CsrAdjacency& reverse,
+                                                     std::span<const int> sources, int batch_width, int threads) {
+    threads = resolve_thread_count(threads);
+    std::vector<std::vector<int>> distance(sources.size(), std::vector<int>(adjacency.size(), -1));
+    for_each_batch(adjacency, reverse, sources, batch_width, threads,
+                   [&](int, int source, int v, int d) { distance[source][v] = d; });
+    return distance;
+}
+
+BfsSummary multi_source_summary(const CsrAdjacency& adjacency, const CsrAdjacency& reverse,
+                                std::span<const int> sources, int batch_width, int threads) {
+    threads = resolve_thread_count(threads);
+    const std::size_t count = sources.size();
+    BfsSummary summary;
+    summary.reached.assign(count, 0);
+    summary.distance_sum.assign(count, 0);
+    summary.eccentricity.assign(count, 0);
+    summary.arcs.assign(count, 0);
+    if (threads == 1) {
+        for_each_batch(adjacency, reverse, sources, batch_width, threads, [&](int, int source, int v, int d) {
+            summary.reached[source]++;
+            summary.distance_sum[source] += d;
+            summary.eccentricity[source] = std::max(summary.eccentricity[source], d);
+            summary.arcs[source] += adjacency.degree(v);
+        });
+        return summary;
+    }
+
+    // Workers count into their own copies; one source is typically reached by every worker.
+    std::vector<BfsSummary> local(threads);
+    for (BfsSummary& part : local) part = summary;
+    for_each_batch(adjacency, reverse, sources, batch_width, threads, [&](int worker, int source, int v, int d) {
+        BfsSummary& part = local[worker];
+        part.reached[source]++;
+        part.distance_sum[source] += d;
+        part.eccentricity[source] = std::max(part.eccentricity[source], d);
+        part.arcs[source] += adjacency.degree(v);
+    });
+    for (const BfsSummary& part : local) {
+        for (std::size_t i = 0; i < count; ++i) {
+            summary.reached[i] += part.reached[i];
+            summary.distance_sum[i] += part.distance_sum[i];
+            summary.eccentricity[i] = std::max(summary.eccentricity[i], part.eccentricity[i]);
+            summary.arcs[i] += part.arcs[i];
+        }
+    }
+    return summary;
+}
@@ -0,0 +1,66 @@
+#ifndef MULTI_SOURCE_BFS_H
+#define MULTI_SOURCE_BFS_H
+
+#include <vector>
+#include <span>
+#include "src/graph/csr.h"
+
+/**
+ * @struct BfsSummary
+ * @brief Per-source statistics of a batch of breadth-first searches.
+ *
+ * Entry i describes the search from the i-th source; the source itself counts as reached at
+ * distance 0.
+ */
+struct BfsSummary {
+    std::vector<int> reached;             ///< Number of vertices reachable from each source
+    std::vector<long long> distance_sum;  ///< Sum of distances to the reached vertices
+    std::vector<int> eccentricity;        ///< Largest distance to a reached vertex
+    std::vector<long long> arcs;          ///< Out-arcs of the reached vertices (edges traversed)
+};
+
+/**
+ * @brief Run one breadth-first search per source and return every distance
+ *
+ * Sources are processed in batches of @p batch_width. Every vertex holds one bit per search
+ * of the batch in its seen, frontier and next bitsets, so a single scan of a vertex's arcs
+ * advances all searches that reached it at that level (MS-BFS, Then et al.). Levels are
+ * expanded top-down (frontier vertices OR their bits into their out-neighbours) or bottom-up
+ * (vertices not yet seen by every search OR in the frontier bits of their in-neighbours),
+ * switching with the same thresholds as UnweightedGraph::bfs_parallel().
+ *
+ * Wider batches share more arc scans but keep 3 * batch_width / 8 bytes per vertex live.
+ *
+ * @param adjacency Graph adjacency
+ * @param reverse Reverse adjacency, used by bottom-up levels
+ * @param sources Source vertices (duplicates allowed)
+ * @param batch_width Searches run together: 64, 256 or 512
+ * @param threads Number of worker threads (non-positive selects hardware concurrency)
+ * @return std::vector<std::vector<int>> Distance from each source to each vertex (-1 for
+ *         unreachable vertices)
+ * @throw std::invalid_argument if batch_width is not 64, 256 or 512
+ */
+[[nodiscard]] std::vector<std::vector<int>> multi_source_distances(const CsrAdjacency& adjacency,
+                                                                   const CsrAdjacency& reverse,
+                                                                   std::span<const int> sources, int batch_width = 256,
+                                                                   int threads = 0);
+
+/**
+ * @brief Run one breadth-first search per source and aggregate reachability statistics
+ *
+ * Same traversal as multi_source_distances() without materialising a distance per source and
+ * vertex, so memory stays proportional to the graph and the batch width.
+ *
+ * @param adjacency Graph adjacency
+ * @param reverse Reverse adjacency, used by bottom-up levels
+ * @param sources Source vertices (duplicates allowed)
+ * @param batch_width Searches run together: 64, 256 or 512
+ * @param threads Number of worker threads (non-positive selects hardware concurrency)
+ * @return BfsSummary Reached vertices, distance sum, eccentricity and traversed arcs per source
+ * @throw std::invalid_argument if batch_width is not 64, 256 or 512
+ */
+[[nodiscard]] BfsSummary multi_source_summary(const CsrAdjacency& adjacency, const CsrAdjacency& reverse,
+                                              std::span<const int> sources, int batch_width = 256,
+                                              int threads = 0);
+
+#endif // MULTI_SOURCE_BFS_H
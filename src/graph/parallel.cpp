@@ -0,0 +1,6 @@
+#include "parallel.h"
+
+int resolve_thread_count(int threads) {
+    if (threads > 0) return threads;
+    return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
@@ -0,0 +1,71 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+/**
+ * @brief Resolve a requested thread count to the number of workers actually used
+ *
+ * Non-positive requests select std::thread::hardware_concurrency() (at least one).
+ *
+ * @param threads Requested number of threads
+ * @return int Number of worker threads, always >= 1
+ */
+int resolve_thread_count(int threads);
+
+/**
+ * @brief Run fn over [begin, end) split into contiguous chunks, one per worker thread
+ *
+ * The range is divided into at most @p threads chunks of at least @p grain elements; the
+ * calling thread processes the first chunk itself, so small ranges never spawn threads.
+ * fn is invoked as fn(worker, lo, hi) where worker is the chunk index in [0, workers).
+ *
+ * @tparam Fn Callable taking (int worker, int lo, int hi)
+ * @param begin First index of the range
+ * @param end One past the last index of the range
+ * @param threads Maximum number of workers (already resolved, see resolve_thread_count)
+ * @param fn Function executed for every chunk
+ * @param grain Minimum number of elements per chunk
+ * @return int Number of chunks the range was split into
+ */
+template<typename Fn>
+int parallel_for(int begin, int end, int threads, Fn&& fn, int grain = 1024) {
+    int n = end - begin;
+    if (n <= 0) return 0;
+    int workers = std::clamp((n + grain - 1) / grain, 1, std::max(threads, 1));
+    int chunk = (n + workers - 1) / workers;
+    workers = (n + chunk - 1) / chunk;
+
+    std::vector<std::jthread> pool;
+    pool.reserve(workers - 1);
+    for (int w = 1; w < workers; ++w) {
+        int lo = begin + w * chunk;
+        int hi = std::min(end, lo + chunk);
+        pool.emplace_back([&fn, w, lo, hi] { fn(w, lo, hi); });
+    }
+    fn(0, begin, std::min(end, begin + chunk));
+    return workers;
+}
+
+/**
+ * @brief Run fn once on each of @p workers threads for the whole call
+ *
+ * The calling thread is worker 0. Unlike parallel_for, the workers stay alive until fn
+ * returns on all of them, so algorithms made of many short phases can keep one set of
+ * threads and separate the phases with a std::barrier instead of spawning threads per phase.
+ *
+ * @tparam Fn Callable taking (int worker)
+ * @param workers Number of workers (already resolved, see resolve_thread_count)
+ * @param fn Function executed by every worker
+ */
+template<typename Fn>
+void parallel_run(int workers, Fn&& fn) {
+    std::vector<std::jthread> pool;
+    pool.reserve(std::max(workers - 1, 0));
+    for (int w = 1; w < workers; ++w) pool.emplace_back([&fn, w] { fn(w); });
+    fn(0);
+}
+
+#endif // PARALLEL_H
@@ -0,0 +1,58 @@
+#include "priority_queues.h"
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <limits>
+
+void BinaryHeapQueue::reset(int, int) {
+    _heap.clear();
+}
+
+void BinaryHeapQueue::push(int key, int vertex) {
+    _heap.emplace_back(key, vertex);
+    std::push_heap(_heap.begin(), _heap.end(), std::greater<>());
+}
+
+std::pair<int, int> BinaryHeapQueue::pop() {
+    std::pop_heap(_heap.begin(), _heap.end(), std::greater<>());
+    std::pair<int, int> top = _heap.back();
+    _heap.pop_back();
+    return top;
+}
+
+int RadixHeapQueue::bucket_of(std::uint32_t key) const {
+    return key == _last ? 0 : 32 - std::countl_zero(key ^ _last);
+}
+
+void RadixHeapQueue::reset(int, int) {
+    for (auto& bucket : _buckets) bucket.clear();
+    _last = 0;
+    _count = 0;
+}
+
+void RadixHeapQueue::push(int key, int vertex) {
+    _buckets[bucket_of(static_cast<std::uint32_t>(key))].emplace_back(key, vertex);
+    ++_count;
+}
+
+std::pair<int, int> RadixHeapQueue::pop() {
+    if (_buckets[0].empty()) {
+        int i = 1;
+        while (_buckets[i].empty()) ++i;
+
+        std::uint32_t smallest = std::numeric_limits<std::uint32_t>::max();
+        for (const auto& [key, vertex] : _buckets[i]) {
+            smallest = std::min(smallest, static_cast<std::uint32_t>(key));
+        }
+        _last = smallest;
+        for (const auto& entry : _buckets[i]) {
+            _buckets[bucket_of(static_cast<std::uint32_t>(entry.first))].push_back(entry);
+        }
+        _buckets[i].clear();
+    }
+
+    std::pair<int, int> top = _buckets[0].back();
+    _buckets[0].pop_back();
+    --_count;
+    return top;
+}
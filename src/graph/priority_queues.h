@@ -0,0 +1,219 @@
+/**
+ * @file priority_queues.h
+ * @brief Priority-queue policies for the integer-weight graph algorithms.
+ *
+ * WeightedGraph::dijkstra<Queue>() and WeightedGraph::prim_mst<Queue>() accept any of the
+ * policies below. Every policy stores (key, vertex) entries with non-negative int keys and
+ * offers the same interface:
+ *
+ *  - reset(vertices, max_weight): prepare for a run over a graph with the given size and
+ *    largest edge weight
+ *  - push(key, vertex): insert vertex, or lower its key if the policy supports decrease-key
+ *  - empty(): whether any entries remain
+ *  - pop(): remove and return a (key, vertex) entry with the smallest key
+ *
+ * Lazy policies may return stale entries whose key is larger than the vertex's current
+ * label; the algorithms skip those, exactly as with std::priority_queue.
+ *
+ * Policies that require popped keys never to decrease (monotone queues) set
+ * monotone_only = true and can only be used with Dijkstra.
+ *
+ * BasicDialBucketQueue and IndexedDaryHeapQueue also take the key type as a template
+ * parameter, so TypedWeightedGraph can queue 64-bit or floating-point distances.
+ */
+
+#ifndef PRIORITY_QUEUES_H
+#define PRIORITY_QUEUES_H
+
+#include <vector>
+#include <utility>
+#include <array>
+#include <algorithm>
+#include <cstdint>
+
+/**
+ * @class BinaryHeapQueue
+ * @brief Binary heap with lazy deletion, the behaviour of std::priority_queue.
+ */
+class BinaryHeapQueue {
+private:
+    std::vector<std::pair<int, int>> _heap;
+
+public:
+    static constexpr bool monotone_only = false;
+
+    void reset(int vertices, int max_weight);
+    void push(int key, int vertex);
+    [[nodiscard]] bool empty() const { return _heap.empty(); }
+    std::pair<int, int> pop();
+};
+
+/**
+ * @class BasicDialBucketQueue
+ * @brief Dial's circular bucket queue for small integer weights.
+ *
+ * Keeps max_weight + 1 buckets indexed by key modulo the bucket count. This is valid as long
+ * as all live keys lie within max_weight of the smallest one, which holds for Dijkstra and
+ * for Prim (whose keys are edge weights). Push and pop are O(1) amortised, plus a scan over
+ * at most max_weight empty buckets between consecutive keys.
+ *
+ * @tparam Key Unsigned or signed integer key type
+ * @tparam Vertex Vertex id type
+ */
+template<typename Key, typename Vertex = int>
+class BasicDialBucketQueue {
+private:
+    std::vector<std::vector<Vertex>> _buckets;
+    Key _current = 0;   ///< Smallest key that may still be present
+    std::size_t _count = 0;
+
+public:
+    static constexpr bool monotone_only = false;
+
+    void reset(std::size_t, int max_weight) {
+        std::size_t buckets = static_cast<std::size_t>(max_weight) + 1;
+        if (_buckets.size() != buckets) {
+            _buckets.assign(buckets, {});
+        } else {
+            for (auto& bucket : _buckets) bucket.clear();
+        }
+        _current = 0;
+        _count = 0;
+    }
+
+    void push(Key key, Vertex vertex) {
+        if (_count == 0 || key < _current) _current = key;
+        _buckets[key % _buckets.size()].push_back(vertex);
+        ++_count;
+    }
+
+    [[nodiscard]] bool empty() const { return _count == 0; }
+
+    std::pair<Key, Vertex> pop() {
+        while (_buckets[_current % _buckets.size()].empty()) ++_current;
+        auto& bucket = _buckets[_current % _buckets.size()];
+        Vertex vertex = bucket.back();
+        bucket.pop_back();
+        --_count;
+        return {_current, vertex};
+    }
+};
+
+using DialBucketQueue = BasicDialBucketQueue<int>;
+
+/**
+ * @class RadixHeapQueue
+ * @brief Monotone radix heap over 32-bit keys.
+ *
+ * Entries live in 33 buckets chosen by the highest bit in which their key differs from the
+ * last popped key. Popping an empty bucket 0 redistributes the first non-empty bucket, and
+ * each entry can only move to lower buckets, giving O(log C) amortised operations. Keys
+ * pushed must not be smaller than the last popped key, so the policy is Dijkstra-only.
+ */
+class RadixHeapQueue {
+private:
+    std::array<std::vector<std::pair<int, int>>, 33> _buckets;
+    std::uint32_t _last = 0; ///< Last popped key
+    std::size_t _count = 0;
+
+    [[nodiscard]] int bucket_of(std::uint32_t key) const;
+
+public:
+    static constexpr bool monotone_only = true;
+
+    void reset(int vertices, int max_weight);
+    void push(int key, int vertex);
+    [[nodiscard]] bool empty() const { return _count == 0; }
+    std::pair<int, int> pop();
+};
+
+/**
+ * @class IndexedDaryHeapQueue
+ * @brief Indexed d-ary min-heap with decrease-key.
+ *
+ * Tracks the heap position of every vertex, so pushing a vertex that is already queued lowers
+ * its key in place instead of adding a duplicate; pop() never returns stale entries. A larger
+ * arity makes the tree shallower, trading cheaper decrease-key for costlier pops.
+ *
+ * @tparam D Number of children per node (at least 2)
+ * @tparam Key Key type
+ * @tparam Vertex Vertex id type
+ */
+template<int D = 4, typename Key = int, typename Vertex = int>
+class IndexedDaryHeapQueue {
+    static_assert(D >= 2, "A d-ary heap needs at least two children per node");
+
+private:
+    static constexpr Vertex absent = static_cast<Vertex>(-1);
+
+    std::vector<std::pair<Key, Vertex>> _heap; ///< (key, vertex) entries in heap order
+    std::vector<Vertex> _position;             ///< Heap index of each vertex, absent if not queued
+
+    void place(std::size_t index, std::pair<Key, Vertex> entry) {
+        _heap[index] = entry;
+        _position[entry.second] = static_cast<Vertex>(index);
+    }
+
+    void sift_up(std::size_t index) {
+        std::pair<Key, Vertex> entry = _heap[index];
+        while (index > 0) {
+            std::size_t parent = (index - 1) / D;
+            if (_heap[parent].first <= entry.first) break;
+            place(index, _heap[parent]);
+            index = parent;
+        }
+        place(index, entry);
+    }
+
+    void sift_down(std::size_t index) {
+        std::pair<Key, Vertex> entry = _heap[index];
+        while (true) {
+            std::size_t first = index * D + 1;
+            if (first >= _heap.size()) break;
+            std::size_t last = std::min(first + D, _heap.size());
+            std::size_t best = first;
+            for (std::size_t c = first + 1; c < last; ++c) {
+                if (_heap[c].first < _heap[best].first) best = c;
+            }
+            if (_heap[best].first >= entry.first) break;
+            place(index, _heap[best]);
+            index = best;
+        }
+        place(index, entry);
+    }
+
+public:
+    static constexpr bool monotone_only = false;
+
+    void reset(std::size_t vertices, int) {
+        _heap.clear();
+        _position.assign(vertices, absent);
+    }
+
+    void push(Key key, Vertex vertex) {
+        Vertex position = _position[vertex];
+        if (position == absent) {
+            _heap.emplace_back(key, vertex);
+            sift_up(_heap.size() - 1);
+        } else if (key < _heap[position].first) {
+            _heap[position].first = key;
+            sift_up(position);
+        }
+    }
+
+    [[nodiscard]] bool empty() const { return _heap.empty(); }
+
+    std::pair<Key, Vertex> pop() {
+        std::pair<Key, Vertex> top = _heap.front();
+        _position[top.second] = absent;
+        std::pair<Key, Vertex> last = _heap.back();
+        _heap.pop_back();
+        if (!_heap.empty()) {
+            _heap.front() = last;
+            sift_down(0);
+        }
+        return top;
+    }
+};
+
+#endif // PRIORITY_QUEUES_H
@@ -0,0 +1,151 @@
+#include "reorder.h"
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+namespace {
+
+/**
+ * @brief Breadth-first helper over out-arcs and, if given, in-arcs
+ */
+class Traversal {
+private:
+    const CsrAdjacency& _adjacency;
+    const CsrAdjacency* _reverse;
+    std::vector<int> _stamp;   ///< Sweep that last reached each vertex
+    int _sweep = 0;
+
+public:
+    Traversal(const CsrAdjacency& adjacency, const CsrAdjacency* reverse)
+        : _adjacency(adjacency), _reverse(reverse), _stamp(adjacency.size(), 0) {}
+
+    [[nodiscard]] int degree(int v) const {
+        return _adjacency.degree(v) + (_reverse ? _reverse->degree(v) : 0);
+    }
+
+    template<typename Fn>
+    void for_each_neighbour(int v, Fn&& fn) const {
+        for (int u : _adjacency.neighbours(v)) fn(u);
+        if (_reverse) {
+            for (int u : _reverse->neighbours(v)) fn(u);
+        }
+    }
+
+    /**
+     * @brief Sweep the component of start level by level
+     * @param start Starting vertex
+     * @param last_level Receives the vertices of the deepest level
+     * @return int Eccentricity of start
+     */
+    int levels(int start, std::vector<int>& last_level) {
+        ++_sweep;
+        std::vector<int> current = {start}, next;
+        _stamp[start] = _sweep;
+        int depth = 0;
+        while (true) {
+            next.clear();
+            for (int v : current) {
+                for_each_neighbour(v, [&](int u) {
+                    if (_stamp[u] != _sweep) {
+                        _stamp[u] = _sweep;
+                        next.push_back(u);
+                    }
+                });
+            }
+            if (next.empty()) break;
+            current.swap(next);
+            ++depth;
+        }
+        last_level = std::move(current);
+        return depth;
+    }
+
+    /**
+     * @brief Find a pseudo-peripheral vertex in the component of start (George–Liu)
+     * @param start Any vertex of the component
+     * @return int Vertex of (near) maximal eccentricity
+     */
+    int peripheral(int start) {
+        std::vector<int> last_level;
+        int root = start;
+        int eccentricity = levels(root, last_level);
+        while (true) {
+            int candidate = *std::ranges::min_element(last_level, {}, [&](int v) { return degree(v); });
+            int candidate_eccentricity = levels(candidate, last_level);
+            if (candidate_eccentricity <= eccentricity) return root;
+            root = candidate;
+            eccentricity = candidate_eccentricity;
+        }
+    }
+};
+
+std::vector<int> breadth_first_order(const CsrAdjacency& adjacency, const CsrAdjacency* reverse,
+                                     bool cuthill_mckee) {
+    const int n = adjacency.size();
+    Traversal traversal(adjacency, reverse);
+
+    std::vector<int> starts(n);
+    std::iota(starts.begin(), starts.end(), 0);
+    if (cuthill_mckee) {
+        std::ranges::stable_sort(starts, {}, [&](int v) { return traversal.degree(v); });
+    }
+
+    std::vector<int> order;
+    order.reserve(n);
+    std::vector<char> placed(n, 0);
+    std::vector<int> children;
+    for (int start : starts) {
+        if (placed[start]) continue;
+        int root = cuthill_mckee ? traversal.peripheral(start) : start;
+        std::size_t head = order.size();
+        order.push_back(root);
+        placed[root] = 1;
+        while (head < order.size()) {
+            int v = order[head++];
+            children.clear();
+            traversal.for_each_neighbour(v, [&](int u) {
+                if (!placed[u]) {
+                    placed[u] = 1;
+                    children.push_back(u);
+                }
+            });
+            if (cuthill_mckee) {
+                std::ranges::stable_sort(children, {}, [&](int u) { return traversal.degree(u); });
+            }
+            order.insert(order.end(), children.begin(), children.end());
+        }
+    }
+    if (cuthill_mckee) std::ranges::reverse(order);
+    return order;
+}
+
+} // namespace
+
+std::vector<int> vertex_permutation(const CsrAdjacency& adjacency, const CsrAdjacency* reverse,
+                                    VertexOrdering ordering) {
+    const int n = adjacency.size();
+    std::vector<int> order;
+    if (ordering == VertexOrdering::DegreeDescending) {
+        order.resize(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::ranges::stable_sort(order, std::greater<>(), [&](int v) {
+            return adjacency.degree(v) + (reverse ? reverse->degree(v) : 0);
+        });
+    } else {
+        order = breadth_first_order(adjacency, reverse, ordering == VertexOrdering::ReverseCuthillMcKee);
+    }
+
+    std::vector<int> new_id(n);
+    for (int i = 0; i < n; ++i) new_id[order[i]] = i;
+    return new_id;
+}
+
+bool is_permutation(std::span<const int> new_id, int size) {
+    if (new_id.size() != static_cast<std::size_t>(size)) return false;
+    std::vector<char> seen(size, 0);
+    for (int id : new_id) {
+        if (id < 0 || id >= size || seen[id]) return false;
+        seen[id] = 1;
+    }
+    return true;
+}
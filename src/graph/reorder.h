@@ -0,0 +1,44 @@
+#ifndef REORDER_H
+#define REORDER_H
+
+#include <vector>
+#include <span>
+#include "src/graph/csr.h"
+
+/**
+ * @brief Vertex layouts that place vertices visited together close to each other in memory
+ */
+enum class VertexOrdering {
+    ReverseCuthillMcKee, ///< Breadth-first by increasing degree, reversed; minimises bandwidth
+    DegreeDescending,    ///< Highest-degree vertices first, keeping hubs in a few cache lines
+    BreadthFirst         ///< Plain breadth-first visit order, component by component
+};
+
+/**
+ * @brief Compute a vertex permutation for the given layout
+ *
+ * Disconnected graphs are handled component by component. For directed graphs pass the
+ * transposed adjacency as well, so that arcs are followed in both directions; otherwise the
+ * searches only follow out-arcs.
+ *
+ * Reverse Cuthill–McKee starts every component at a pseudo-peripheral vertex found with the
+ * George–Liu heuristic (repeated breadth-first sweeps from a far, low-degree vertex).
+ *
+ * @param adjacency Out-arcs of the graph
+ * @param reverse In-arcs of the graph, or nullptr for symmetric adjacencies
+ * @param ordering Layout to compute
+ * @return std::vector<int> New id of every vertex (a permutation of 0 .. size() - 1), as
+ *         expected by CsrAdjacency::permuted()
+ */
+[[nodiscard]] std::vector<int> vertex_permutation(const CsrAdjacency& adjacency, const CsrAdjacency* reverse,
+                                                  VertexOrdering ordering);
+
+/**
+ * @brief Check whether a vector is a permutation of 0 .. size - 1
+ * @param new_id Candidate permutation
+ * @param size Number of vertices
+ * @return bool True if every id in [0, size) appears exactly once
+ */
+[[nodiscard]] bool is_permutation(std::span<const int> new_id, int size);
+
+#endif // REORDER_H
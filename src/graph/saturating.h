@@ -0,0 +1,31 @@
+#ifndef SATURATING_H
+#define SATURATING_H
+
+#include <limits>
+#include <type_traits>
+
+/**
+ * @brief Add two path lengths, clamping to the representable range instead of wrapping
+ *
+ * Shortest-path searches use the largest value of the distance type as "unreachable", so a
+ * path too long to represent saturates to it rather than overflowing into a small (or
+ * negative) distance that would be preferred over every real one. Floating-point values
+ * are added normally; they overflow to infinity on their own.
+ *
+ * @param a First operand
+ * @param b Second operand
+ * @return T a + b clamped to [lowest, max] of T
+ */
+template<typename T>
+constexpr T saturating_add(T a, T b) {
+    static_assert(std::is_arithmetic_v<T>, "saturating_add needs an arithmetic type");
+    if constexpr (std::is_floating_point_v<T>) {
+        return a + b;
+    } else {
+        T result;
+        if (!__builtin_add_overflow(a, b, &result)) return result;
+        return b > 0 ? std::numeric_limits<T>::max() : std::numeric_limits<T>::lowest();
+    }
+}
+
+#endif // SATURATING_H
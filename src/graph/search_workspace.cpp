@@ -0,0 +1,49 @@
+#include "search_workspace.h"
+#include <algorithm>
+
+namespace {
+
+thread_local bool shared_leased = false; ///< Whether this thread's shared workspace is in use
+
+} // namespace
+
+SearchWorkspace::Lease::Lease() {
+    thread_local SearchWorkspace shared;
+    if (shared_leased) {
+        _own = std::make_unique<SearchWorkspace>();
+        _workspace = _own.get();
+    } else {
+        shared_leased = true;
+        _workspace = &shared;
+    }
+}
+
+SearchWorkspace::Lease::~Lease() {
+    if (!_own) shared_leased = false;
+}
+
+SearchWorkspace::SearchWorkspace(int size) {
+    begin(size, -1);
+}
+
+void SearchWorkspace::begin(int size, int unreached) {
+    if (size > capacity()) {
+        _stamp.resize(size, 0);
+        _flag.resize(size, 0);
+        for (int side = 0; side < 2; ++side) {
+            _distance[side].resize(size);
+            _parent[side].resize(size);
+        }
+    }
+    if (++_generation == 0) {
+        // The counter wrapped around: clear stale stamps once every 2^32 searches.
+        std::fill(_stamp.begin(), _stamp.end(), 0);
+        std::fill(_flag.begin(), _flag.end(), 0);
+        _generation = 1;
+    }
+    _unreached = unreached;
+    _touched.clear();
+    _heap[0].clear();
+    _heap[1].clear();
+    _estimate_heap.clear();
+}
@@ -0,0 +1,163 @@
+#ifndef SEARCH_WORKSPACE_H
+#define SEARCH_WORKSPACE_H
+
+#include <vector>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <cstdint>
+#include <memory>
+
+class WeightedGraph;
+class UnweightedGraph;
+class ContractionHierarchy;
+
+/**
+ * @class SearchWorkspace
+ * @brief Reusable per-thread scratch memory for graph searches.
+ *
+ * Every search on a graph normally allocates distance, parent and visited arrays sized to
+ * the whole graph. A SearchWorkspace keeps those arrays alive between searches and marks
+ * each slot with the generation of the search that last wrote it, so starting a new search
+ * only bumps the generation: slots from older searches read as untouched. Reusing a
+ * workspace therefore costs O(touched vertices) instead of O(V).
+ *
+ * A workspace is not thread-safe; hold one per thread. It grows automatically to the size
+ * of the graph it is used with, so the same workspace can serve several graphs.
+ *
+ * After a search, distance(), parent() and touched() describe its result until the next
+ * search that uses the workspace begins.
+ *
+ * Queries called without a workspace borrow a per-thread one through a Lease, so they do
+ * not allocate O(V) arrays per call either.
+ *
+ * @note Vertices are zero-indexed.
+ */
+class SearchWorkspace {
+    friend class WeightedGraph;
+    friend class UnweightedGraph;
+    friend class ContractionHierarchy;
+
+private:
+    std::vector<std::uint32_t> _stamp; ///< Generation that last touched each vertex
+    std::vector<std::uint32_t> _flag;  ///< Generation that last flagged each vertex
+    std::vector<int> _distance[2];     ///< Distance (or discovery time) per search side
+    std::vector<int> _parent[2];       ///< Parent per search side
+    std::vector<int> _touched;         ///< Vertices touched by the current search, in order
+    std::uint32_t _generation = 0;     ///< Generation of the current search
+    int _unreached = -1;               ///< Distance reported for untouched vertices
+
+    std::vector<std::pair<int, int>> _heap[2];                   ///< Binary heaps for Dijkstra-style searches
+    std::vector<std::tuple<long long, int, int>> _estimate_heap; ///< Binary heap for A*
+
+public:
+    /**
+     * @class Lease
+     * @brief Borrows the calling thread's shared workspace for the duration of one query
+     *
+     * The shared workspace is created on the thread's first lease and kept, at the size of
+     * the largest graph searched, until the thread exits. If it is already leased (e.g. an
+     * A* heuristic runs a one-shot query itself), the nested lease gets a private workspace.
+     */
+    class Lease {
+    private:
+        std::unique_ptr<SearchWorkspace> _own; ///< Private fallback workspace (null when shared)
+        SearchWorkspace* _workspace;           ///< Workspace in use
+
+    public:
+        Lease();
+        ~Lease();
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        SearchWorkspace& operator*() const { return *_workspace; }
+    };
+
+    /**
+     * @brief Construct a workspace, optionally pre-sized for a graph
+     * @param size Number of vertices to reserve room for
+     */
+    explicit SearchWorkspace(int size = 0);
+
+    /**
+     * @brief Start a new search, invalidating the results of the previous one in O(1)
+     * @param size Number of vertices of the graph about to be searched
+     * @param unreached Distance reported for vertices the search does not touch
+     */
+    void begin(int size, int unreached);
+
+    /**
+     * @brief Check whether a vertex was touched by the current search
+     * @param v Vertex
+     * @return bool True if the current search assigned a label to v
+     */
+    [[nodiscard]] bool touched(int v) const { return _stamp[v] == _generation; }
+
+    /**
+     * @brief Get the distance of a vertex found by the current search
+     *
+     * For DFS searches this is the discovery time.
+     *
+     * @param v Vertex
+     * @return int Distance, or the search's unreached value if v was not touched
+     */
+    [[nodiscard]] int distance(int v) const { return touched(v) ? _distance[0][v] : _unreached; }
+
+    /**
+     * @brief Get the parent of a vertex in the tree built by the current search
+     * @param v Vertex
+     * @return int Parent vertex (-1 for the start vertex and untouched vertices)
+     */
+    [[nodiscard]] int parent(int v) const { return touched(v) ? _parent[0][v] : -1; }
+
+    /**
+     * @brief Get the vertices touched by the current search, in the order they were reached
+     * @return std::span<const int> Touched vertices
+     */
+    [[nodiscard]] std::span<const int> touched() const { return _touched; }
+
+    /**
+     * @brief Get the number of vertices the workspace currently has room for
+     * @return int Capacity in vertices
+     */
+    [[nodiscard]] int capacity() const { return static_cast<int>(_stamp.size()); }
+
+private:
+    /**
+     * @brief Label a vertex as touched by the current search, resetting both sides' slots
+     * @param v Vertex
+     */
+    void touch(int v) {
+        if (_stamp[v] != _generation) {
+            _stamp[v] = _generation;
+            _distance[0][v] = _distance[1][v] = _unreached;
+            _parent[0][v] = _parent[1][v] = -1;
+            _touched.push_back(v);
+        }
+    }
+
+    /**
+     * @brief Flag a vertex for the current search (e.g. a target not settled yet)
+     *
+     * Flags are independent of touch() and, like touched slots, read as cleared once the
+     * next search begins.
+     *
+     * @param v Vertex
+     */
+    void flag(int v) { _flag[v] = _generation; }
+
+    /**
+     * @brief Clear the flag of a vertex
+     * @param v Vertex
+     */
+    void unflag(int v) { _flag[v] = 0; }
+
+    /**
+     * @brief Check whether a vertex is flagged in the current search
+     * @param v Vertex
+     * @return bool True if flag(v) was called since the search began and not undone
+     */
+    [[nodiscard]] bool flagged(int v) const { return _flag[v] == _generation; }
+};
+
+#endif // SEARCH_WORKSPACE_H
@@ -0,0 +1,354 @@
+#include "strongly_connected.h"
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <utility>
+#include "src/graph/parallel.h"
+#include "src/graph/traversal.h"
+
+namespace {
+
+constexpr int unassigned = -1;
+
+/// Below this many remaining vertices the parallel phases stop and Tarjan finishes the work
+constexpr std::size_t sequential_cutoff = 4096;
+
+/**
+ * @brief View of an adjacency that hides vertices which already have a component
+ *
+ * Every vertex removed so far belongs to a complete component, so the remaining vertices
+ * induce a subgraph with exactly the components still to be found.
+ */
+class RemainingAdjacency {
+private:
+    const CsrAdjacency& _adjacency;
+    const std::vector<int>& _label;
+
+public:
+    class Cursor {
+    private:
+        const int* _next;
+        const int* _end;
+        const int* _label;
+
+    public:
+        Cursor(std::span<const int> row, const int* label)
+            : _next(row.data()), _end(row.data() + row.size()), _label(label) {}
+
+        bool next(int& u) {
+            while (_next != _end) {
+                int v = *_next++;
+                if (_label[v] == unassigned) {
+                    u = v;
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+
+    RemainingAdjacency(const CsrAdjacency& adjacency, const std::vector<int>& label)
+        : _adjacency(adjacency), _label(label) {}
+
+    [[nodiscard]] int size() const { return _adjacency.size(); }
+    [[nodiscard]] Cursor cursor(int v) const { return Cursor(_adjacency.neighbours(v), _label.data()); }
+};
+
+/**
+ * @brief Tarjan's low-link bookkeeping on top of DepthFirstEngine
+ *
+ * A vertex sits on Tarjan's stack exactly while it is discovered but has no label yet, so the
+ * labels double as the on-stack flags. Components are labelled in the order they complete,
+ * which is a reverse topological order of the condensation.
+ */
+class TarjanVisitor : public DepthFirstVisitor {
+private:
+    const std::vector<int>& _discovery;
+    std::vector<int>& _label;
+    int& _count;
+    std::vector<int> _low;
+    std::vector<int> _parent;
+    std::vector<int> _stack;
+
+public:
+    TarjanVisitor(const std::vector<int>& discovery, std::vector<int>& label, int& count)
+        : _discovery(discovery), _label(label), _count(count), _low(label.size()), _parent(label.size()) {}
+
+    void discover(int v, int parent) {
+        _low[v] = _discovery[v];
+        _parent[v] = parent;
+        _stack.push_back(v);
+    }
+
+    void edge(int u, int v, int, EdgeClass kind) {
+        if (kind != EdgeClass::Tree && _label[v] == unassigned) {
+            _low[u] = std::min(_low[u], _discovery[v]);
+        }
+    }
+
+    void finish(int v) {
+        if (_low[v] == _discovery[v]) {
+            int id = _count++;
+            int w;
+            do {
+                w = _stack.back();
+                _stack.pop_back();
+                _label[w] = id;
+            } while (w != v);
+        }
+        if (_parent[v] != -1) {
+            _low[_parent[v]] = std::min(_low[_parent[v]], _low[v]);
+        }
+    }
+};
+
+/**
+ * @brief Label the components of all unassigned vertices reachable from roots with Tarjan
+ */
+void tarjan_remaining(const CsrAdjacency& adjacency, std::span<const int> roots,
+                      std::vector<int>& label, int& count) {
+    RemainingAdjacency remaining(adjacency, label);
+    DepthFirstEngine<RemainingAdjacency> engine(remaining);
+    TarjanVisitor visitor(engine.discovery(), label, count);
+    for (int root : roots) {
+        if (label[root] == unassigned) engine.visit(root, visitor);
+    }
+}
+
+/**
+ * @brief Atomically replace slot's value with desired if it equals expected
+ */
+bool claim(int& slot, int expected, int desired) {
+    std::atomic_ref<int> target(slot);
+    return target.load(std::memory_order_relaxed) == expected &&
+           target.compare_exchange_strong(expected, desired, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Atomically raise slot to value; returns whether the slot changed
+ */
+bool raise(int& slot, int value) {
+    std::atomic_ref<int> target(slot);
+    int current = target.load(std::memory_order_relaxed);
+    while (current < value) {
+        if (target.compare_exchange_weak(current, value, std::memory_order_relaxed)) return true;
+    }
+    return false;
+}
+
+void concatenate(std::vector<std::vector<int>>& local, int used, std::vector<int>& out) {
+    out.clear();
+    for (int t = 0; t < used; ++t) out.insert(out.end(), local[t].begin(), local[t].end());
+}
+
+/**
+ * @brief Level-synchronous parallel search; expand(u, next) pushes the vertices it claims
+ */
+template<typename Expand>
+void parallel_search(std::vector<int> frontier, int threads, std::vector<std::vector<int>>& local,
+                     Expand&& expand) {
+    while (!frontier.empty()) {
+        int used = parallel_for(0, static_cast<int>(frontier.size()), threads, [&](int worker, int lo, int hi) {
+            std::vector<int>& next = local[worker];
+            next.clear();
+            for (int i = lo; i < hi; ++i) expand(frontier[i], next);
+        }, 256);
+        concatenate(local, used, frontier);
+    }
+}
+
+/**
+ * @brief Renumber component labels into a topological order of the condensation
+ */
+void order_components(const CsrAdjacency& adjacency, std::vector<int>& label, int count, int threads) {
+    std::vector<int> order = kahn_topological_order(condensation(adjacency, label, count, threads));
+    std::vector<int> rank(count);
+    for (int i = 0; i < count; ++i) rank[order[i]] = i;
+    parallel_for(0, adjacency.size(), threads, [&](int, int lo, int hi) {
+        for (int v = lo; v < hi; ++v) label[v] = rank[label[v]];
+    });
+}
+
+} // namespace
+
+StronglyConnectedComponents tarjan_components(const CsrAdjacency& adjacency) {
+    StronglyConnectedComponents result;
+    result.component.assign(adjacency.size(), unassigned);
+    std::vector<int> roots(adjacency.size());
+    std::iota(roots.begin(), roots.end(), 0);
+    tarjan_remaining(adjacency, roots, result.component, result.count);
+
+    // Tarjan completes sink components first.
+    for (int& c : result.component) c = result.count - 1 - c;
+    return result;
+}
+
+StronglyConnectedComponents forward_backward_components(const CsrAdjacency& adjacency,
+                                                        const CsrAdjacency& reverse, int threads) {
+    threads = resolve_thread_count(threads);
+    const int n = adjacency.size();
+    std::vector<int> label(n, unassigned);
+    int count = 0;
+    std::vector<std::vector<int>> local(threads);
+
+    std::vector<int> active(n);
+    std::iota(active.begin(), active.end(), 0);
+
+    // Drop the vertices that received a label, keeping the order of the rest.
+    auto compact = [&] {
+        int used = parallel_for(0, static_cast<int>(active.size()), threads, [&](int worker, int lo, int hi) {
+            local[worker].clear();
+            for (int i = lo; i < hi; ++i) {
+                if (label[active[i]] == unassigned) local[worker].push_back(active[i]);
+            }
+        });
+        concatenate(local, used, active);
+    };
+
+    // Vertices are trimmed from the labels of the previous round, so decisions never race.
+    auto trim = [&] {
+        while (!active.empty()) {
+            int used = parallel_for(0, static_cast<int>(active.size()), threads, [&](int worker, int lo, int hi) {
+                local[worker].clear();
+                for (int i = lo; i < hi; ++i) {
+                    int v = active[i];
+                    auto live = [&](int u) { return u != v && label[u] == unassigned; };
+                    if (std::ranges::none_of(adjacency.neighbours(v), live) ||
+                        std::ranges::none_of(reverse.neighbours(v), live)) {
+                        local[worker].push_back(v);
+                    }
+                }
+            });
+            std::size_t before = active.size(), removed = 0;
+            for (int t = 0; t < used; ++t) {
+                for (int v : local[t]) label[v] = count++;
+                removed += local[t].size();
+            }
+            if (removed == 0) break;
+            compact();
+            if (removed * 100 < before) break;
+        }
+    };
+
+    // 1 + 2. Trim, then peel off the component of the vertex with the largest in * out degree.
+    trim();
+    if (!active.empty()) {
+        std::vector<std::pair<long long, int>> best(threads, {-1, -1});
+        int used = parallel_for(0, static_cast<int>(active.size()), threads, [&](int worker, int lo, int hi) {
+            for (int i = lo; i < hi; ++i) {
+                int v = active[i];
+                long long score = static_cast<long long>(adjacency.degree(v)) * reverse.degree(v);
+                if (score > best[worker].first) best[worker] = {score, v};
+            }
+        });
+        int pivot = std::max_element(best.begin(), best.begin() + used)->second;
+
+        std::vector<int> reached(n, 0);
+        reached[pivot] = 1;
+        parallel_search({pivot}, threads, local, [&](int u, std::vector<int>& next) {
+            for (int v : adjacency.neighbours(u)) {
+                if (label[v] == unassigned && claim(reached[v], 0, 1)) next.push_back(v);
+            }
+        });
+
+        int id = count++;
+        label[pivot] = id;
+        parallel_search({pivot}, threads, local, [&](int u, std::vector<int>& next) {
+            for (int v : reverse.neighbours(u)) {
+                if (reached[v] && claim(label[v], unassigned, id)) next.push_back(v);
+            }
+        });
+        compact();
+    }
+
+    // 3. Colouring rounds.
+    std::vector<int> colour(n), queued(n, 0), frontier, roots;
+    while (active.size() > sequential_cutoff) {
+        trim();
+        std::size_t before = active.size();
+        if (before <= sequential_cutoff) break;
+
+        // Propagate the largest id forwards. Flags are cleared before each round, so a vertex
+        // raised while or after being expanded is queued again exactly once.
+        frontier = active;
+        for (int v : active) colour[v] = v;
+        while (!frontier.empty()) {
+            parallel_for(0, static_cast<int>(frontier.size()), threads, [&](int, int lo, int hi) {
+                for (int i = lo; i < hi; ++i) queued[frontier[i]] = 0;
+            });
+            int used = parallel_for(0, static_cast<int>(frontier.size()), threads, [&](int worker, int lo, int hi) {
+                std::vector<int>& next = local[worker];
+                next.clear();
+                for (int i = lo; i < hi; ++i) {
+                    int u = frontier[i];
+                    int c = std::atomic_ref<int>(colour[u]).load(std::memory_order_relaxed);
+                    for (int v : adjacency.neighbours(u)) {
+                        if (label[v] == unassigned && raise(colour[v], c) && claim(queued[v], 0, 1)) {
+                            next.push_back(v);
+                        }
+                    }
+                }
+            }, 256);
+            concatenate(local, used, frontier);
+        }
+
+        // Each vertex that kept its own colour roots the component of the vertices of that
+        // colour which reach it.
+        int used = parallel_for(0, static_cast<int>(active.size()), threads, [&](int worker, int lo, int hi) {
+            local[worker].clear();
+            for (int i = lo; i < hi; ++i) {
+                if (colour[active[i]] == active[i]) local[worker].push_back(active[i]);
+            }
+        });
+        concatenate(local, used, roots);
+        for (int r : roots) label[r] = count++;
+        parallel_search(roots, threads, local, [&](int u, std::vector<int>& next) {
+            int c = colour[u], id = label[u];
+            for (int v : reverse.neighbours(u)) {
+                if (colour[v] == c && claim(label[v], unassigned, id)) next.push_back(v);
+            }
+        });
+
+        compact();
+        if ((before - active.size()) * 100 < before) break;
+    }
+
+    tarjan_remaining(adjacency, active, label, count);
+    order_components(adjacency, label, count, threads);
+    return {count, std::move(label)};
+}
+
+CsrAdjacency condensation(const CsrAdjacency& adjacency, std::span<const int> component, int count, int threads) {
+    threads = resolve_thread_count(threads);
+    const int n = adjacency.size();
+
+    // Group the vertices by component.
+    std::vector<int> first(count + 1, 0), members(n);
+    for (int v = 0; v < n; ++v) first[component[v] + 1]++;
+    std::partial_sum(first.begin(), first.end(), first.begin());
+    std::vector<int> fill(first.begin(), first.end() - 1);
+    for (int v = 0; v < n; ++v) members[fill[component[v]]++] = v;
+
+    // Workers own contiguous ranges of components, so their arcs concatenate in row order.
+    std::vector<std::vector<int>> from(threads), to(threads);
+    int used = parallel_for(0, count, threads, [&](int worker, int lo, int hi) {
+        std::vector<int> row;
+        for (int c = lo; c < hi; ++c) {
+            row.clear();
+            for (int i = first[c]; i < first[c + 1]; ++i) {
+                for (int u : adjacency.neighbours(members[i])) {
+                    if (component[u] != c) row.push_back(component[u]);
+                }
+            }
+            std::sort(row.begin(), row.end());
+            row.erase(std::unique(row.begin(), row.end()), row.end());
+            from[worker].insert(from[worker].end(), row.size(), c);
+            to[worker].insert(to[worker].end(), row.begin(), row.end());
+        }
+    }, 64);
+
+    std::vector<int> all_from, all_to;
+    concatenate(from, used, all_from);
+    concatenate(to, used, all_to);
+    return CsrAdjacency::build(count, false, all_from, all_to, {}, false, threads);
+}
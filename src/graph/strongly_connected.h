@@ -0,0 +1,76 @@
+#ifndef STRONGLY_CONNECTED_H
+#define STRONGLY_CONNECTED_H
+
+#include <vector>
+#include <span>
+#include "src/graph/csr.h"
+
+/**
+ * @struct StronglyConnectedComponents
+ * @brief Strongly connected component label of every vertex.
+ *
+ * Components are numbered 0 .. count - 1 in a topological order of the condensation: for
+ * every arc u -> v, component[u] <= component[v]. Sorting vertices by label therefore yields
+ * a topological order of a cyclic graph in which each strongly connected component is kept
+ * together.
+ */
+struct StronglyConnectedComponents {
+    int count = 0;              ///< Number of components
+    std::vector<int> component; ///< Component label of each vertex
+};
+
+/**
+ * @brief Find strongly connected components with Tarjan's algorithm
+ *
+ * Runs on the explicit-stack DepthFirstEngine, so arbitrarily deep graphs are handled
+ * without recursion. O(V + E) time, single-threaded.
+ *
+ * @param adjacency Graph adjacency
+ * @return StronglyConnectedComponents Labels in topological order of the condensation
+ */
+[[nodiscard]] StronglyConnectedComponents tarjan_components(const CsrAdjacency& adjacency);
+
+/**
+ * @brief Find strongly connected components with parallel trimming, forward-backward search
+ *        and colouring
+ *
+ * Follows the Multistep scheme:
+ *  1. Trim: vertices without remaining in- or out-arcs are singleton components; repeated
+ *     while a round still removes a noticeable share of the vertices.
+ *  2. Forward-backward: the component of a high-degree pivot (usually the giant component)
+ *     is the set of vertices reachable from it that also reach it, found with two parallel
+ *     level-synchronous searches.
+ *  3. Colouring: every remaining vertex takes the largest id that reaches it, propagated in
+ *     parallel until stable; each vertex whose colour is its own id roots the component
+ *     formed by the vertices of its colour that reach it, collected by a parallel backward
+ *     search. Steps 1 and 3 repeat on what is left.
+ *
+ * When a round makes too little progress (long chains of small components) the remaining
+ * vertices are finished by Tarjan's algorithm. The result is then renumbered into a
+ * topological order of the condensation, so it has the same form as tarjan_components().
+ *
+ * @param adjacency Graph adjacency
+ * @param reverse Reverse adjacency of the same graph
+ * @param threads Number of worker threads (non-positive selects hardware concurrency)
+ * @return StronglyConnectedComponents Labels in topological order of the condensation
+ */
+[[nodiscard]] StronglyConnectedComponents forward_backward_components(const CsrAdjacency& adjacency,
+                                                                      const CsrAdjacency& reverse,
+                                                                      int threads = 0);
+
+/**
+ * @brief Build the condensation of a graph: one vertex per component, one arc per pair of
+ *        components joined by at least one arc
+ *
+ * Rows are sorted and free of duplicates and self-loops.
+ *
+ * @param adjacency Graph adjacency
+ * @param component Component label of each vertex, in 0 .. count - 1
+ * @param count Number of components
+ * @param threads Number of worker threads (non-positive selects hardware concurrency)
+ * @return CsrAdjacency Adjacency of the condensation
+ */
+[[nodiscard]] CsrAdjacency condensation(const CsrAdjacency& adjacency, std::span<const int> component,
+                                        int count, int threads = 0);
+
+#endif // STRONGLY_CONNECTED_H
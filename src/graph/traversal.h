@@ -0,0 +1,328 @@
+#ifndef TRAVERSAL_H
+#define TRAVERSAL_H
+
+#include <vector>
+#include <span>
+#include <concepts>
+#include <type_traits>
+#include <queue>
+#include <cstdint>
+#include <utility>
+
+/**
+ * @brief Traversals shared by the unweighted graph representations
+ *
+ * Each template works on any adjacency that offers size() and for_each_neighbour(v, fn) (and
+ * cursor(v) for depth-first search), such as CsrAdjacency and CompressedAdjacency, so the
+ * plain and the compressed graph run exactly the same algorithm. Neighbours are visited in
+ * the order the adjacency yields them. Callers validate the start vertex.
+ */
+
+/**
+ * @brief Breadth-first search tree from a start vertex
+ * @param adjacency Graph adjacency
+ * @param start Starting vertex
+ * @return std::pair<std::vector<int>, std::vector<int>>
+ *         First: parent of each vertex (-1 for the start and unreachable vertices)
+ *         Second: distance from start (-1 for unreachable vertices)
+ */
+template<typename Adjacency>
+std::pair<std::vector<int>, std::vector<int>> breadth_first_tree(const Adjacency& adjacency, int start) {
+    const int n = adjacency.size();
+    std::vector<int> parent(n, -1), distance(n, -1);
+    std::queue<int> q;
+    q.push(start);
+    distance[start] = 0;
+
+    while (!q.empty()) {
+        int curr = q.front();
+        q.pop();
+        adjacency.for_each_neighbour(curr, [&](int neighbour) {
+            if (distance[neighbour] == -1) {
+                distance[neighbour] = distance[curr] + 1;
+                parent[neighbour] = curr;
+                q.push(neighbour);
+            }
+        });
+    }
+    return {parent, distance};
+}
+
+/**
+ * @brief Kind of an arc u -> v in a depth-first forest
+ */
+enum class EdgeClass : std::uint8_t {
+    Tree,    ///< v was discovered through this arc
+    Back,    ///< v is an ancestor of u (still on the stack); the graph has a cycle
+    Forward, ///< v is a proper descendant of u reached earlier through another path
+    Cross    ///< v lies in a finished, unrelated subtree
+};
+
+/**
+ * @struct DepthFirstVisitor
+ * @brief No-op callbacks for DepthFirstEngine; derive from it and hide what you need
+ */
+struct DepthFirstVisitor {
+    void discover(int, int) {}               ///< discover(v, parent), parent -1 for roots
+    void edge(int, int, int, EdgeClass) {}   ///< edge(u, v, index of the arc in u's row, kind)
+    void finish(int) {}                      ///< finish(v) after all arcs of v are examined
+};
+
+/**
+ * @brief Visitor that keeps the discovery state itself and only needs the search tree
+ *
+ * try_discover(v, parent) returns false if v was already discovered and otherwise records
+ * it. DepthFirstEngine then keeps no rank arrays, does not classify arcs and never calls
+ * discover() or edge(); finish() is still called.
+ */
+template<typename Visitor>
+concept DepthFirstTreeVisitor = requires(Visitor& visitor, int v) {
+    { visitor.try_discover(v, v) } -> std::same_as<bool>;
+};
+
+/**
+ * @class DepthFirstEngine
+ * @brief Explicit-stack depth-first search with discovery/finish ranks and edge classes.
+ *
+ * Every stack frame holds a vertex together with its position in the vertex's row, so each
+ * vertex is pushed exactly once, the stack never holds more than V frames and no depth of
+ * graph can overflow the call stack. Vertices are discovered and arcs examined in exactly the
+ * order of a recursive DFS. With flat CSR arrays the position is the index of the next arc, so
+ * a frame is two ints; other adjacencies keep a cursor into the row.
+ *
+ * Discovery and finish times are preorder and postorder ranks (0, 1, 2, ...), which is
+ * enough to classify arcs: u -> v is a back arc if v is discovered but not finished, a
+ * forward arc if v finished and was discovered after u, and a cross arc otherwise.
+ *
+ * The engine keeps its state between calls to visit(), so a whole forest can be built by
+ * visiting several roots; vertices already discovered are skipped.
+ *
+ * Searches that only need the tree pass a DepthFirstTreeVisitor. The same loop then compiles
+ * down to the frame stack and the visitor's discovery test, without rank arrays or arc classes.
+ *
+ * @tparam Adjacency CsrAdjacency or CompressedAdjacency (anything with size() and cursor(v))
+ */
+template<typename Adjacency>
+class DepthFirstEngine {
+private:
+    static constexpr bool flat = requires(const Adjacency& adjacency) {
+        adjacency.offsets();
+        adjacency.targets();
+    };
+
+    struct NoCursor {};
+
+    struct Frame {
+        int vertex;
+        int arc; ///< Next arc: index in the targets array if flat, else index in the row
+        [[no_unique_address]] std::conditional_t<flat, NoCursor, typename Adjacency::Cursor> cursor;
+    };
+
+    const Adjacency& _adjacency;
+    std::span<const int> _offsets, _targets; ///< Flat CSR arrays, empty for other adjacencies
+    std::vector<int> _discovery; ///< Preorder rank of each vertex, -1 if undiscovered
+    std::vector<int> _finish;    ///< Postorder rank of each vertex, -1 if unfinished
+    std::vector<Frame> _stack;
+    int _discovered = 0;
+    int _finished = 0;
+
+    /**
+     * @brief Mark v discovered from parent, unless it already is
+     * @return bool True if v was newly discovered
+     */
+    template<typename Visitor>
+    bool discover(int v, int parent, Visitor& visitor) {
+        if constexpr (DepthFirstTreeVisitor<Visitor>) {
+            return visitor.try_discover(v, parent);
+        } else {
+            if (_discovery[v] != -1) return false;
+            _discovery[v] = _discovered++;
+            visitor.discover(v, parent);
+            return true;
+        }
+    }
+
+    /**
+     * @brief Push a frame positioned before the first arc of v
+     */
+    void push(int v) {
+        if constexpr (flat) {
+            _stack.push_back({v, _offsets[v], {}});
+        } else {
+            _stack.push_back({v, 0, _adjacency.cursor(v)});
+        }
+    }
+
+    /**
+     * @brief Advance a frame to its next arc
+     * @param frame Frame to advance
+     * @param v Receives the head of the arc
+     * @return bool False once the row is exhausted
+     */
+    bool next(Frame& frame, int& v) {
+        if constexpr (flat) {
+            if (frame.arc == _offsets[frame.vertex + 1]) return false;
+            v = _targets[frame.arc++];
+            return true;
+        } else {
+            if (!frame.cursor.next(v)) return false;
+            ++frame.arc;
+            return true;
+        }
+    }
+
+    /**
+     * @brief Get the index in its row of the arc next() returned last
+     */
+    int last_arc(const Frame& frame) const {
+        if constexpr (flat) {
+            return frame.arc - 1 - _offsets[frame.vertex];
+        } else {
+            return frame.arc - 1;
+        }
+    }
+
+public:
+    /**
+     * @brief Prepare a search; rank arrays are allocated on the first visit that needs them
+     * @param adjacency Graph adjacency
+     */
+    explicit DepthFirstEngine(const Adjacency& adjacency) : _adjacency(adjacency) {
+        if constexpr (flat) {
+            _offsets = adjacency.offsets();
+            _targets = adjacency.targets();
+        }
+    }
+
+    /**
+     * @brief Run the search from root, unless root has already been discovered
+     * @param root Starting vertex
+     * @param visitor Callbacks (see DepthFirstVisitor and DepthFirstTreeVisitor)
+     */
+    template<typename Visitor>
+    void visit(int root, Visitor& visitor) {
+        constexpr bool classify = !DepthFirstTreeVisitor<Visitor>;
+        if constexpr (classify) {
+            if (_discovery.empty()) {
+                _discovery.assign(_adjacency.size(), -1);
+                _finish.assign(_adjacency.size(), -1);
+            }
+        }
+        if (!discover(root, -1, visitor)) return;
+        push(root);
+
+        while (!_stack.empty()) {
+            Frame& frame = _stack.back();
+            int u = frame.vertex, v;
+            if (!next(frame, v)) {
+                if constexpr (classify) _finish[u] = _finished++;
+                visitor.finish(u);
+                _stack.pop_back();
+                continue;
+            }
+
+            int arc = 0;
+            if constexpr (classify) arc = last_arc(frame);
+            if (discover(v, u, visitor)) {
+                if constexpr (classify) visitor.edge(u, v, arc, EdgeClass::Tree);
+                push(v); // invalidates frame
+            } else if constexpr (classify) {
+                if (_finish[v] == -1) {
+                    visitor.edge(u, v, arc, EdgeClass::Back);
+                } else if (_discovery[u] < _discovery[v]) {
+                    visitor.edge(u, v, arc, EdgeClass::Forward);
+                } else {
+                    visitor.edge(u, v, arc, EdgeClass::Cross);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Visit every vertex, starting new trees at undiscovered vertices in increasing order
+     * @param visitor Callbacks (see DepthFirstVisitor)
+     */
+    template<typename Visitor>
+    void visit_all(Visitor& visitor) {
+        for (int v = 0; v < _adjacency.size(); ++v) visit(v, visitor);
+    }
+
+    /**
+     * @brief Get the discovery (preorder) ranks
+     *
+     * Filled by visits with a classifying visitor; empty before the first one.
+     *
+     * @return const std::vector<int>& Rank of each vertex, -1 if undiscovered
+     */
+    [[nodiscard]] const std::vector<int>& discovery() const { return _discovery; }
+
+    /**
+     * @brief Get the finish (postorder) ranks
+     * @return const std::vector<int>& Rank of each vertex, -1 if unfinished
+     */
+    [[nodiscard]] const std::vector<int>& finish() const { return _finish; }
+};
+
+/**
+ * @brief Iterative depth-first search tree from a start vertex
+ * @param adjacency Graph adjacency
+ * @param start Starting vertex
+ * @return std::pair<std::vector<int>, std::vector<int>>
+ *         First: parent of each vertex (-1 for the start and unreachable vertices)
+ *         Second: discovery time of each vertex (-1 for unreachable vertices)
+ */
+template<typename Adjacency>
+std::pair<std::vector<int>, std::vector<int>> depth_first_tree(const Adjacency& adjacency, int start) {
+    struct TreeVisitor : DepthFirstVisitor {
+        std::vector<int> parent, discovery;
+        int time = 0;
+
+        bool try_discover(int v, int p) {
+            if (discovery[v] != -1) return false;
+            discovery[v] = time++;
+            parent[v] = p;
+            return true;
+        }
+    } visitor;
+    visitor.parent.assign(adjacency.size(), -1);
+    visitor.discovery.assign(adjacency.size(), -1);
+
+    DepthFirstEngine<Adjacency> engine(adjacency);
+    engine.visit(start, visitor);
+    return {std::move(visitor.parent), std::move(visitor.discovery)};
+}
+
+/**
+ * @brief Topological order with Kahn's algorithm
+ * @param adjacency Graph adjacency
+ * @return std::vector<int> Vertices in topological order (empty if the graph has a cycle)
+ */
+template<typename Adjacency>
+std::vector<int> kahn_topological_order(const Adjacency& adjacency) {
+    const int n = adjacency.size();
+    std::vector<int> in_degree(n, 0);
+    for (int v = 0; v < n; ++v) {
+        adjacency.for_each_neighbour(v, [&](int u) { in_degree[u]++; });
+    }
+
+    std::queue<int> q;
+    for (int v = 0; v < n; ++v) {
+        if (in_degree[v] == 0) q.push(v);
+    }
+
+    std::vector<int> result;
+    result.reserve(n);
+    while (!q.empty()) {
+        int curr = q.front();
+        q.pop();
+        result.push_back(curr);
+        adjacency.for_each_neighbour(curr, [&](int u) {
+            if (--in_degree[u] == 0) q.push(u);
+        });
+    }
+
+    if (static_cast<int>(result.size()) == n) return result;
+    return {};
+}
+
+#endif // TRAVERSAL_H
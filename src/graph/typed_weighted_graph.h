@@ -0,0 +1,233 @@
+#ifndef TYPED_WEIGHTED_GRAPH_H
+#define TYPED_WEIGHTED_GRAPH_H
+
+#include <vector>
+#include <algorithm>
+#include <span>
+#include <limits>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include "src/graph/csr.h"
+#include "src/graph/priority_queues.h"
+#include "src/graph/weighted_search.h"
+
+/**
+ * @class TypedWeightedGraph
+ * @brief Undirected weighted graph with configurable vertex-index and weight types.
+ *
+ * WeightedGraph stores int ids and int weights and keeps int distances. This variant stores
+ * its CSR arrays with the chosen types (see TypedCsrAdjacency), so narrow weights (e.g. std::uint16_t) shrink the
+ * adjacency and more of it stays in cache, while 64-bit indices allow graphs with more than
+ * 2^31 arcs. Distances are accumulated in a wider type (std::uint64_t for integer weights,
+ * double for floating-point weights) with saturating addition, so long paths never wrap
+ * around; a path too long even for that type is reported as unreachable.
+ *
+ * Dijkstra and Prim are the templates WeightedGraph uses (see weighted_search.h); they pick
+ * their priority queue at compile time: Dial's bucket queue for
+ * weights of at most 16 bits (at most 65536 buckets), otherwise a 4-ary indexed heap. Other
+ * queues from priority_queues.h that accept the distance and index types can be passed
+ * explicitly.
+ *
+ * Edges added with add_edge() are staged and merged into the CSR arrays by finalize();
+ * algorithms finalize lazily on first use.
+ *
+ * @tparam Index Unsigned vertex-index type; also used for CSR offsets, so it must hold the
+ *               number of arcs (twice the number of edges)
+ * @tparam Weight Arithmetic weight type; weights must be non-negative
+ *
+ * @note Vertices are zero-indexed.
+ */
+template<typename Index = std::uint32_t, typename Weight = std::uint32_t>
+class TypedWeightedGraph {
+    static_assert(std::is_integral_v<Index> && std::is_unsigned_v<Index>, "Index must be an unsigned integer type");
+    static_assert(std::is_arithmetic_v<Weight> && !std::is_same_v<Weight, bool>, "Weight must be an arithmetic type");
+
+public:
+    using index_type = Index;
+    using weight_type = Weight;
+    using distance_type = std::conditional_t<std::is_floating_point_v<Weight>, double, std::uint64_t>;
+    using DefaultQueue = std::conditional_t<std::is_integral_v<Weight> && sizeof(Weight) <= 2,
+                                            BasicDialBucketQueue<distance_type, Index>,
+                                            IndexedDaryHeapQueue<4, distance_type, Index>>;
+
+    /// Distance reported for unreachable vertices
+    static constexpr distance_type unreachable = std::numeric_limits<distance_type>::max();
+
+    /**
+     * @struct Edge
+     * @brief Structure representing an edge in the graph
+     */
+    struct Edge {
+        Index u;  ///< Source vertex
+        Index v;  ///< Destination vertex
+        Weight w; ///< Weight of the edge
+    };
+
+private:
+    Index _size;                       ///< Number of vertices in the graph
+    Weight _max_weight = 0;            ///< Largest weight added so far
+    mutable TypedCsrAdjacency<Index, Weight> _csr; ///< Frozen CSR adjacency (both directions of every edge)
+    mutable std::vector<Edge> _pending;   ///< Edges added since the last finalize
+
+    /**
+     * @brief Get the CSR adjacency, merging staged edges first if necessary
+     * @return const TypedCsrAdjacency<Index, Weight>& Up-to-date adjacency
+     * @throw std::overflow_error if the number of arcs does not fit in Index
+     */
+    const TypedCsrAdjacency<Index, Weight>& adjacency() const;
+
+    /**
+     * @brief Largest weight as the int bound expected by Queue::reset()
+     * @return int Largest weight, clamped to int
+     */
+    [[nodiscard]] int queue_weight_bound() const {
+        return static_cast<int>(std::min<double>(static_cast<double>(_max_weight), std::numeric_limits<int>::max()));
+    }
+
+public:
+    /**
+     * @brief Construct a new TypedWeightedGraph object
+     * @param size Number of vertices in the graph
+     */
+    explicit TypedWeightedGraph(Index size) : _size(size), _csr(size) {}
+
+    /**
+     * @brief Add a weighted edge to the graph
+     * @param from Source vertex
+     * @param to Destination vertex
+     * @param weight Weight of the edge
+     * @throw std::out_of_range if either vertex is out of range
+     * @throw std::invalid_argument if the weight is negative or not a number
+     */
+    void add_edge(Index from, Index to, Weight weight);
+
+    /**
+     * @brief Merge all staged edges into the CSR adjacency and release the staging buffer
+     * @throw std::overflow_error if the number of arcs does not fit in Index
+     */
+    void finalize() {
+        adjacency();
+        _pending.shrink_to_fit();
+    }
+
+    /**
+     * @brief Check whether every added edge has been merged into the CSR adjacency
+     * @return bool True if no edges are staged
+     */
+    [[nodiscard]] bool is_finalized() const { return _pending.empty(); }
+
+    /**
+     * @brief Perform Dijkstra's algorithm to find shortest paths from a start vertex
+     * @param start Starting vertex
+     * @return std::vector<distance_type> Shortest distances from start (unreachable if none)
+     * @throw std::out_of_range if start vertex is out of range
+     */
+    [[nodiscard]] std::vector<distance_type> dijkstra(Index start) const { return dijkstra<DefaultQueue>(start); }
+
+    /**
+     * @brief Perform Dijkstra's algorithm with a chosen priority-queue policy
+     * @tparam Queue Priority-queue policy keyed by distance_type over Index vertices
+     * @param start Starting vertex
+     * @return std::vector<distance_type> Shortest distances from start (unreachable if none)
+     * @throw std::out_of_range if start vertex is out of range
+     */
+    template<typename Queue>
+    [[nodiscard]] std::vector<distance_type> dijkstra(Index start) const;
+
+    /**
+     * @brief Find Minimum Spanning Tree using Prim's algorithm
+     * @return std::vector<Edge> Edges in the MST (empty if the graph is disconnected)
+     */
+    [[nodiscard]] std::vector<Edge> prim_mst() const;
+
+    /**
+     * @brief Get the out-neighbours of a vertex
+     * @param v Vertex
+     * @return std::span<const Index> Contiguous view of the neighbour ids
+     */
+    [[nodiscard]] std::span<const Index> neighbours(Index v) const { return adjacency().neighbours(v); }
+
+    /**
+     * @brief Get the weights of the arcs leaving a vertex, parallel to neighbours(v)
+     * @param v Vertex
+     * @return std::span<const Weight> Contiguous view of the weights
+     */
+    [[nodiscard]] std::span<const Weight> neighbour_weights(Index v) const { return adjacency().weights(v); }
+
+    /**
+     * @brief Get the number of vertices
+     * @return Index Number of vertices
+     */
+    [[nodiscard]] Index size() const { return _size; }
+
+    /**
+     * @brief Get the number of edges, staged ones included
+     * @return std::size_t Number of edges
+     */
+    [[nodiscard]] std::size_t edge_count() const { return (_csr.arc_count() + 2 * _pending.size()) / 2; }
+
+    /**
+     * @brief Get the largest edge weight in the graph
+     * @return Weight Largest weight (0 for a graph without edges)
+     */
+    [[nodiscard]] Weight max_weight() const { return _max_weight; }
+
+    /**
+     * @brief Get the memory used by the CSR adjacency
+     * @return std::size_t Size of the offset, target and weight arrays in bytes
+     */
+    [[nodiscard]] std::size_t adjacency_bytes() const { return adjacency().byte_size(); }
+};
+
+template<typename Index, typename Weight>
+void TypedWeightedGraph<Index, Weight>::add_edge(Index from, Index to, Weight weight) {
+    if (from >= _size || to >= _size) {
+        throw std::out_of_range("Vertex index out of range");
+    }
+    if constexpr (std::is_floating_point_v<Weight>) {
+        if (std::isnan(weight)) throw std::invalid_argument("Edge weight cannot be NaN");
+    }
+    if (weight < 0) {
+        throw std::invalid_argument("Edge weight cannot be negative");
+    }
+    _pending.push_back({from, to, weight});
+    if (weight > _max_weight) _max_weight = weight;
+}
+
+template<typename Index, typename Weight>
+const TypedCsrAdjacency<Index, Weight>& TypedWeightedGraph<Index, Weight>::adjacency() const {
+    if (!_pending.empty()) {
+        _csr.append(2 * _pending.size(), [&](auto&& fn) {
+            for (const Edge& e : _pending) {
+                fn(e.u, e.v, e.w);
+                fn(e.v, e.u, e.w);
+            }
+        });
+        _pending.clear();
+    }
+    return _csr;
+}
+
+template<typename Index, typename Weight>
+template<typename Queue>
+std::vector<typename TypedWeightedGraph<Index, Weight>::distance_type>
+TypedWeightedGraph<Index, Weight>::dijkstra(Index start) const {
+    if (start >= _size) {
+        throw std::out_of_range("Start vertex index out of range");
+    }
+    return dijkstra_distances<distance_type, Queue>(adjacency(), start, queue_weight_bound());
+}
+
+template<typename Index, typename Weight>
+std::vector<typename TypedWeightedGraph<Index, Weight>::Edge> TypedWeightedGraph<Index, Weight>::prim_mst() const {
+    std::vector<Edge> mst;
+    prim_tree<distance_type, DefaultQueue>(adjacency(), queue_weight_bound(), [&](Index parent, Index u, Weight weight) {
+        mst.push_back({parent, u, weight});
+    });
+    return mst.size() == static_cast<std::size_t>(_size) - 1 ? mst : std::vector<Edge>();
+}
+
+#endif // TYPED_WEIGHTED_GRAPH_H
@@ -2,121 +2,423 @@
 #include <queue>
 #include <stack>
 #include <stdexcept>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include "src/graph/parallel.h"
+#include "src/graph/graph_file.h"
+#include "src/graph/traversal.h"
 
-UnweightedGraph::UnweightedGraph(int size) : _size(size), _adjacency_list(size) {}
+UnweightedGraph::UnweightedGraph(int size) : _size(size), _csr(size, false) {}
+
+UnweightedGraph::UnweightedGraph(CsrAdjacency csr) : _size(csr.size()), _csr(std::move(csr)) {}
 
 void UnweightedGraph::add_edge(int from, int to) {
     if (from < 0 || from >= _size || to < 0 || to >= _size) {
         throw std::out_of_range("Vertex index out of range");
     }
-    _adjacency_list[from].push_back(to);
+    if (!_csr.try_push(from, to, 0)) _pending.emplace_back(from, to, 0);
+}
+
+void UnweightedGraph::add_edges(std::span<const std::pair<int, int>> edges, int threads) {
+    threads = resolve_thread_count(threads);
+    int count = static_cast<int>(edges.size());
+    std::vector<char> bad_vertex(threads, 0);
+
+    parallel_for(0, count, threads, [&](int worker, int lo, int hi) {
+        for (int i = lo; i < hi; ++i) {
+            auto [u, v] = edges[i];
+            if (u < 0 || u >= _size || v < 0 || v >= _size) bad_vertex[worker] = 1;
+        }
+    }, 1 << 14);
+
+    if (std::ranges::find(bad_vertex, 1) != bad_vertex.end()) {
+        throw std::out_of_range("Vertex index out of range");
+    }
+    if (count == 0) return;
+
+    adjacency();
+    _csr.append_edges(edges.size(), [edges](std::size_t e) {
+        return CsrAdjacency::Arc(edges[e].first, edges[e].second, 0);
+    }, false, threads);
+    _reverse.invalidate();
+}
+
+void UnweightedGraph::reserve_edges(std::size_t edges) {
+    _pending.reserve(_pending.size() + edges);
+}
+
+void UnweightedGraph::reserve_degrees(std::span<const int> degrees) {
+    if (degrees.size() != static_cast<std::size_t>(_size) || std::ranges::any_of(degrees, [](int d) { return d < 0; })) {
+        throw std::invalid_argument("Degree hints must hold one non-negative entry per vertex");
+    }
+    adjacency();
+    _csr.reserve(degrees);
+}
+
+void UnweightedGraph::finalize() {
+    adjacency();
+    _pending.shrink_to_fit();
+}
+
+void UnweightedGraph::save(const std::string& filename) const {
+    write_graph_file(filename, adjacency(), GraphFileKind::Directed, 0);
+}
+
+UnweightedGraph UnweightedGraph::load(const std::string& filename, bool verify) {
+    return UnweightedGraph(map_graph_file(filename, GraphFileKind::Directed, verify).first);
+}
+
+UnweightedGraph UnweightedGraph::from_edge_list(const std::string& filename, EdgeListFormat format,
+                                                int vertices, int threads) {
+    EdgeList edges = read_edge_list(filename, format, false, vertices, threads);
+    return UnweightedGraph(CsrAdjacency::build(edges.vertices, false, edges.from, edges.to, {}, false, threads));
+}
+
+std::pair<UnweightedGraph, std::vector<int>> UnweightedGraph::reordered(VertexOrdering ordering, int threads) const {
+    std::vector<int> new_id = vertex_permutation(adjacency(), &reverse_adjacency(), ordering);
+    UnweightedGraph result(adjacency().permuted(new_id, threads));
+    return {std::move(result), std::move(new_id)};
+}
+
+UnweightedGraph UnweightedGraph::relabelled(std::span<const int> new_id, int threads) const {
+    if (!is_permutation(new_id, _size)) {
+        throw std::invalid_argument("Vertex labels must be a permutation of the vertices");
+    }
+    return UnweightedGraph(adjacency().permuted(new_id, threads));
+}
+
+CompressedGraph UnweightedGraph::compressed(int threads) const {
+    return CompressedGraph(CompressedAdjacency(adjacency(), threads));
+}
+
+const CsrAdjacency& UnweightedGraph::adjacency() const {
+    if (!_pending.empty() || _csr.has_gaps()) {
+        _csr.append(_pending);
+        _pending.clear();
+        _reverse.invalidate();
+    }
+    return _csr;
+}
+
+const CsrAdjacency& UnweightedGraph::reverse_adjacency() const {
+    return _reverse.get(adjacency());
+}
+
+UnweightedGraph::TransposeCache::TransposeCache(const TransposeCache& other)
+    : _valid(other._valid.load(std::memory_order_acquire)), _reverse(other._reverse) {}
+
+UnweightedGraph::TransposeCache::TransposeCache(TransposeCache&& other) noexcept
+    : _valid(other._valid.load(std::memory_order_acquire)), _reverse(std::move(other._reverse)) {
+    other.invalidate();
+}
+
+UnweightedGraph::TransposeCache& UnweightedGraph::TransposeCache::operator=(const TransposeCache& other) {
+    if (this != &other) {
+        _reverse = other._reverse;
+        _valid.store(other._valid.load(std::memory_order_acquire), std::memory_order_release);
+    }
+    return *this;
+}
+
+UnweightedGraph::TransposeCache& UnweightedGraph::TransposeCache::operator=(TransposeCache&& other) noexcept {
+    if (this != &other) {
+        _reverse = std::move(other._reverse);
+        _valid.store(other._valid.load(std::memory_order_acquire), std::memory_order_release);
+        other.invalidate();
+    }
+    return *this;
+}
+
+const CsrAdjacency& UnweightedGraph::TransposeCache::get(const CsrAdjacency& forward) {
+    if (!_valid.load(std::memory_order_acquire)) {
+        std::lock_guard lock(_mutex);
+        if (!_valid.load(std::memory_order_relaxed)) {
+            _reverse = forward.transposed();
+            _valid.store(true, std::memory_order_release);
+        }
+    }
+    return _reverse;
 }
 
 std::pair<std::vector<int>, std::vector<int>> UnweightedGraph::bfs(int start) const {
     if (start < 0 || start >= _size) {
         throw std::out_of_range("Start vertex index out of range");
     }
-    std::vector<int> parent(_size, -1), distance(_size, -1);
-    std::vector<bool> visited(_size, false);
-    std::queue<int> q;
+    return breadth_first_tree(adjacency(), start);
+}
 
-    q.push(start);
-    distance[start] = 0;
-    visited[start] = true;
-
-    while (!q.empty()) {
-        int curr = q.front();
-        q.pop();
-        for (int neighbour : _adjacency_list[curr]) {
-            if (!visited[neighbour]) {
-                visited[neighbour] = true;
-                distance[neighbour] = distance[curr] + 1;
-                parent[neighbour] = curr;
-                q.push(neighbour);
+std::span<const int> UnweightedGraph::bfs(int start, SearchWorkspace& workspace) const {
+    if (start < 0 || start >= _size) {
+        throw std::out_of_range("Start vertex index out of range");
+    }
+    const CsrAdjacency& adj = adjacency();
+    workspace.begin(_size, -1);
+    workspace.touch(start);
+    workspace._distance[0][start] = 0;
+
+    // The touched list doubles as the BFS queue: vertices are touched in dequeue order.
+    for (std::size_t head = 0; head < workspace._touched.size(); ++head) {
+        int curr = workspace._touched[head];
+        for (int neighbour : adj.neighbours(curr)) {
+            if (!workspace.touched(neighbour)) {
+                workspace.touch(neighbour);
+                workspace._distance[0][neighbour] = workspace._distance[0][curr] + 1;
+                workspace._parent[0][neighbour] = curr;
             }
         }
     }
 
-    return {parent, distance};
+    return workspace.touched();
 }
 
-std::pair<std::vector<int>, std::vector<int>> UnweightedGraph::dfs(int start) const {
+std::pair<std::vector<int>, std::vector<int>> UnweightedGraph::bfs_parallel(int start, int threads) const {
     if (start < 0 || start >= _size) {
         throw std::out_of_range("Start vertex index out of range");
     }
-    std::vector<int> parent(_size, -1);
-    std::vector<int> discovery_time(_size, -1);
-    std::stack<int> s;
-    s.push(start);
-    int time = 0;
-
-    while (!s.empty()) {
-        int curr = s.top();
-        s.pop();
-
-        if (discovery_time[curr] == -1) {
-            discovery_time[curr] = time++;
-            for (int neighbour : _adjacency_list[curr]) {
-                if (discovery_time[neighbour] == -1) {
-                    parent[neighbour] = curr;
-                    s.push(neighbour);
+    const CsrAdjacency& adj = adjacency();
+    const CsrAdjacency& radj = reverse_adjacency();
+    threads = resolve_thread_count(threads);
+
+    constexpr long long alpha = 14;
+    constexpr long long beta = 24;
+    const int words = (_size + 63) / 64;
+
+    std::vector<int> parent(_size, -1), distance(_size, -1);
+    std::vector<int> frontier{start};
+    std::vector<std::uint64_t> front_bits, next_bits;
+    std::vector<std::vector<int>> local_next(threads);
+    std::vector<long long> local_edges(threads), local_count(threads);
+    bool bottom_up = false;
+    long long frontier_size = 1;
+    long long frontier_edges = adj.degree(start);
+    long long unexplored_edges = static_cast<long long>(adj.arc_count()) - frontier_edges;
+    distance[start] = 0;
+
+    for (int level = 0; frontier_size > 0; ++level) {
+        if (!bottom_up && frontier_edges > unexplored_edges / alpha) {
+            bottom_up = true;
+            front_bits.assign(words, 0);
+            for (int v : frontier) front_bits[v >> 6] |= std::uint64_t{1} << (v & 63);
+        } else if (bottom_up && frontier_size < _size / beta) {
+            bottom_up = false;
+            std::fill(local_next.begin(), local_next.end(), std::vector<int>());
+            int used = parallel_for(0, words, threads, [&](int worker, int lo, int hi) {
+                for (int w = lo; w < hi; ++w) {
+                    for (std::uint64_t bits = front_bits[w]; bits; bits &= bits - 1) {
+                        local_next[worker].push_back(w * 64 + std::countr_zero(bits));
+                    }
                 }
-            }
+            }, 64);
+            frontier.clear();
+            for (int t = 0; t < used; ++t) frontier.insert(frontier.end(), local_next[t].begin(), local_next[t].end());
+        }
+
+        std::fill(local_edges.begin(), local_edges.end(), 0);
+        std::fill(local_count.begin(), local_count.end(), 0);
+        int used;
+
+        if (bottom_up) {
+            next_bits.assign(words, 0);
+            used = parallel_for(0, words, threads, [&](int worker, int lo, int hi) {
+                for (int v = lo * 64; v < std::min(hi * 64, _size); ++v) {
+                    if (distance[v] != -1) continue;
+                    for (int u : radj.neighbours(v)) {
+                        if (front_bits[u >> 6] >> (u & 63) & 1) {
+                            parent[v] = u;
+                            distance[v] = level + 1;
+                            next_bits[v >> 6] |= std::uint64_t{1} << (v & 63);
+                            local_count[worker]++;
+                            local_edges[worker] += adj.degree(v);
+                            break;
+                        }
+                    }
+                }
+            }, 16);
+            std::swap(front_bits, next_bits);
+        } else {
+            used = parallel_for(0, static_cast<int>(frontier.size()), threads, [&](int worker, int lo, int hi) {
+                std::vector<int>& next = local_next[worker];
+                next.clear();
+                for (int i = lo; i < hi; ++i) {
+                    int curr = frontier[i];
+                    for (int neighbour : adj.neighbours(curr)) {
+                        std::atomic_ref<int> slot(distance[neighbour]);
+                        int expected = -1;
+                        if (slot.load(std::memory_order_relaxed) == -1 &&
+                            slot.compare_exchange_strong(expected, level + 1, std::memory_order_relaxed)) {
+                            parent[neighbour] = curr;
+                            next.push_back(neighbour);
+                            local_edges[worker] += adj.degree(neighbour);
+                        }
+                    }
+                }
+                local_count[worker] = static_cast<long long>(next.size());
+            }, 256);
+            frontier.clear();
+            for (int t = 0; t < used; ++t) frontier.insert(frontier.end(), local_next[t].begin(), local_next[t].end());
         }
+
+        frontier_size = 0;
+        frontier_edges = 0;
+        for (int t = 0; t < used; ++t) {
+            frontier_size += local_count[t];
+            frontier_edges += local_edges[t];
+        }
+        unexplored_edges -= frontier_edges;
     }
 
-    return {parent, discovery_time};
+    return {parent, distance};
 }
 
-std::pair<std::vector<int>, std::vector<int>> UnweightedGraph::dfs_recursive(int start) const {
-    if (start < 0 || start >= _size) {
+std::vector<std::vector<int>> UnweightedGraph::multi_source_bfs(std::span<const int> sources, int batch_width,
+                                                               int threads) const {
+    if (std::ranges::any_of(sources, [&](int v) { return v < 0 || v >= _size; })) {
         throw std::out_of_range("Start vertex index out of range");
     }
-    std::vector<int> parent(_size, -1);
-    std::vector<int> discovery_time(_size, -1);
-    int time = 0;
-    dfs_visit(start, parent, discovery_time, time);
-    return {parent, discovery_time};
+    return multi_source_distances(adjacency(), reverse_adjacency(), sources, batch_width, threads);
 }
 
-void UnweightedGraph::dfs_visit(int v, std::vector<int> &parent, std::vector<int> &discovery_time, int &time) const {
-    discovery_time[v] = time++;
-    for (int neighbour : _adjacency_list[v]) {
-        if (discovery_time[neighbour] == -1) {
-            parent[neighbour] = v;
-            dfs_visit(neighbour, parent, discovery_time, time);
-        }
+BfsSummary UnweightedGraph::multi_source_bfs_summary(std::span<const int> sources, int batch_width,
+                                                     int threads) const {
+    if (std::ranges::any_of(sources, [&](int v) { return v < 0 || v >= _size; })) {
+        throw std::out_of_range("Start vertex index out of range");
     }
+    return multi_source_summary(adjacency(), reverse_adjacency(), sources, batch_width, threads);
 }
 
-std::vector<int> UnweightedGraph::topological_sort() const {
-    std::vector<int> in_degree(_size, 0);
-    std::queue<int> q;
-    std::vector<int> result;
+std::pair<std::vector<int>, std::vector<int>> UnweightedGraph::dfs(int start) const {
+    if (start < 0 || start >= _size) {
+        throw std::out_of_range("Start vertex index out of range");
+    }
+    return depth_first_tree(adjacency(), start);
+}
 
-    for (const auto& v : _adjacency_list) {
-        for (int x : v) {
-            in_degree[x]++;
-        }
+std::span<const int> UnweightedGraph::dfs(int start, SearchWorkspace& workspace) const {
+    if (start < 0 || start >= _size) {
+        throw std::out_of_range("Start vertex index out of range");
     }
+    // Discovery times and parents live in the workspace, so the engine keeps no rank arrays.
+    struct WorkspaceVisitor : DepthFirstVisitor {
+        SearchWorkspace& workspace;
+        int time = 0;
+
+        explicit WorkspaceVisitor(SearchWorkspace& workspace) : workspace(workspace) {}
 
-    for (int i = 0; i < _size; i++) {
-        if (in_degree[i] == 0) {
-            q.push(i);
+        bool try_discover(int v, int parent) {
+            if (workspace.touched(v)) return false;
+            workspace.touch(v);
+            workspace._distance[0][v] = time++;
+            workspace._parent[0][v] = parent;
+            return true;
         }
+    } visitor(workspace);
+
+    workspace.begin(_size, -1);
+    DepthFirstEngine<CsrAdjacency> engine(adjacency());
+    engine.visit(start, visitor);
+    return workspace.touched();
+}
+
+std::pair<std::vector<int>, std::vector<int>> UnweightedGraph::dfs_recursive(int start) const {
+    return dfs(start);
+}
+
+std::vector<int> UnweightedGraph::topological_sort() const {
+    return kahn_topological_order(adjacency());
+}
+
+DynamicTopologicalOrder UnweightedGraph::dynamic_topological_order() const {
+    std::vector<int> order = topological_sort();
+    if (static_cast<int>(order.size()) != _size) {
+        throw std::invalid_argument("Graph must be acyclic");
     }
+    return DynamicTopologicalOrder(adjacency(), reverse_adjacency(), std::move(order));
+}
+
+UnweightedGraph::TopologicalLayers UnweightedGraph::topological_layers(int threads) const {
+    const CsrAdjacency& adj = adjacency();
+    const CsrAdjacency& radj = reverse_adjacency();
+    threads = resolve_thread_count(threads);
 
-    while (!q.empty()) {
-        int curr_vertex = q.front();
-        q.pop();
-        result.push_back(curr_vertex);
+    std::vector<int> in_degree(_size);
+    std::vector<std::vector<int>> local(threads);
+    TopologicalLayers result;
+    result.order.reserve(_size);
+    result.layer_offsets.push_back(0);
 
-        for (int v : _adjacency_list[curr_vertex]) {
-            in_degree[v]--;
-            if (in_degree[v] == 0) q.push(v);
+    // Layers are appended to order directly, so the frontier is its last layer.
+    auto append = [&](int used) {
+        for (int t = 0; t < used; ++t) result.order.insert(result.order.end(), local[t].begin(), local[t].end());
+    };
+    append(parallel_for(0, _size, threads, [&](int worker, int lo, int hi) {
+        local[worker].clear();
+        for (int v = lo; v < hi; ++v) {
+            in_degree[v] = radj.degree(v);
+            if (in_degree[v] == 0) local[worker].push_back(v);
         }
+    }));
+
+    while (static_cast<int>(result.order.size()) > result.layer_offsets.back()) {
+        int lo_layer = result.layer_offsets.back(), hi_layer = static_cast<int>(result.order.size());
+        result.layer_offsets.push_back(hi_layer);
+        append(parallel_for(lo_layer, hi_layer, threads, [&](int worker, int lo, int hi) {
+            std::vector<int>& next = local[worker];
+            next.clear();
+            for (int i = lo; i < hi; ++i) {
+                for (int v : adj.neighbours(result.order[i])) {
+                    // A single worker owns every counter and can skip the locked decrement.
+                    int before = threads == 1 ? in_degree[v]--
+                                              : std::atomic_ref<int>(in_degree[v]).fetch_sub(1, std::memory_order_relaxed);
+                    if (before == 1) next.push_back(v);
+                }
+            }
+        }, 256));
     }
 
-    if (result.size() == _size) return result;
-    return {};
-}
\ No newline at end of file
+    if (static_cast<int>(result.order.size()) != _size) return {};
+    return result;
+}
+
+UnweightedGraph::DepthFirstForest UnweightedGraph::depth_first_forest() const {
+    const CsrAdjacency& adj = adjacency();
+    struct ForestVisitor : DepthFirstVisitor {
+        DepthFirstForest& forest;
+        explicit ForestVisitor(DepthFirstForest& forest) : forest(forest) {}
+        void discover(int v, int parent) { forest.parent[v] = parent; }
+        void edge(int u, int, int arc, EdgeClass kind) { forest.edge_class[forest.offsets[u] + arc] = kind; }
+    };
+
+    DepthFirstForest forest;
+    forest.parent.assign(_size, -1);
+    forest.edge_class.resize(adj.arc_count());
+    forest.offsets.assign(adj.offsets().begin(), adj.offsets().end());
+    ForestVisitor visitor(forest);
+
+    DepthFirstEngine<CsrAdjacency> engine(adj);
+    engine.visit_all(visitor);
+    forest.discovery = engine.discovery();
+    forest.finish = engine.finish();
+    return forest;
+}
+
+StronglyConnectedComponents UnweightedGraph::strongly_connected_components() const {
+    return tarjan_components(adjacency());
+}
+
+StronglyConnectedComponents UnweightedGraph::strongly_connected_components_parallel(int threads) const {
+    return forward_backward_components(adjacency(), reverse_adjacency(), threads);
+}
+
+ConnectedComponents UnweightedGraph::connected_components(int threads) const {
+    return afforest_components(adjacency(), &reverse_adjacency(), threads);
+}
+
+UnweightedGraph UnweightedGraph::condensation(const StronglyConnectedComponents& components, int threads) const {
+    auto out_of_range = [&](int c) { return c < 0 || c >= components.count; };
+    if (static_cast<int>(components.component.size()) != _size ||
+        std::ranges::any_of(components.component, out_of_range)) {
+        throw std::invalid_argument("Component labels must hold one entry per vertex in 0 .. count - 1");
+    }
+    return UnweightedGraph(::condensation(adjacency(), components.component, components.count, threads));
+}
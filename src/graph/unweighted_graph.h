@@ -2,24 +2,134 @@
 #define UNWEIGHTED_GRAPH_H
 
 #include <vector>
+#include <string>
 #include <queue>
 #include <stack>
+#include <span>
 #include <algorithm>
+#include <atomic>
+#include <mutex>
+#include "src/graph/csr.h"
+#include "src/graph/edge_list.h"
+#include "src/graph/compressed_graph.h"
+#include "src/graph/traversal.h"
+#include "src/graph/strongly_connected.h"
+#include "src/graph/connected_components.h"
+#include "src/graph/multi_source_bfs.h"
+#include "src/graph/dynamic_topological_order.h"
+#include "src/graph/reorder.h"
+#include "src/graph/search_workspace.h"
 
 /**
  * @class UnweightedGraph
  * @brief A class representing an unweighted graph.
  *
- * This class implements an unweighted graph using an adjacency list representation.
- * It provides methods for adding edges, performing graph traversals (BFS and DFS),
- * and topological sorting.
+ * This class implements an unweighted graph on top of a compressed-sparse-row (CSR)
+ * adjacency. Edges added with add_edge() are staged and merged into the CSR arrays by
+ * finalize(); traversals finalize lazily on first use, so finalize() only has to be
+ * called explicitly before a graph is shared between threads. The transposed adjacency that
+ * several traversals need is built on first use under a lock, so concurrent readers of a
+ * finalized graph may trigger it, and graphs that never need it never pay for it. It provides
+ * methods for adding edges, performing graph traversals (BFS and DFS), and topological sorting.
+ *
+ * Large graphs are best built with add_edges(), which fills the CSR arrays from a whole batch
+ * at once, or by announcing the final out-degrees with reserve_degrees() so that add_edge()
+ * writes straight into the CSR arrays instead of staging.
  *
  * @note Vertices are zero-indexed.
  */
 class UnweightedGraph {
+public:
+    /**
+     * @struct TopologicalLayers
+     * @brief Result of topological_layers()
+     *
+     * Layer i holds order[layer_offsets[i]] .. order[layer_offsets[i + 1] - 1]: the vertices
+     * whose longest incoming path has exactly i edges. All vertices of one layer can be
+     * processed in parallel once the previous layers are done.
+     */
+    struct TopologicalLayers {
+        std::vector<int> order;         ///< Vertices in topological order, layer by layer
+        std::vector<int> layer_offsets; ///< Start of each layer in order, plus order.size()
+
+        /**
+         * @brief Get the number of layers
+         * @return int Number of layers (the number of vertices on a longest path)
+         */
+        [[nodiscard]] int layer_count() const {
+            return layer_offsets.empty() ? 0 : static_cast<int>(layer_offsets.size()) - 1;
+        }
+
+        /**
+         * @brief Get the vertices of one layer
+         * @param i Layer index
+         * @return std::span<const int> Vertices of layer i
+         */
+        [[nodiscard]] std::span<const int> layer(int i) const {
+            return std::span<const int>(order).subspan(layer_offsets[i], layer_offsets[i + 1] - layer_offsets[i]);
+        }
+    };
+
+    /**
+     * @struct DepthFirstForest
+     * @brief Result of depth_first_forest()
+     */
+    struct DepthFirstForest {
+        std::vector<int> parent;           ///< Parent of each vertex (-1 for tree roots)
+        std::vector<int> discovery;        ///< Preorder rank of each vertex
+        std::vector<int> finish;           ///< Postorder rank of each vertex
+        std::vector<EdgeClass> edge_class; ///< Class of each arc, parallel to the CSR targets
+        std::vector<int> offsets;          ///< Index of the first arc of each vertex, size() + 1 entries
+
+        /**
+         * @brief Get the class of the i-th arc leaving u (in neighbours(u) order)
+         * @param u Source vertex
+         * @param i Position of the arc in u's row
+         * @return EdgeClass Class of the arc
+         */
+        [[nodiscard]] EdgeClass classify(int u, int i) const { return edge_class[offsets[u] + i]; }
+    };
+
 private:
     int _size; ///< Number of vertices in the graph
-    std::vector<std::vector<int>> _adjacency_list; ///< Adjacency list representation
+    mutable CsrAdjacency _csr; ///< Frozen CSR adjacency
+    mutable std::vector<CsrAdjacency::Arc> _pending; ///< Edges added since the last finalize
+
+    /**
+     * @class TransposeCache
+     * @brief Transposed adjacency built once, on first use, even by concurrent readers
+     *
+     * Copies and moves take the cached arrays along but not the lock.
+     */
+    class TransposeCache {
+    private:
+        std::mutex _mutex;
+        std::atomic<bool> _valid = false;
+        CsrAdjacency _reverse;
+
+    public:
+        TransposeCache() = default;
+        TransposeCache(const TransposeCache& other);
+        TransposeCache(TransposeCache&& other) noexcept;
+        TransposeCache& operator=(const TransposeCache& other);
+        TransposeCache& operator=(TransposeCache&& other) noexcept;
+
+        /**
+         * @brief Drop the cached transpose; only called while the graph is being modified
+         */
+        void invalidate() { _valid.store(false, std::memory_order_relaxed); }
+
+        /**
+         * @brief Get the transpose of forward, building it if it is not cached
+         * @param forward Up-to-date adjacency
+         * @return const CsrAdjacency& Transposed adjacency
+         */
+        const CsrAdjacency& get(const CsrAdjacency& forward);
+    };
+
+    mutable TransposeCache _reverse; ///< Transposed adjacency, built on demand
+
+    explicit UnweightedGraph(CsrAdjacency csr);
 
 public:
     /**
@@ -36,6 +146,134 @@ public:
      */
     void add_edge(int from, int to);
 
+    /**
+     * @brief Add a batch of edges, filling the CSR adjacency in one pass
+     *
+     * The result is the same as calling add_edge() for every edge in order, but the arcs are
+     * scattered from the batch straight into the CSR arrays by a parallel counting sort (see
+     * CsrAdjacency::append_edges()), without a staging copy. The batch is validated first, so
+     * on error the graph is left unchanged.
+     *
+     * @param edges (from, to) pairs to add
+     * @param threads Number of worker threads (non-positive selects hardware concurrency)
+     * @throw std::out_of_range if any vertex is out of range
+     */
+    void add_edges(std::span<const std::pair<int, int>> edges, int threads = 0);
+
+    /**
+     * @brief Reserve staging room for a number of further add_edge() calls
+     * @param edges Number of edges about to be added
+     */
+    void reserve_edges(std::size_t edges);
+
+    /**
+     * @brief Announce how many further outgoing edges each vertex will receive
+     *
+     * Opens that much room at the end of every CSR row, so subsequent add_edge() calls write
+     * their arcs in place instead of staging them. Edges beyond the hint are staged as usual,
+     * and the room is closed (unused parts released) the next time the adjacency is read.
+     *
+     * @param degrees Number of further outgoing edges per vertex
+     * @throw std::invalid_argument if degrees does not hold one non-negative entry per vertex
+     */
+    void reserve_degrees(std::span<const int> degrees);
+
+    /**
+     * @brief Merge all staged edges into the CSR adjacency and release the staging buffer
+     *
+     * Afterwards const methods may be called concurrently until the next edge is added. The
+     * transposed adjacency is not built here; the first traversal that needs it builds it
+     * under a lock.
+     */
+    void finalize();
+
+    /**
+     * @brief Check whether every added edge has been merged into the CSR adjacency
+     *
+     * A finalized graph is safe to share between concurrent readers.
+     *
+     * @return bool True if no edges are staged and no reserved room is open
+     */
+    [[nodiscard]] bool is_finalized() const { return _pending.empty() && !_csr.has_gaps(); }
+
+    /**
+     * @brief Write the graph to a binary CSR file (see graph_file.h)
+     * @param filename Destination path
+     * @throw std::runtime_error if the file cannot be written
+     */
+    void save(const std::string& filename) const;
+
+    /**
+     * @brief Load a graph written by save() by memory-mapping the file
+     *
+     * The CSR arrays are used in place, without copying or parsing, so loading costs little
+     * more than validating the file. Edges added to a loaded graph are merged into a private
+     * copy of the arrays; the file is never modified.
+     *
+     * @param filename Source path
+     * @param verify Whether to validate the payload checksum and contents, not just the header
+     * @return UnweightedGraph Graph backed by the mapped file
+     * @throw std::runtime_error if the file cannot be read or does not hold a UnweightedGraph
+     */
+    [[nodiscard]] static UnweightedGraph load(const std::string& filename, bool verify = true);
+
+    /**
+     * @brief Build a graph from an edge-list file, parsing and filling the CSR in parallel
+     *
+     * See read_edge_list() for the formats; weight columns are ignored. Every edge u v becomes
+     * the arc u -> v, in file order, exactly as if add_edge() had been called for each line.
+     *
+     * @param filename Source path
+     * @param format File format
+     * @param vertices Number of vertices; non-positive infers it from the largest vertex id
+     * @param threads Number of worker threads (non-positive selects hardware concurrency)
+     * @return UnweightedGraph Finalized graph
+     * @throw std::runtime_error if the file cannot be read or is malformed
+     * @throw std::out_of_range if a vertex id is out of range
+     * @throw std::overflow_error if the file holds more than INT_MAX edges
+     */
+    [[nodiscard]] static UnweightedGraph from_edge_list(const std::string& filename, EdgeListFormat format,
+                                                        int vertices = 0, int threads = 0);
+
+    /**
+     * @brief Relabel the vertices into a cache-friendly layout
+     *
+     * Input vertex ids are often arbitrary, so consecutive neighbour accesses land far apart in
+     * memory. The returned graph numbers vertices so that those visited together sit close
+     * together (see VertexOrdering; searches follow the arcs in both directions), which speeds up
+     * traversals on large graphs. Results computed on the new graph are mapped back through
+     * the returned permutation: vertex v of this graph is vertex permutation[v] of the result.
+     *
+     * @param ordering Layout to use
+     * @param threads Number of worker threads for rebuilding the adjacency (non-positive
+     *                selects hardware concurrency)
+     * @return std::pair<UnweightedGraph, std::vector<int>>
+     *         First: relabelled graph
+     *         Second: new id of every vertex
+     */
+    [[nodiscard]] std::pair<UnweightedGraph, std::vector<int>> reordered(VertexOrdering ordering, int threads = 0) const;
+
+    /**
+     * @brief Relabel the vertices with a given permutation
+     * @param new_id New id of every vertex
+     * @param threads Number of worker threads (non-positive selects hardware concurrency)
+     * @return UnweightedGraph Graph in which vertex v of this graph is vertex new_id[v]
+     * @throw std::invalid_argument if new_id is not a permutation of the vertices
+     */
+    [[nodiscard]] UnweightedGraph relabelled(std::span<const int> new_id, int threads = 0) const;
+
+    /**
+     * @brief Encode the graph into a read-only compressed copy
+     *
+     * Neighbour lists are sorted and stored as varint-encoded gaps (see CompressedAdjacency).
+     * Relabelling the graph first, e.g. with reordered(VertexOrdering::ReverseCuthillMcKee),
+     * shrinks the gaps and therefore the encoding.
+     *
+     * @param threads Number of worker threads (non-positive selects hardware concurrency)
+     * @return CompressedGraph Compressed copy of the graph
+     */
+    [[nodiscard]] CompressedGraph compressed(int threads = 0) const;
+
     /**
      * @brief Perform Breadth-First Search (BFS) starting from a given vertex
      * @param start Starting vertex for BFS
@@ -46,8 +284,82 @@ public:
      */
     [[nodiscard]] std::pair<std::vector<int>, std::vector<int>> bfs(int start) const;
 
+    /**
+     * @brief Perform Breadth-First Search (BFS) reusing a caller-owned workspace
+     *
+     * Distances and parents are left in the workspace (see SearchWorkspace::distance() and
+     * SearchWorkspace::parent()); the cost is proportional to the vertices reached, not to
+     * the size of the graph.
+     *
+     * @param start Starting vertex for BFS
+     * @param workspace Workspace receiving the result
+     * @return std::span<const int> Reached vertices in BFS order (valid until the next search)
+     * @throw std::out_of_range if start vertex is out of range
+     */
+    std::span<const int> bfs(int start, SearchWorkspace& workspace) const;
+
+    /**
+     * @brief Perform direction-optimizing, multi-threaded Breadth-First Search
+     *
+     * Each level is expanded either top-down (threads split the frontier queue and claim
+     * unvisited neighbours atomically) or bottom-up (threads split the unvisited vertices and
+     * look for a parent among their in-neighbours in a frontier bitmap). The search switches to
+     * bottom-up when the frontier's outgoing edges exceed 1/14 of the edges still unexplored and
+     * back to top-down once the frontier holds fewer than 1/24 of the vertices (Beamer et al.).
+     * Distances are identical to bfs(); parents may differ but always lie on a shortest path.
+     * The first call builds and caches the transposed adjacency used by bottom-up steps.
+     *
+     * @param start Starting vertex for BFS
+     * @param threads Number of worker threads (non-positive selects hardware concurrency)
+     * @return std::pair<std::vector<int>, std::vector<int>>
+     *         First vector: parent of each vertex in BFS tree (-1 for unreachable vertices)
+     *         Second vector: distance from start to each vertex (-1 for unreachable vertices)
+     * @throw std::out_of_range if start vertex is out of range
+     */
+    [[nodiscard]] std::pair<std::vector<int>, std::vector<int>> bfs_parallel(int start, int threads = 0) const;
+
+    /**
+     * @brief Run a Breadth-First Search from every source, sharing arc scans between them
+     *
+     * Up to batch_width searches advance together on per-vertex bitsets (see
+     * multi_source_distances()), so one scan of a vertex's arcs serves every search that
+     * reached it. Distances are identical to those of bfs() from each source.
+     *
+     * @param sources Source vertices (duplicates allowed)
+     * @param batch_width Searches run together: 64, 256 or 512
+     * @param threads Number of worker threads (non-positive selects hardware concurrency)
+     * @return std::vector<std::vector<int>> Distance from each source to each vertex (-1 for
+     *         unreachable vertices)
+     * @throw std::out_of_range if a source vertex is out of range
+     * @throw std::invalid_argument if batch_width is not 64, 256 or 512
+     */
+    [[nodiscard]] std::vector<std::vector<int>> multi_source_bfs(std::span<const int> sources, int batch_width = 256,
+                                                                 int threads = 0) const;
+
+    /**
+     * @brief Run a Breadth-First Search from every source and keep only per-source statistics
+     *
+     * Same traversal as multi_source_bfs() without storing a distance per source and vertex;
+     * suited to closeness and reachability over many sources.
+     *
+     * @param sources Source vertices (duplicates allowed)
+     * @param batch_width Searches run together: 64, 256 or 512
+     * @param threads Number of worker threads (non-positive selects hardware concurrency)
+     * @return BfsSummary Reached vertices, distance sum, eccentricity and traversed arcs per source
+     * @throw std::out_of_range if a source vertex is out of range
+     * @throw std::invalid_argument if batch_width is not 64, 256 or 512
+     */
+    [[nodiscard]] BfsSummary multi_source_bfs_summary(std::span<const int> sources, int batch_width = 256,
+                                                      int threads = 0) const;
+
     /**
      * @brief Perform iterative Depth-First Search (DFS) starting from a given vertex
+     *
+     * Runs the explicit-stack DepthFirstEngine (see traversal.h) with a tree-only visitor:
+     * every vertex is pushed once and neighbours are explored in stored order, exactly as a
+     * recursive DFS would, without the risk of overflowing the call stack on deep graphs.
+     * benchmarks/graph/dfs_benchmark.cpp compares it with the DFS it replaced.
+     *
      * @param start Starting vertex for DFS
      * @return std::pair<std::vector<int>, std::vector<int>> 
      *         First vector: parent of each vertex in DFS tree (-1 for unreachable vertices)
@@ -57,7 +369,24 @@ public:
     [[nodiscard]] std::pair<std::vector<int>, std::vector<int>> dfs(int start) const;
 
     /**
-     * @brief Perform recursive Depth-First Search (DFS) starting from a given vertex
+     * @brief Perform iterative Depth-First Search (DFS) reusing a caller-owned workspace
+     *
+     * Discovery times and parents are left in the workspace; discovery times are read with
+     * SearchWorkspace::distance().
+     *
+     * @param start Starting vertex for DFS
+     * @param workspace Workspace receiving the result
+     * @return std::span<const int> Reached vertices (valid until the next search)
+     * @throw std::out_of_range if start vertex is out of range
+     */
+    std::span<const int> dfs(int start, SearchWorkspace& workspace) const;
+
+    /**
+     * @brief Perform Depth-First Search (DFS) in recursive order starting from a given vertex
+     *
+     * @deprecated Alias of dfs(), kept for existing callers. dfs() already visits vertices in
+     * recursive order without recursing; use it instead.
+     *
      * @param start Starting vertex for DFS
      * @return std::pair<std::vector<int>, std::vector<int>> 
      *         First vector: parent of each vertex in DFS tree (-1 for unreachable vertices)
@@ -72,6 +401,85 @@ public:
      */
     [[nodiscard]] std::vector<int> topological_sort() const;
 
+    /**
+     * @brief Topologically sort the graph into layers with a parallel level-synchronous Kahn
+     *
+     * In-degrees start from the cached reverse adjacency instead of a counting pass. Each
+     * round, workers split the current layer, decrement the in-degree of every successor
+     * atomically, and whichever worker brings it to zero appends it to the next layer. The
+     * order within a layer depends on thread scheduling.
+     *
+     * @param threads Number of worker threads (non-positive selects hardware concurrency)
+     * @return TopologicalLayers Flat order and layer boundaries (both empty if the graph has a
+     *         cycle)
+     */
+    [[nodiscard]] TopologicalLayers topological_layers(int threads = 0) const;
+
+    /**
+     * @brief Create an incrementally maintained topological order of this DAG
+     *
+     * Further edges should be inserted through DynamicTopologicalOrder::add_edge(), which
+     * updates the order in time proportional to the affected region and rejects edges that
+     * would close a cycle.
+     *
+     * @return DynamicTopologicalOrder Order seeded with topological_sort()
+     * @throw std::invalid_argument if the graph has a cycle
+     */
+    [[nodiscard]] DynamicTopologicalOrder dynamic_topological_order() const;
+
+    /**
+     * @brief Build a depth-first forest over all vertices and classify every arc
+     *
+     * Trees are started at undiscovered vertices in increasing id order. This is the common
+     * foundation for cycle detection, strongly connected components and similar routines.
+     *
+     * @return DepthFirstForest Parents, discovery/finish ranks and the class of every arc
+     */
+    [[nodiscard]] DepthFirstForest depth_first_forest() const;
+
+    /**
+     * @brief Find the strongly connected components with iterative Tarjan
+     * @return StronglyConnectedComponents Component of each vertex; labels follow a topological
+     *         order of the condensation
+     */
+    [[nodiscard]] StronglyConnectedComponents strongly_connected_components() const;
+
+    /**
+     * @brief Find the strongly connected components with parallel trim, forward-backward
+     *        search and colouring (see forward_backward_components())
+     *
+     * Labels follow a topological order of the condensation, as for
+     * strongly_connected_components(); the partition is identical but the numbering of
+     * mutually unordered components may differ.
+     *
+     * @param threads Number of worker threads (non-positive selects hardware concurrency)
+     * @return StronglyConnectedComponents Component of each vertex
+     */
+    [[nodiscard]] StronglyConnectedComponents strongly_connected_components_parallel(int threads = 0) const;
+
+    /**
+     * @brief Find the weakly connected components (edge directions ignored) with parallel
+     *        Afforest (see afforest_components())
+     * @param threads Number of worker threads (non-positive selects hardware concurrency)
+     * @return ConnectedComponents Component of each vertex, numbered by smallest vertex, and
+     *         the size of each component
+     */
+    [[nodiscard]] ConnectedComponents connected_components(int threads = 0) const;
+
+    /**
+     * @brief Build the condensation DAG: one vertex per component, an edge between two
+     *        components if any edge joins their vertices
+     *
+     * With labels from strongly_connected_components(), vertex ids of the result are already
+     * a topological order, so cyclic graphs can be scheduled component by component.
+     *
+     * @param components Component labels of this graph
+     * @param threads Number of worker threads (non-positive selects hardware concurrency)
+     * @return UnweightedGraph Condensation with components.count vertices
+     * @throw std::invalid_argument if the labels do not cover every vertex or are out of range
+     */
+    [[nodiscard]] UnweightedGraph condensation(const StronglyConnectedComponents& components, int threads = 0) const;
+
     /**
      * @brief Get the number of vertices in the graph
      * @return int Number of vertices
@@ -79,20 +487,30 @@ public:
     [[nodiscard]] int size() const { return _size; }
 
     /**
-     * @brief Get the adjacency list representation of the graph
-     * @return const std::vector<std::vector<int>>& Adjacency list
+     * @brief Get the out-neighbours of a vertex
+     * @param v Vertex
+     * @return std::span<const int> Contiguous view of the neighbours of v
      */
-    [[nodiscard]] const std::vector<std::vector<int>>& get_adj_list() const { return _adjacency_list; }
+    [[nodiscard]] std::span<const int> neighbours(int v) const { return adjacency().neighbours(v); }
+
+    /**
+     * @brief Get a span-based view of the adjacency of the graph
+     * @return NeighbourView View whose operator[](v) yields the neighbours of v
+     */
+    [[nodiscard]] NeighbourView get_adj_list() const { return NeighbourView(adjacency()); }
 
 private:
     /**
-     * @brief Helper function for recursive DFS
-     * @param v Current vertex
-     * @param parent Vector to store parent of each vertex
-     * @param discovery_time Vector to store discovery time of each vertex
-     * @param time Current time (modified during traversal)
+     * @brief Get the CSR adjacency, merging staged edges first if necessary
+     * @return const CsrAdjacency& Up-to-date adjacency
+     */
+    const CsrAdjacency& adjacency() const;
+
+    /**
+     * @brief Get the transposed CSR adjacency (in-neighbours), building it if necessary
+     * @return const CsrAdjacency& Up-to-date reversed adjacency
      */
-    void dfs_visit(int v, std::vector<int>& parent, std::vector<int>& discovery_time, int& time) const;
+    const CsrAdjacency& reverse_adjacency() const;
 };
 
 #endif // UNWEIGHTED_GRAPH_H
\ No newline at end of file
@@ -3,9 +3,18 @@
 #include <algorithm>
 #include <limits>
 #include <stdexcept>
+#include <atomic>
+#include <barrier>
+#include <tuple>
 #include "src/data_structures/union_find.h"
+#include "src/graph/parallel.h"
+#include "src/graph/boruvka.h"
+#include "src/graph/graph_file.h"
 
-WeightedGraph::WeightedGraph(int size) : _size(size), _adjacency_list(size) {}
+WeightedGraph::WeightedGraph(int size) : _size(size), _csr(size, true) {}
+
+WeightedGraph::WeightedGraph(CsrAdjacency csr, int max_weight)
+    : _size(csr.size()), _max_weight(max_weight), _csr(std::move(csr)) {}
 
 void WeightedGraph::add_edge(int from, int to, int weight) {
     if (from < 0 || from >= _size || to < 0 || to >= _size) {
@@ -14,64 +23,184 @@ void WeightedGraph::add_edge(int from, int to, int weight) {
     if (weight < 0) {
         throw std::invalid_argument("Edge weight cannot be negative");
     }
-    _adjacency_list[from].emplace_back(to, weight);
-    _adjacency_list[to].emplace_back(from, weight);
+    if (!_csr.try_push(from, to, weight)) _pending.emplace_back(from, to, weight);
+    if (!_csr.try_push(to, from, weight)) _pending.emplace_back(to, from, weight);
+    _max_weight = std::max(_max_weight, weight);
+}
+
+void WeightedGraph::add_edges(std::span<const Edge> edges, int threads) {
+    threads = resolve_thread_count(threads);
+    int count = static_cast<int>(edges.size());
+    std::vector<int> heaviest(threads, 0);
+    std::vector<char> bad_vertex(threads, 0), bad_weight(threads, 0);
+
+    parallel_for(0, count, threads, [&](int worker, int lo, int hi) {
+        for (int i = lo; i < hi; ++i) {
+            const Edge& edge = edges[i];
+            if (edge.u < 0 || edge.u >= _size || edge.v < 0 || edge.v >= _size) bad_vertex[worker] = 1;
+            if (edge.w < 0) bad_weight[worker] = 1;
+            heaviest[worker] = std::max(heaviest[worker], edge.w);
+        }
+    }, 1 << 14);
+
+    if (std::ranges::find(bad_vertex, 1) != bad_vertex.end()) {
+        throw std::out_of_range("Vertex index out of range");
+    }
+    if (std::ranges::find(bad_weight, 1) != bad_weight.end()) {
+        throw std::invalid_argument("Edge weight cannot be negative");
+    }
+    if (count == 0) return;
+
+    adjacency();
+    _csr.append_edges(edges.size(), [edges](std::size_t e) {
+        return CsrAdjacency::Arc(edges[e].u, edges[e].v, edges[e].w);
+    }, true, threads);
+    _max_weight = std::max(_max_weight, std::ranges::max(heaviest));
+}
+
+void WeightedGraph::reserve_edges(std::size_t edges) {
+    _pending.reserve(_pending.size() + 2 * edges);
+}
+
+void WeightedGraph::reserve_degrees(std::span<const int> degrees) {
+    if (degrees.size() != static_cast<std::size_t>(_size) || std::ranges::any_of(degrees, [](int d) { return d < 0; })) {
+        throw std::invalid_argument("Degree hints must hold one non-negative entry per vertex");
+    }
+    adjacency();
+    _csr.reserve(degrees);
+}
+
+void WeightedGraph::finalize() {
+    adjacency();
+    _pending.shrink_to_fit();
+}
+
+void WeightedGraph::save(const std::string& filename) const {
+    write_graph_file(filename, adjacency(), GraphFileKind::Undirected, _max_weight);
+}
+
+WeightedGraph WeightedGraph::load(const std::string& filename, bool verify) {
+    auto [csr, max_weight] = map_graph_file(filename, GraphFileKind::Undirected, verify);
+    return {std::move(csr), max_weight};
+}
+
+WeightedGraph WeightedGraph::from_edge_list(const std::string& filename, EdgeListFormat format,
+                                            int vertices, int threads) {
+    // Every edge is stored as two arcs, which must still fit in the int CSR offsets.
+    EdgeList edges = read_edge_list(filename, format, true, vertices, threads, std::numeric_limits<int>::max() / 2);
+    int max_weight = 0;
+    if (!edges.weights.empty()) {
+        auto [lightest, heaviest] = std::minmax_element(edges.weights.begin(), edges.weights.end());
+        if (*lightest < 0) {
+            throw std::invalid_argument("Edge weight cannot be negative");
+        }
+        max_weight = *heaviest;
+    }
+    return {CsrAdjacency::build(edges.vertices, true, edges.from, edges.to, edges.weights, true, threads), max_weight};
+}
+
+std::pair<WeightedGraph, std::vector<int>> WeightedGraph::reordered(VertexOrdering ordering, int threads) const {
+    std::vector<int> new_id = vertex_permutation(adjacency(), nullptr, ordering);
+    WeightedGraph result(adjacency().permuted(new_id, threads), _max_weight);
+    return {std::move(result), std::move(new_id)};
+}
+
+WeightedGraph WeightedGraph::relabelled(std::span<const int> new_id, int threads) const {
+    if (!is_permutation(new_id, _size)) {
+        throw std::invalid_argument("Vertex labels must be a permutation of the vertices");
+    }
+    return {adjacency().permuted(new_id, threads), _max_weight};
+}
+
+const CsrAdjacency& WeightedGraph::adjacency() const {
+    if (!_pending.empty() || _csr.has_gaps()) {
+        _csr.append(_pending);
+        _pending.clear();
+    }
+    return _csr;
 }
 
 std::vector<int> WeightedGraph::dijkstra(int start) const {
+    return dijkstra<BinaryHeapQueue>(start);
+}
+
+std::span<const int> WeightedGraph::dijkstra(int start, SearchWorkspace& workspace) const {
     if (start < 0 || start >= _size) {
         throw std::out_of_range("Start vertex index out of range");
     }
 
-    std::vector<int> dist(_size, std::numeric_limits<int>::max());
-    std::vector<bool> visited(_size, false);
-    std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<>> pq;
+    const CsrAdjacency& adj = adjacency();
+    workspace.begin(_size, std::numeric_limits<int>::max());
+    std::vector<int>& dist = workspace._distance[0];
+    std::vector<std::pair<int, int>>& heap = workspace._heap[0];
 
-    pq.push({0, start});
+    workspace.touch(start);
     dist[start] = 0;
+    heap.emplace_back(0, start);
 
-    while (!pq.empty()) {
-        int current_vertex = pq.top().second;
-        pq.pop();
-
-        if (visited[current_vertex]) continue;
-        visited[current_vertex] = true;
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<>());
+        auto [current_dist, current_vertex] = heap.back();
+        heap.pop_back();
+        if (current_dist > dist[current_vertex]) continue;
 
-        for (const auto& [end, d] : _adjacency_list[current_vertex]) {
-            if (!visited[end] && dist[current_vertex] + d < dist[end]) {
-                dist[end] = dist[current_vertex] + d;
-                pq.push({dist[end], end});
+        std::span<const int> targets = adj.neighbours(current_vertex);
+        std::span<const int> weights = adj.weights(current_vertex);
+        for (std::size_t i = 0; i < targets.size(); ++i) {
+            int end = targets[i];
+            workspace.touch(end);
+            int candidate = saturating_add(current_dist, weights[i]);
+            if (candidate < dist[end]) {
+                dist[end] = candidate;
+                workspace._parent[0][end] = current_vertex;
+                heap.emplace_back(dist[end], end);
+                std::push_heap(heap.begin(), heap.end(), std::greater<>());
             }
         }
     }
 
-    return dist;
+    return workspace.touched();
 }
 
 int WeightedGraph::dijkstra(int start, int end) const {
+    SearchWorkspace::Lease workspace;
+    return dijkstra(start, end, *workspace);
+}
+
+int WeightedGraph::dijkstra(int start, int end, SearchWorkspace& workspace) const {
     if (start < 0 || start >= _size || end < 0 || end >= _size) {
         throw std::out_of_range("Vertex index out of range");
     }
 
-    std::vector<int> dist(_size, std::numeric_limits<int>::max());
-    std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<>> pq;
+    const CsrAdjacency& adj = adjacency();
+    workspace.begin(_size, std::numeric_limits<int>::max());
+    std::vector<int>& dist = workspace._distance[0];
+    std::vector<std::pair<int, int>>& heap = workspace._heap[0];
 
-    pq.push({0, start});
+    workspace.touch(start);
     dist[start] = 0;
+    heap.emplace_back(0, start);
 
-    while (!pq.empty()) {
-        int current_vertex = pq.top().second;
-        int current_dist = pq.top().first;
-        pq.pop();
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<>());
+        auto [current_dist, current_vertex] = heap.back();
+        heap.pop_back();
 
         if (current_vertex == end) return current_dist;
 
         if (current_dist > dist[current_vertex]) continue;
 
-        for (const auto& [end_vertex, d] : _adjacency_list[current_vertex]) {
-            if (dist[current_vertex] + d < dist[end_vertex]) {
-                dist[end_vertex] = dist[current_vertex] + d;
-                pq.push({dist[end_vertex], end_vertex});
+        std::span<const int> targets = adj.neighbours(current_vertex);
+        std::span<const int> weights = adj.weights(current_vertex);
+        for (std::size_t i = 0; i < targets.size(); ++i) {
+            int end_vertex = targets[i];
+            workspace.touch(end_vertex);
+            int candidate = saturating_add(current_dist, weights[i]);
+            if (candidate < dist[end_vertex]) {
+                dist[end_vertex] = candidate;
+                workspace._parent[0][end_vertex] = current_vertex;
+                heap.emplace_back(dist[end_vertex], end_vertex);
+                std::push_heap(heap.begin(), heap.end(), std::greater<>());
             }
         }
     }
@@ -79,15 +208,443 @@ int WeightedGraph::dijkstra(int start, int end) const {
     return -1; // Path not found
 }
 
-std::vector<WeightedGraph::Edge> WeightedGraph::kruskal_mst() const {
+int WeightedGraph::bidirectional_dijkstra(int start, int end) const {
+    SearchWorkspace::Lease workspace;
+    return bidirectional_search(start, end, *workspace, nullptr);
+}
+
+int WeightedGraph::bidirectional_dijkstra(int start, int end, SearchWorkspace& workspace) const {
+    return bidirectional_search(start, end, workspace, nullptr);
+}
+
+std::pair<int, std::vector<int>> WeightedGraph::bidirectional_dijkstra_path(int start, int end) const {
+    SearchWorkspace::Lease workspace;
+    std::vector<int> path;
+    int distance = bidirectional_search(start, end, *workspace, &path);
+    return {distance, path};
+}
+
+int WeightedGraph::bidirectional_search(int start, int end, SearchWorkspace& workspace,
+                                        std::vector<int>* path) const {
+    if (start < 0 || start >= _size || end < 0 || end >= _size) {
+        throw std::out_of_range("Vertex index out of range");
+    }
+    if (path) path->clear();
+    if (start == end) {
+        if (path) path->push_back(start);
+        return 0;
+    }
+
+    constexpr int infinity = std::numeric_limits<int>::max();
+    const CsrAdjacency& adj = adjacency();
+    workspace.begin(_size, infinity);
+    std::vector<int>* dist = workspace._distance;
+    std::vector<int>* parent = workspace._parent;
+    std::vector<std::pair<int, int>>* heap = workspace._heap;
+
+    workspace.touch(start);
+    workspace.touch(end);
+    dist[0][start] = 0;
+    dist[1][end] = 0;
+    heap[0].emplace_back(0, start);
+    heap[1].emplace_back(0, end);
+    long long best = infinity;
+    int meeting_vertex = -1;
+
+    while (!heap[0].empty() && !heap[1].empty()) {
+        if (static_cast<long long>(heap[0].front().first) + heap[1].front().first >= best) break;
+
+        int side = heap[0].front().first <= heap[1].front().first ? 0 : 1;
+        std::pop_heap(heap[side].begin(), heap[side].end(), std::greater<>());
+        auto [current_dist, current_vertex] = heap[side].back();
+        heap[side].pop_back();
+        if (current_dist > dist[side][current_vertex]) continue;
+
+        std::span<const int> targets = adj.neighbours(current_vertex);
+        std::span<const int> weights = adj.weights(current_vertex);
+        for (std::size_t i = 0; i < targets.size(); ++i) {
+            int v = targets[i];
+            workspace.touch(v);
+            int candidate = saturating_add(current_dist, weights[i]);
+            if (candidate < dist[side][v]) {
+                dist[side][v] = candidate;
+                parent[side][v] = current_vertex;
+                heap[side].emplace_back(dist[side][v], v);
+                std::push_heap(heap[side].begin(), heap[side].end(), std::greater<>());
+            }
+            if (dist[1 - side][v] != infinity && static_cast<long long>(dist[side][v]) + dist[1 - side][v] < best) {
+                best = static_cast<long long>(dist[side][v]) + dist[1 - side][v];
+                meeting_vertex = v;
+            }
+        }
+    }
+
+    if (meeting_vertex == -1) return -1;
+    if (path) {
+        for (int v = meeting_vertex; v != -1; v = parent[0][v]) path->push_back(v);
+        std::reverse(path->begin(), path->end());
+        for (int v = parent[1][meeting_vertex]; v != -1; v = parent[1][v]) path->push_back(v);
+    }
+    return static_cast<int>(best);
+}
+
+int WeightedGraph::a_star(int start, int end, const std::function<int(int)>& heuristic) const {
+    SearchWorkspace::Lease workspace;
+    return a_star_search(start, end, heuristic, *workspace, nullptr);
+}
+
+int WeightedGraph::a_star(int start, int end, const std::function<int(int)>& heuristic,
+                          SearchWorkspace& workspace) const {
+    return a_star_search(start, end, heuristic, workspace, nullptr);
+}
+
+std::pair<int, std::vector<int>> WeightedGraph::a_star_path(int start, int end,
+                                                            const std::function<int(int)>& heuristic) const {
+    SearchWorkspace::Lease workspace;
+    std::vector<int> path;
+    int distance = a_star_search(start, end, heuristic, *workspace, &path);
+    return {distance, path};
+}
+
+int WeightedGraph::a_star_search(int start, int end, const std::function<int(int)>& heuristic,
+                                 SearchWorkspace& workspace, std::vector<int>* path) const {
+    if (start < 0 || start >= _size || end < 0 || end >= _size) {
+        throw std::out_of_range("Vertex index out of range");
+    }
+    if (path) path->clear();
+
+    const CsrAdjacency& adj = adjacency();
+    workspace.begin(_size, std::numeric_limits<int>::max());
+    std::vector<int>& dist = workspace._distance[0];
+    std::vector<int>& parent = workspace._parent[0];
+    // Entries are (g + h, g, vertex); g identifies stale entries without re-evaluating h.
+    std::vector<std::tuple<long long, int, int>>& heap = workspace._estimate_heap;
+
+    workspace.touch(start);
+    dist[start] = 0;
+    heap.emplace_back(heuristic(start), 0, start);
+
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<>());
+        auto [estimate, current_dist, current_vertex] = heap.back();
+        heap.pop_back();
+        if (current_dist > dist[current_vertex]) continue;
+
+        if (current_vertex == end) {
+            if (path) {
+                for (int v = end; v != -1; v = parent[v]) path->push_back(v);
+                std::reverse(path->begin(), path->end());
+            }
+            return current_dist;
+        }
+
+        std::span<const int> targets = adj.neighbours(current_vertex);
+        std::span<const int> weights = adj.weights(current_vertex);
+        for (std::size_t i = 0; i < targets.size(); ++i) {
+            int v = targets[i];
+            workspace.touch(v);
+            int candidate = saturating_add(current_dist, weights[i]);
+            if (candidate < dist[v]) {
+                dist[v] = candidate;
+                parent[v] = current_vertex;
+                heap.emplace_back(static_cast<long long>(dist[v]) + heuristic(v), dist[v], v);
+                std::push_heap(heap.begin(), heap.end(), std::greater<>());
+            }
+        }
+    }
+
+    return -1; // Path not found
+}
+
+std::vector<int> WeightedGraph::delta_stepping(int start, int threads, int delta) const {
+    if (start < 0 || start >= _size) {
+        throw std::out_of_range("Start vertex index out of range");
+    }
+
+    const CsrAdjacency& adj = adjacency();
+    threads = resolve_thread_count(threads);
+    if (delta <= 0) delta = select_delta();
+    const int workers = std::clamp(_size / 64, 1, threads);
+    const bool has_heavy = _max_weight > delta;
+
+    constexpr int infinity = std::numeric_limits<int>::max();
+    std::vector<int> dist(_size, infinity);
+    // Pending distances lie within max_weight of the current bucket, so a circular array of
+    // max_weight / delta + 2 buckets covers them. The array is capped; vertices beyond it wait
+    // in a per-thread overflow list until the window reaches them.
+    constexpr std::size_t max_ring = std::size_t{1} << 12;
+    const std::size_t ring = std::min<std::size_t>(static_cast<std::size_t>(_max_weight) / delta + 2, max_ring);
+    constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+    // Entries are (vertex, distance when pushed); an entry whose distance no longer matches
+    // is stale, because the vertex was improved and pushed again.
+    using Entry = std::pair<int, int>;
+    struct Buckets {
+        std::vector<std::vector<Entry>> ring;
+        std::vector<Entry> overflow;
+        std::size_t overflow_min = none; ///< Lowest bucket pushed to overflow
+        std::vector<Entry> heavy;        ///< Heavy-arc relaxations deferred until the bucket settles
+    };
+    std::vector<Buckets> local(workers);
+    for (Buckets& buckets : local) buckets.ring.resize(ring);
+    std::vector<Entry> frontier{{start, 0}};
+    dist[start] = 0;
+    std::size_t bin = 0;
+    bool heavy = false, done = false;
+
+    // Lower dist[v] to candidate and push v into the bucket of its new distance.
+    auto relax = [&](Buckets& buckets, int v, int candidate) {
+        std::atomic_ref<int> dv(dist[v]);
+        int current = dv.load(std::memory_order_relaxed);
+        while (candidate < current) {
+            if (dv.compare_exchange_weak(current, candidate, std::memory_order_relaxed)) {
+                std::size_t target_bin = candidate / delta;
+                if (target_bin - bin < ring) {
+                    buckets.ring[target_bin % ring].emplace_back(v, candidate);
+                } else {
+                    buckets.overflow.emplace_back(v, candidate);
+                    buckets.overflow_min = std::min(buckets.overflow_min, target_bin);
+                }
+                return;
+            }
+        }
+    };
+
+    // Runs on one thread between phases and picks the next one.
+    auto next_phase = [&]() noexcept {
+        frontier.clear();
+        if (!heavy) {
+            // Light arcs may refill the current bucket; it is relaxed again until it stays empty.
+            for (Buckets& buckets : local) {
+                std::vector<Entry>& current = buckets.ring[bin % ring];
+                frontier.insert(frontier.end(), current.begin(), current.end());
+                current.clear();
+            }
+            if (!frontier.empty()) return;
+            if (has_heavy) {
+                heavy = true;
+                return;
+            }
+        }
+        heavy = false;
+
+        std::size_t next = none;
+        for (std::size_t b = bin; b < bin + ring && next == none; ++b) {
+            for (const Buckets& buckets : local) {
+                if (!buckets.ring[b % ring].empty()) {
+                    next = b;
+                    break;
+                }
+            }
+        }
+        for (const Buckets& buckets : local) next = std::min(next, buckets.overflow_min);
+        if (next == none) {
+            done = true;
+            return;
+        }
+        bin = next;
+        for (Buckets& buckets : local) {
+            if (buckets.overflow_min - bin >= ring) continue;
+            // Move overflow entries that entered the window and drop stale ones.
+            std::size_t kept = 0;
+            buckets.overflow_min = none;
+            for (const Entry& entry : buckets.overflow) {
+                if (dist[entry.first] != entry.second) continue;
+                std::size_t b = entry.second / delta;
+                if (b - bin < ring) {
+                    buckets.ring[b % ring].push_back(entry);
+                } else {
+                    buckets.overflow[kept++] = entry;
+                    buckets.overflow_min = std::min(buckets.overflow_min, b);
+                }
+            }
+            buckets.overflow.resize(kept);
+        }
+        for (Buckets& buckets : local) {
+            std::vector<Entry>& current = buckets.ring[bin % ring];
+            frontier.insert(frontier.end(), current.begin(), current.end());
+            current.clear();
+        }
+    };
+
+    // The workers live for the whole search; a barrier separates the phases.
+    std::barrier sync(workers, next_phase);
+    parallel_run(workers, [&](int worker) {
+        Buckets& buckets = local[worker];
+        while (!done) {
+            if (heavy) {
+                // Heavy arcs leave the bucket, so they are relaxed once, after it has settled.
+                for (auto [v, candidate] : buckets.heavy) relax(buckets, v, candidate);
+                buckets.heavy.clear();
+            } else {
+                const int n = static_cast<int>(frontier.size());
+                const int chunk = (n + workers - 1) / workers;
+                const int hi = std::min(n, (worker + 1) * chunk);
+                for (int i = worker * chunk; i < hi; ++i) {
+                    auto [u, du] = frontier[i];
+                    if (std::atomic_ref<int>(dist[u]).load(std::memory_order_relaxed) != du) continue;
+                    std::span<const int> targets = adj.neighbours(u);
+                    std::span<const int> weights = adj.weights(u);
+                    for (std::size_t e = 0; e < targets.size(); ++e) {
+                        int candidate = saturating_add(du, weights[e]);
+                        if (weights[e] <= delta) {
+                            relax(buckets, targets[e], candidate);
+                        } else {
+                            buckets.heavy.emplace_back(targets[e], candidate);
+                        }
+                    }
+                }
+            }
+            sync.arrive_and_wait();
+        }
+    });
+
+    return dist;
+}
+
+int WeightedGraph::select_delta() const {
+    const CsrAdjacency& adj = adjacency();
+    if (adj.arc_count() == 0 || _size == 0) return 1;
+
+    long double total = 0;
+    for (int w : adj.all_weights()) total += w;
+    long double mean = total / adj.arc_count();
+    long double average_degree = static_cast<long double>(adj.arc_count()) / _size;
+    long double delta = 2 * mean / std::max<long double>(1, average_degree);
+    return static_cast<int>(std::clamp<long double>(delta, 1, std::numeric_limits<int>::max()));
+}
+
+DistanceMatrix WeightedGraph::all_pairs_distances(int threads) const {
+    return floyd_warshall(adjacency(), _max_weight, threads);
+}
+
+ConnectedComponents WeightedGraph::connected_components(int threads) const {
+    return afforest_components(adjacency(), nullptr, threads);
+}
+
+std::vector<int> WeightedGraph::distance_table(std::span<const int> sources, std::span<const int> targets,
+                                               int threads) const {
+    for (int v : sources) {
+        if (v < 0 || v >= _size) throw std::out_of_range("Vertex index out of range");
+    }
+    std::vector<char> is_target(_size, 0);
+    int distinct_targets = 0;
+    for (int v : targets) {
+        if (v < 0 || v >= _size) throw std::out_of_range("Vertex index out of range");
+        if (!is_target[v]) {
+            is_target[v] = 1;
+            ++distinct_targets;
+        }
+    }
+
+    const CsrAdjacency& adj = adjacency();
+    const std::size_t columns = targets.size();
+    std::vector<int> table(sources.size() * columns, -1);
+    if (table.empty()) return table;
+
+    threads = resolve_thread_count(threads);
+    std::vector<SearchWorkspace> workspaces(std::min<std::size_t>(threads, sources.size()));
+
+    parallel_for(0, static_cast<int>(sources.size()), threads, [&](int worker, int lo, int hi) {
+        SearchWorkspace& workspace = workspaces[worker];
+        for (int row = lo; row < hi; ++row) {
+            workspace.begin(_size, std::numeric_limits<int>::max());
+            std::vector<int>& dist = workspace._distance[0];
+            std::vector<std::pair<int, int>>& heap = workspace._heap[0];
+
+            int start = sources[row];
+            workspace.touch(start);
+            dist[start] = 0;
+            heap.emplace_back(0, start);
+
+            int remaining = distinct_targets;
+            while (!heap.empty()) {
+                std::pop_heap(heap.begin(), heap.end(), std::greater<>());
+                auto [current_dist, current_vertex] = heap.back();
+                heap.pop_back();
+                if (current_dist > dist[current_vertex]) continue;
+                if (is_target[current_vertex] && --remaining == 0) break;
+
+                std::span<const int> out = adj.neighbours(current_vertex);
+                std::span<const int> weights = adj.weights(current_vertex);
+                for (std::size_t i = 0; i < out.size(); ++i) {
+                    int end = out[i];
+                    workspace.touch(end);
+                    int candidate = saturating_add(current_dist, weights[i]);
+                    if (candidate < dist[end]) {
+                        dist[end] = candidate;
+                        heap.emplace_back(dist[end], end);
+                        std::push_heap(heap.begin(), heap.end(), std::greater<>());
+                    }
+                }
+            }
+
+            int* cells = table.data() + row * columns;
+            for (std::size_t j = 0; j < columns; ++j) {
+                int d = workspace.distance(targets[j]);
+                cells[j] = d == std::numeric_limits<int>::max() ? -1 : d;
+            }
+        }
+    }, 1);
+
+    return table;
+}
+
+std::pair<std::vector<int>, std::vector<int>> WeightedGraph::nearest_source(std::span<const int> sources) const {
+    for (int v : sources) {
+        if (v < 0 || v >= _size) throw std::out_of_range("Vertex index out of range");
+    }
+
+    const CsrAdjacency& adj = adjacency();
+    std::vector<int> dist(_size, std::numeric_limits<int>::max());
+    std::vector<int> owner(_size, -1);
+    std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<>> pq;
+
+    for (int s : sources) {
+        if (dist[s] == 0) continue;
+        dist[s] = 0;
+        owner[s] = s;
+        pq.emplace(0, s);
+    }
+
+    while (!pq.empty()) {
+        auto [current_dist, current_vertex] = pq.top();
+        pq.pop();
+        if (current_dist > dist[current_vertex]) continue;
+
+        std::span<const int> targets = adj.neighbours(current_vertex);
+        std::span<const int> weights = adj.weights(current_vertex);
+        for (std::size_t i = 0; i < targets.size(); ++i) {
+            int end = targets[i];
+            int candidate = saturating_add(current_dist, weights[i]);
+            if (candidate < dist[end]) {
+                dist[end] = candidate;
+                owner[end] = owner[current_vertex];
+                pq.emplace(dist[end], end);
+            }
+        }
+    }
+
+    return {std::move(dist), std::move(owner)};
+}
+
+std::vector<WeightedGraph::Edge> WeightedGraph::edge_list() const {
+    const CsrAdjacency& adj = adjacency();
     std::vector<Edge> all_edges;
+    all_edges.reserve(adj.arc_count() / 2);
     for (int u = 0; u < _size; ++u) {
-        for (const auto& [v, w] : _adjacency_list[u]) {
-            if (u < v) { // Avoid duplicate edges to improve efficiency
-                all_edges.emplace_back(u, v, w);
+        std::span<const int> targets = adj.neighbours(u);
+        std::span<const int> weights = adj.weights(u);
+        for (std::size_t i = 0; i < targets.size(); ++i) {
+            if (u < targets[i]) { // Avoid duplicate edges to improve efficiency
+                all_edges.emplace_back(u, targets[i], weights[i]);
             }
         }
     }
+    return all_edges;
+}
+
+std::vector<WeightedGraph::Edge> WeightedGraph::kruskal_mst() const {
+    std::vector<Edge> all_edges = edge_list();
 
     std::vector<Edge> mst;
     UnionFind uf(_size);
@@ -101,41 +658,158 @@ std::vector<WeightedGraph::Edge> WeightedGraph::kruskal_mst() const {
         }
     }
 
-    return mst.size() == _size - 1 ? mst : std::vector<Edge>();
+    return mst.size() == static_cast<std::size_t>(_size) - 1 ? mst : std::vector<Edge>();
 }
 
-std::vector<WeightedGraph::Edge> WeightedGraph::prim_mst() const {
-    std::vector<Edge> mst;
-    std::vector<bool> visited(_size, false);
-    std::vector<int> key(_size, std::numeric_limits<int>::max());
-    std::vector<int> parent(_size, -1);
+namespace {
 
-    std::priority_queue<std::pair<int, int>,
-            std::vector<std::pair<int, int>>,
-            std::greater<>> pq;
+using Edge = WeightedGraph::Edge;
 
-    pq.emplace(0, 0);
-    key[0] = 0;
+/// Ranges of at most this many edges are sorted and scanned like plain Kruskal
+constexpr std::size_t filter_kruskal_base = 1 << 12;
+/// Ranges shorter than this are partitioned on the calling thread only
+constexpr int partition_grain = 1 << 15;
 
-    while (!pq.empty()) {
-        int u = pq.top().second;
-        pq.pop();
+/**
+ * @brief Stable partition of edges[lo, hi) so that edges satisfying pred come first
+ *
+ * Each worker flags and counts its chunk, the counts are turned into output offsets and the
+ * chunks are scattered into buffer and copied back, so no two threads write the same slot.
+ * parallel_for splits the range identically on every call, so both passes see the same chunks.
+ *
+ * @return std::size_t Index of the first edge that does not satisfy pred
+ */
+template<typename Pred>
+std::size_t parallel_partition(std::vector<Edge>& edges, std::vector<Edge>& buffer, std::size_t lo,
+                               std::size_t hi, int threads, Pred pred) {
+    const int n = static_cast<int>(hi - lo);
+    std::vector<char> flags(n);
+    std::vector<int> selected(threads + 1, 0);
+    int workers = parallel_for(0, n, threads, [&](int worker, int begin, int end) {
+        int count = 0;
+        for (int i = begin; i < end; ++i) {
+            flags[i] = pred(edges[lo + i]);
+            count += flags[i];
+        }
+        selected[worker + 1] = count;
+    }, partition_grain);
 
-        if (visited[u]) continue;
-        visited[u] = true;
+    for (int w = 0; w < workers; ++w) selected[w + 1] += selected[w];
+    const int total = selected[workers];
 
-        if (parent[u] != -1) {
-            mst.emplace_back(parent[u], u, key[u]);
+    parallel_for(0, n, threads, [&](int worker, int begin, int end) {
+        int first = selected[worker];
+        int second = total + (begin - selected[worker]);
+        for (int i = begin; i < end; ++i) {
+            buffer[lo + (flags[i] ? first++ : second++)] = edges[lo + i];
         }
+    }, partition_grain);
+    parallel_for(0, n, threads, [&](int, int begin, int end) {
+        std::copy(buffer.begin() + lo + begin, buffer.begin() + lo + end, edges.begin() + lo + begin);
+    }, partition_grain);
+
+    return lo + total;
+}
+
+/**
+ * @brief Add the MST edges of edges[lo, hi) to mst, given that every lighter edge was already processed
+ */
+void filter_kruskal(std::vector<Edge>& edges, std::vector<Edge>& buffer, std::size_t lo, std::size_t hi,
+                    UnionFind& uf, std::vector<Edge>& mst, int threads) {
+    if (lo == hi || uf.count() == 1) return;
 
-        for (const auto& [v, weight] : _adjacency_list[u]) {
-            if (!visited[v] && weight < key[v]) {
-                parent[v] = u;
-                key[v] = weight;
-                pq.emplace(key[v], v);
+    auto scan = [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            const Edge& edge = edges[i];
+            if (uf.find(edge.u) != uf.find(edge.v)) {
+                uf.unite(edge.u, edge.v);
+                mst.push_back(edge);
             }
         }
+    };
+
+    if (hi - lo <= filter_kruskal_base) {
+        std::sort(edges.begin() + lo, edges.begin() + hi);
+        scan(lo, hi);
+        return;
     }
 
-    return mst.size() == _size - 1 ? mst : std::vector<Edge>();
-}
\ No newline at end of file
+    // Median of three weights spread over the range
+    std::size_t step = (hi - lo) / 4;
+    int a = edges[lo + step].w, b = edges[lo + 2 * step].w, c = edges[lo + 3 * step].w;
+    int pivot = std::max(std::min(a, b), std::min(std::max(a, b), c));
+
+    std::size_t split = parallel_partition(edges, buffer, lo, hi, threads,
+                                           [pivot](const Edge& e) { return e.w <= pivot; });
+    if (split == hi) {
+        // Nothing is heavier than the pivot: peel off the edges equal to it instead
+        split = parallel_partition(edges, buffer, lo, hi, threads,
+                                   [pivot](const Edge& e) { return e.w < pivot; });
+        if (split == lo) { // Every edge weighs exactly pivot, so any order is sorted
+            scan(lo, hi);
+            return;
+        }
+    }
+
+    filter_kruskal(edges, buffer, lo, split, uf, mst, threads);
+    if (uf.count() == 1) return;
+    std::size_t end = parallel_partition(edges, buffer, split, hi, threads, [&uf](const Edge& e) {
+        return uf.find_root(e.u) != uf.find_root(e.v);
+    });
+    filter_kruskal(edges, buffer, split, end, uf, mst, threads);
+}
+
+} // namespace
+
+std::vector<WeightedGraph::Edge> WeightedGraph::filter_kruskal_mst(int threads) const {
+    std::vector<Edge> all_edges = edge_list();
+    std::vector<Edge> buffer(all_edges);
+    std::vector<Edge> mst;
+    UnionFind uf(_size);
+
+    filter_kruskal(all_edges, buffer, 0, all_edges.size(), uf, mst, resolve_thread_count(threads));
+
+    return mst.size() == static_cast<std::size_t>(_size) - 1 ? mst : std::vector<Edge>();
+}
+
+std::vector<WeightedGraph::Edge> WeightedGraph::prim_mst() const {
+    return prim_mst<BinaryHeapQueue>();
+}
+
+std::vector<WeightedGraph::Edge> WeightedGraph::boruvka_mst(int threads) const {
+    const CsrAdjacency& adj = adjacency();
+    threads = resolve_thread_count(threads);
+
+    // Gather every undirected edge once (u < v) into flat arrays, counting per vertex first so
+    // the copy can run in parallel.
+    std::vector<std::size_t> first(_size + 1, 0);
+    parallel_for(0, _size, threads, [&](int, int lo, int hi) {
+        for (int u = lo; u < hi; ++u) {
+            std::span<const int> targets = adj.neighbours(u);
+            first[u + 1] = std::count_if(targets.begin(), targets.end(), [u](int v) { return u < v; });
+        }
+    });
+    for (int u = 0; u < _size; ++u) first[u + 1] += first[u];
+
+    std::vector<int> from(first[_size]), to(first[_size]), edge_weights(first[_size]);
+    parallel_for(0, _size, threads, [&](int, int lo, int hi) {
+        for (int u = lo; u < hi; ++u) {
+            std::span<const int> targets = adj.neighbours(u);
+            std::span<const int> weights = adj.weights(u);
+            std::size_t slot = first[u];
+            for (std::size_t i = 0; i < targets.size(); ++i) {
+                if (u < targets[i]) {
+                    from[slot] = u;
+                    to[slot] = targets[i];
+                    edge_weights[slot++] = weights[i];
+                }
+            }
+        }
+    });
+
+    std::vector<Edge> forest;
+    for (std::size_t e : boruvka_forest(_size, from, to, edge_weights, threads)) {
+        forest.emplace_back(from[e], to[e], edge_weights[e]);
+    }
+    return forest;
+}
@@ -2,18 +2,38 @@
 #define WEIGHTED_GRAPH_H
 
 #include <vector>
+#include <string>
 #include <utility>
 #include <limits>
+#include <span>
+#include <functional>
+#include <stdexcept>
+#include "src/graph/csr.h"
+#include "src/graph/edge_list.h"
+#include "src/graph/reorder.h"
+#include "src/graph/priority_queues.h"
+#include "src/graph/search_workspace.h"
+#include "src/graph/saturating.h"
+#include "src/graph/weighted_search.h"
+#include "src/graph/floyd_warshall.h"
+#include "src/graph/connected_components.h"
 
 /**
  * @class WeightedGraph
  * @brief A class representing a weighted graph.
  *
- * This class implements a weighted graph using an adjacency list representation.
- * It provides methods for adding weighted edges, finding shortest paths using
- * Dijkstra's algorithm, and finding Minimum Spanning Trees using Kruskal's and
+ * This class implements an undirected weighted graph on top of a compressed-sparse-row
+ * (CSR) adjacency with contiguous target and weight arrays. Edges added with add_edge()
+ * are staged and merged into the CSR arrays by finalize(); algorithms finalize lazily on
+ * first use, so finalize() only has to be called explicitly before a graph is shared
+ * between threads. It provides methods for adding weighted edges, finding shortest paths
+ * using Dijkstra's algorithm, and finding Minimum Spanning Trees using Kruskal's and
  * Prim's algorithms.
  *
+ * Large graphs are best built with add_edges(), which fills the CSR arrays from a whole batch
+ * at once, or by announcing the final degrees with reserve_degrees() so that add_edge()
+ * writes straight into the CSR arrays instead of staging.
+ *
  * @note Vertices are zero-indexed.
  */
 class WeightedGraph {
@@ -34,7 +54,11 @@ public:
 
 private:
     int _size; ///< Number of vertices in the graph
-    std::vector<std::vector<std::pair<int, int>>> _adjacency_list; ///< Adjacency list representation (vertex, weight)
+    int _max_weight = 0; ///< Largest weight added so far
+    mutable CsrAdjacency _csr; ///< Frozen CSR adjacency (both directions of every edge)
+    mutable std::vector<CsrAdjacency::Arc> _pending; ///< Arcs added since the last finalize
+
+    WeightedGraph(CsrAdjacency csr, int max_weight);
 
 public:
     /**
@@ -52,6 +76,117 @@ public:
      */
     void add_edge(int from, int to, int weight);
 
+    /**
+     * @brief Add a batch of weighted edges, filling the CSR adjacency in one pass
+     *
+     * The result is the same as calling add_edge() for every edge in order, but the arcs are
+     * scattered from the batch straight into the CSR arrays by a parallel counting sort (see
+     * CsrAdjacency::append_edges()), without a staging copy. The batch is validated first, so
+     * on error the graph is left unchanged.
+     *
+     * @param edges Edges to add
+     * @param threads Number of worker threads (non-positive selects hardware concurrency)
+     * @throw std::out_of_range if any vertex is out of range
+     * @throw std::invalid_argument if any weight is negative
+     */
+    void add_edges(std::span<const Edge> edges, int threads = 0);
+
+    /**
+     * @brief Reserve staging room for a number of further add_edge() calls
+     * @param edges Number of edges about to be added
+     */
+    void reserve_edges(std::size_t edges);
+
+    /**
+     * @brief Announce how many further edges each vertex will receive
+     *
+     * Opens that much room at the end of every CSR row, so subsequent add_edge() calls write
+     * their arcs in place instead of staging them. Edges beyond the hint are staged as usual,
+     * and the room is closed (unused parts released) the next time the adjacency is read.
+     *
+     * @param degrees Number of further incident edges per vertex (a self-loop counts twice)
+     * @throw std::invalid_argument if degrees does not hold one non-negative entry per vertex
+     */
+    void reserve_degrees(std::span<const int> degrees);
+
+    /**
+     * @brief Merge all staged edges into the CSR adjacency and release the staging buffer
+     */
+    void finalize();
+
+    /**
+     * @brief Check whether every added edge has been merged into the CSR adjacency
+     * @return bool True if no edges are staged and no reserved room is open
+     */
+    [[nodiscard]] bool is_finalized() const { return _pending.empty() && !_csr.has_gaps(); }
+
+    /**
+     * @brief Write the graph to a binary CSR file (see graph_file.h)
+     * @param filename Destination path
+     * @throw std::runtime_error if the file cannot be written
+     */
+    void save(const std::string& filename) const;
+
+    /**
+     * @brief Load a graph written by save() by memory-mapping the file
+     *
+     * The CSR arrays are used in place, without copying or parsing, so loading costs little
+     * more than validating the file. Edges added to a loaded graph are merged into a private
+     * copy of the arrays; the file is never modified.
+     *
+     * @param filename Source path
+     * @param verify Whether to validate the payload checksum and contents, not just the header
+     * @return WeightedGraph Graph backed by the mapped file
+     * @throw std::runtime_error if the file cannot be read or does not hold a WeightedGraph
+     */
+    [[nodiscard]] static WeightedGraph load(const std::string& filename, bool verify = true);
+
+    /**
+     * @brief Build a graph from an edge-list file, parsing and filling the CSR in parallel
+     *
+     * See read_edge_list() for the formats. Every edge u v w becomes an undirected edge, in
+     * file order, exactly as if add_edge() had been called for each line.
+     *
+     * @param filename Source path
+     * @param format File format
+     * @param vertices Number of vertices; non-positive infers it from the largest vertex id
+     * @param threads Number of worker threads (non-positive selects hardware concurrency)
+     * @return WeightedGraph Finalized graph
+     * @throw std::runtime_error if the file cannot be read or is malformed
+     * @throw std::out_of_range if a vertex id is out of range
+     * @throw std::invalid_argument if a weight is negative
+     * @throw std::overflow_error if the file holds more than INT_MAX / 2 edges (each becomes two arcs)
+     */
+    [[nodiscard]] static WeightedGraph from_edge_list(const std::string& filename, EdgeListFormat format,
+                                                      int vertices = 0, int threads = 0);
+
+    /**
+     * @brief Relabel the vertices into a cache-friendly layout
+     *
+     * Input vertex ids are often arbitrary, so consecutive neighbour accesses land far apart in
+     * memory. The returned graph numbers vertices so that those visited together sit close
+     * together (see VertexOrdering; searches follow the edges), which speeds up
+     * traversals on large graphs. Results computed on the new graph are mapped back through
+     * the returned permutation: vertex v of this graph is vertex permutation[v] of the result.
+     *
+     * @param ordering Layout to use
+     * @param threads Number of worker threads for rebuilding the adjacency (non-positive
+     *                selects hardware concurrency)
+     * @return std::pair<WeightedGraph, std::vector<int>>
+     *         First: relabelled graph
+     *         Second: new id of every vertex
+     */
+    [[nodiscard]] std::pair<WeightedGraph, std::vector<int>> reordered(VertexOrdering ordering, int threads = 0) const;
+
+    /**
+     * @brief Relabel the vertices with a given permutation
+     * @param new_id New id of every vertex
+     * @param threads Number of worker threads (non-positive selects hardware concurrency)
+     * @return WeightedGraph Graph in which vertex v of this graph is vertex new_id[v]
+     * @throw std::invalid_argument if new_id is not a permutation of the vertices
+     */
+    [[nodiscard]] WeightedGraph relabelled(std::span<const int> new_id, int threads = 0) const;
+
     /**
      * @brief Perform Dijkstra's algorithm to find shortest paths from a start vertex
      * @param start Starting vertex
@@ -60,6 +195,35 @@ public:
      */
     [[nodiscard]] std::vector<int> dijkstra(int start) const;
 
+    /**
+     * @brief Perform Dijkstra's algorithm with a chosen priority-queue policy
+     *
+     * Queue is one of the policies in priority_queues.h (BinaryHeapQueue, DialBucketQueue,
+     * RadixHeapQueue, IndexedDaryHeapQueue<D>) or any type with the same interface. With
+     * IndexedDaryHeapQueue every vertex is queued at most once (decrease-key instead of
+     * lazy duplicates).
+     *
+     * @tparam Queue Priority-queue policy
+     * @param start Starting vertex
+     * @return std::vector<int> Shortest distances from start to all other vertices
+     * @throw std::out_of_range if start vertex is out of range
+     */
+    template<typename Queue>
+    [[nodiscard]] std::vector<int> dijkstra(int start) const;
+
+    /**
+     * @brief Perform Dijkstra's algorithm from a start vertex reusing a caller-owned workspace
+     *
+     * Distances and parents are left in the workspace (see SearchWorkspace::distance() and
+     * SearchWorkspace::parent()); untouched vertices report std::numeric_limits<int>::max().
+     *
+     * @param start Starting vertex
+     * @param workspace Workspace receiving the result
+     * @return std::span<const int> Reached vertices (valid until the next search)
+     * @throw std::out_of_range if start vertex is out of range
+     */
+    std::span<const int> dijkstra(int start, SearchWorkspace& workspace) const;
+
     /**
      * @brief Perform Dijkstra's algorithm to find shortest path between two vertices
      * @param start Starting vertex
@@ -69,6 +233,172 @@ public:
      */
     [[nodiscard]] int dijkstra(int start, int end) const;
 
+    /**
+     * @brief Perform Dijkstra's algorithm between two vertices reusing a caller-owned workspace
+     * @param start Starting vertex
+     * @param end Ending vertex
+     * @param workspace Workspace used for the search; costs O(touched vertices) to reuse
+     * @return int Shortest distance from start to end (-1 if no path exists)
+     * @throw std::out_of_range if either vertex is out of range
+     */
+    [[nodiscard]] int dijkstra(int start, int end, SearchWorkspace& workspace) const;
+
+    /**
+     * @brief Find the shortest distance between two vertices with bidirectional Dijkstra
+     *
+     * Runs one search from start and one from end, always advancing the side whose queue has
+     * the smaller minimum, and stops as soon as the two minima sum to at least the best
+     * start-end connection seen so far. Typically settles far fewer vertices than
+     * dijkstra(start, end).
+     *
+     * @param start Starting vertex
+     * @param end Ending vertex
+     * @return int Shortest distance from start to end (-1 if no path exists)
+     * @throw std::out_of_range if either vertex is out of range
+     */
+    [[nodiscard]] int bidirectional_dijkstra(int start, int end) const;
+
+    /**
+     * @brief Find the shortest distance between two vertices with bidirectional Dijkstra
+     *        reusing a caller-owned workspace
+     * @param start Starting vertex
+     * @param end Ending vertex
+     * @param workspace Workspace used for the search; costs O(touched vertices) to reuse
+     * @return int Shortest distance from start to end (-1 if no path exists)
+     * @throw std::out_of_range if either vertex is out of range
+     */
+    [[nodiscard]] int bidirectional_dijkstra(int start, int end, SearchWorkspace& workspace) const;
+
+    /**
+     * @brief Find a shortest path between two vertices with bidirectional Dijkstra
+     * @param start Starting vertex
+     * @param end Ending vertex
+     * @return std::pair<int, std::vector<int>>
+     *         First: shortest distance from start to end (-1 if no path exists)
+     *         Second: vertices of the path from start to end (empty if no path exists)
+     * @throw std::out_of_range if either vertex is out of range
+     */
+    [[nodiscard]] std::pair<int, std::vector<int>> bidirectional_dijkstra_path(int start, int end) const;
+
+    /**
+     * @brief Find the shortest distance between two vertices with A* search
+     *
+     * Vertices are expanded in order of g(v) + heuristic(v), where g is the distance from start.
+     * The heuristic must be admissible (never overestimate the distance from v to end) for the
+     * result to be exact; a vertex is re-expanded if a shorter route to it is found later, so
+     * consistency is not required. A heuristic returning 0 reduces to dijkstra(start, end).
+     *
+     * @param start Starting vertex
+     * @param end Ending vertex
+     * @param heuristic Lower bound on the distance from a vertex to end
+     * @return int Shortest distance from start to end (-1 if no path exists)
+     * @throw std::out_of_range if either vertex is out of range
+     */
+    [[nodiscard]] int a_star(int start, int end, const std::function<int(int)>& heuristic) const;
+
+    /**
+     * @brief Find the shortest distance between two vertices with A* search reusing a
+     *        caller-owned workspace
+     * @param start Starting vertex
+     * @param end Ending vertex
+     * @param heuristic Lower bound on the distance from a vertex to end
+     * @param workspace Workspace used for the search; costs O(touched vertices) to reuse
+     * @return int Shortest distance from start to end (-1 if no path exists)
+     * @throw std::out_of_range if either vertex is out of range
+     */
+    [[nodiscard]] int a_star(int start, int end, const std::function<int(int)>& heuristic,
+                             SearchWorkspace& workspace) const;
+
+    /**
+     * @brief Find a shortest path between two vertices with A* search
+     * @param start Starting vertex
+     * @param end Ending vertex
+     * @param heuristic Lower bound on the distance from a vertex to end
+     * @return std::pair<int, std::vector<int>>
+     *         First: shortest distance from start to end (-1 if no path exists)
+     *         Second: vertices of the path from start to end (empty if no path exists)
+     * @throw std::out_of_range if either vertex is out of range
+     */
+    [[nodiscard]] std::pair<int, std::vector<int>> a_star_path(int start, int end,
+                                                               const std::function<int(int)>& heuristic) const;
+
+    /**
+     * @brief Compute single-source shortest paths with parallel delta-stepping
+     *
+     * Tentative distances are kept in buckets of width delta. All vertices of the lowest
+     * non-empty bucket are relaxed concurrently; every thread pushes improved vertices into its
+     * own buckets and distances are lowered with an atomic compare-and-swap, so vertices may be
+     * re-relaxed but the final distances equal those of dijkstra(start). Light arcs (weight at
+     * most delta) are relaxed until the bucket stays empty; heavy arcs cannot land in it and
+     * are relaxed once, after it has settled. The worker threads live for the whole search and
+     * meet at a barrier between phases. Buckets are reused circularly over a window of about
+     * max_weight() / delta, so memory does not grow with the largest distance.
+     *
+     * @param start Starting vertex
+     * @param threads Number of worker threads (non-positive selects hardware concurrency)
+     * @param delta Bucket width (non-positive selects one from the weight distribution,
+     *              see select_delta())
+     * @return std::vector<int> Shortest distances from start to all other vertices
+     *         (std::numeric_limits<int>::max() for unreachable vertices)
+     * @throw std::out_of_range if start vertex is out of range
+     */
+    [[nodiscard]] std::vector<int> delta_stepping(int start, int threads = 0, int delta = 0) const;
+
+    /**
+     * @brief Pick a delta-stepping bucket width from the weight distribution
+     *
+     * Uses Meyer and Sanders' delta = L / d for weights spread over [0, L] and average degree d,
+     * estimating L as twice the mean weight so that a few very heavy edges do not inflate it.
+     *
+     * @return int Suggested bucket width (at least 1)
+     */
+    [[nodiscard]] int select_delta() const;
+
+    /**
+     * @brief Compute a many-to-many shortest distance table
+     *
+     * Runs one Dijkstra search per source, distributing the sources over worker threads that
+     * each reuse their own SearchWorkspace, so no O(V) array is allocated per source. A search
+     * stops as soon as every target has been settled.
+     *
+     * @param sources Source vertices (rows of the table)
+     * @param targets Target vertices (columns of the table)
+     * @param threads Number of worker threads (non-positive selects hardware concurrency)
+     * @return std::vector<int> Dense row-major matrix of sources.size() x targets.size() entries;
+     *         entry i * targets.size() + j is the distance from sources[i] to targets[j]
+     *         (-1 if no path exists)
+     * @throw std::out_of_range if any source or target vertex is out of range
+     */
+    [[nodiscard]] std::vector<int> distance_table(std::span<const int> sources, std::span<const int> targets,
+                                                  int threads = 0) const;
+
+    /**
+     * @brief Compute all-pairs shortest distances with blocked Floyd–Warshall
+     *
+     * Cost is O(V^3) regardless of the edge count, so this beats one Dijkstra per vertex
+     * (distance_table()) on dense graphs; see floyd_warshall() for the tiling and SIMD
+     * details. Needs V * V ints of memory.
+     *
+     * @param threads Number of worker threads (non-positive selects hardware concurrency)
+     * @return DistanceMatrix Contiguous V x V matrix (-1 where no path exists)
+     */
+    [[nodiscard]] DistanceMatrix all_pairs_distances(int threads = 0) const;
+
+    /**
+     * @brief Find the nearest source of every vertex with a single multi-source Dijkstra
+     *
+     * Equivalent to Dijkstra from a virtual super-source joined to every source by a
+     * zero-weight edge. Each vertex inherits the owner of the vertex it was reached from, which
+     * partitions the graph into shortest-path Voronoi cells.
+     *
+     * @param sources Source vertices; duplicates are allowed
+     * @return std::pair<std::vector<int>, std::vector<int>>
+     *         First: distance to the nearest source (std::numeric_limits<int>::max() if none is reachable)
+     *         Second: nearest source vertex (-1 if none is reachable)
+     * @throw std::out_of_range if any source vertex is out of range
+     */
+    [[nodiscard]] std::pair<std::vector<int>, std::vector<int>> nearest_source(std::span<const int> sources) const;
+
     /**
      * @brief Perform Kruskal's algorithm to find Minimum Spanning Tree
      * @return std::vector<Edge> Edges in the Minimum Spanning Tree
@@ -81,6 +411,56 @@ public:
      */
     [[nodiscard]] std::vector<Edge> prim_mst() const;
 
+    /**
+     * @brief Perform Filter-Kruskal to find Minimum Spanning Tree
+     *
+     * Partitions the edges around a pivot weight and recurses into the light half first. The
+     * heavy half is then filtered, dropping edges whose endpoints the light half already
+     * connected, before it is processed, so on dense graphs most heavy edges are discarded
+     * without ever being sorted. Partitioning and filtering run in parallel on large ranges.
+     *
+     * @param threads Number of worker threads (non-positive selects hardware concurrency)
+     * @return std::vector<Edge> Edges in the Minimum Spanning Tree (empty if the graph is disconnected)
+     */
+    [[nodiscard]] std::vector<Edge> filter_kruskal_mst(int threads = 0) const;
+
+    /**
+     * @brief Find a minimum spanning forest with parallel Borůvka
+     *
+     * Unlike kruskal_mst() and prim_mst(), a disconnected graph yields a minimum spanning
+     * forest (one tree per connected component) instead of an empty vector.
+     *
+     * @param threads Number of worker threads (non-positive selects hardware concurrency)
+     * @return std::vector<Edge> Edges of the minimum spanning forest, with u < v
+     */
+    [[nodiscard]] std::vector<Edge> boruvka_mst(int threads = 0) const;
+
+    /**
+     * @brief Find the connected components with parallel Afforest (see afforest_components())
+     * @param threads Number of worker threads (non-positive selects hardware concurrency)
+     * @return ConnectedComponents Component of each vertex, numbered by smallest vertex, and
+     *         the size of each component
+     */
+    [[nodiscard]] ConnectedComponents connected_components(int threads = 0) const;
+
+    /**
+     * @brief Perform Prim's algorithm with a chosen priority-queue policy
+     *
+     * Prim's keys are edge weights and do not grow monotonically, so monotone-only policies
+     * such as RadixHeapQueue are rejected at compile time.
+     *
+     * @tparam Queue Priority-queue policy
+     * @return std::vector<Edge> Edges in the Minimum Spanning Tree
+     */
+    template<typename Queue>
+    [[nodiscard]] std::vector<Edge> prim_mst() const;
+
+    /**
+     * @brief Get the largest edge weight in the graph
+     * @return int Largest weight (0 for a graph without edges)
+     */
+    [[nodiscard]] int max_weight() const { return _max_weight; }
+
     /**
      * @brief Get the number of vertices in the graph
      * @return int Number of vertices
@@ -88,10 +468,76 @@ public:
     [[nodiscard]] int size() const { return _size; }
 
     /**
-     * @brief Get the adjacency list representation of the graph
-     * @return const std::vector<std::vector<std::pair<int, int>>>& Adjacency list
+     * @brief Get the neighbours of a vertex
+     * @param v Vertex
+     * @return std::span<const int> Contiguous view of the neighbours of v
+     */
+    [[nodiscard]] std::span<const int> neighbours(int v) const { return adjacency().neighbours(v); }
+
+    /**
+     * @brief Get the weights of the edges incident to a vertex, parallel to neighbours(v)
+     * @param v Vertex
+     * @return std::span<const int> Contiguous view of the edge weights
      */
-    [[nodiscard]] const std::vector<std::vector<std::pair<int, int>>>& get_adj_list() const { return _adjacency_list; }
+    [[nodiscard]] std::span<const int> neighbour_weights(int v) const { return adjacency().weights(v); }
+
+    /**
+     * @brief Get a span-based view of the adjacency of the graph
+     * @return WeightedNeighbourView View whose operator[](v) yields (vertex, weight) pairs
+     */
+    [[nodiscard]] WeightedNeighbourView get_adj_list() const { return WeightedNeighbourView(adjacency()); }
+
+private:
+    /**
+     * @brief Get the CSR adjacency, merging staged arcs first if necessary
+     * @return const CsrAdjacency& Up-to-date adjacency
+     */
+    const CsrAdjacency& adjacency() const;
+
+    /**
+     * @brief Collect every undirected edge once, as (u, v, w) with u < v
+     * @return std::vector<Edge> Edge list in CSR order
+     */
+    std::vector<Edge> edge_list() const;
+
+    /**
+     * @brief Shared implementation of bidirectional_dijkstra and bidirectional_dijkstra_path
+     * @param start Starting vertex
+     * @param end Ending vertex
+     * @param workspace Workspace holding both search frontiers
+     * @param path If not null, receives the vertices of the shortest path
+     * @return int Shortest distance (-1 if no path exists)
+     */
+    int bidirectional_search(int start, int end, SearchWorkspace& workspace, std::vector<int>* path) const;
+
+    /**
+     * @brief Shared implementation of a_star and a_star_path
+     * @param start Starting vertex
+     * @param end Ending vertex
+     * @param heuristic Lower bound on the distance from a vertex to end
+     * @param workspace Workspace holding the search frontier
+     * @param path If not null, receives the vertices of the shortest path
+     * @return int Shortest distance (-1 if no path exists)
+     */
+    int a_star_search(int start, int end, const std::function<int(int)>& heuristic,
+                      SearchWorkspace& workspace, std::vector<int>* path) const;
 };
 
+template<typename Queue>
+std::vector<int> WeightedGraph::dijkstra(int start) const {
+    if (start < 0 || start >= _size) {
+        throw std::out_of_range("Start vertex index out of range");
+    }
+    return dijkstra_distances<int, Queue>(adjacency(), start, _max_weight);
+}
+
+template<typename Queue>
+std::vector<WeightedGraph::Edge> WeightedGraph::prim_mst() const {
+    std::vector<Edge> mst;
+    prim_tree<int, Queue>(adjacency(), _max_weight, [&](int parent, int u, int weight) {
+        mst.emplace_back(parent, u, weight);
+    });
+    return mst.size() == static_cast<std::size_t>(_size) - 1 ? mst : std::vector<Edge>();
+}
+
 #endif // WEIGHTED_GRAPH_H
\ No newline at end of file
@@ -0,0 +1,111 @@
+#ifndef WEIGHTED_SEARCH_H
+#define WEIGHTED_SEARCH_H
+
+#include <vector>
+#include <limits>
+#include <cstddef>
+#include "src/graph/saturating.h"
+
+/**
+ * @brief Searches shared by the weighted graph representations
+ *
+ * Each template works on any adjacency that offers size(), neighbours(v) and weights(v) plus
+ * index_type and weight_type, such as CsrAdjacency and TypedCsrAdjacency, so WeightedGraph
+ * and TypedWeightedGraph run exactly the same algorithm. Queue is a policy from
+ * priority_queues.h keyed by Distance (or Key). Callers validate the start vertex.
+ */
+
+/**
+ * @brief Dijkstra's algorithm from a start vertex
+ * @tparam Distance Type distances are accumulated in (with saturating addition)
+ * @tparam Queue Priority-queue policy
+ * @param adjacency Graph adjacency
+ * @param start Starting vertex
+ * @param weight_bound Largest weight, passed to Queue::reset()
+ * @return std::vector<Distance> Shortest distances (max of Distance for unreachable vertices)
+ */
+template<typename Distance, typename Queue, typename Adjacency>
+std::vector<Distance> dijkstra_distances(const Adjacency& adjacency, typename Adjacency::index_type start,
+                                         int weight_bound) {
+    using Vertex = typename Adjacency::index_type;
+    const Vertex n = adjacency.size();
+    std::vector<Distance> dist(n, std::numeric_limits<Distance>::max());
+    std::vector<bool> visited(n, false);
+    Queue pq;
+    pq.reset(n, weight_bound);
+
+    pq.push(Distance{0}, start);
+    dist[start] = 0;
+
+    while (!pq.empty()) {
+        Vertex current_vertex = pq.pop().second;
+
+        if (visited[current_vertex]) continue;
+        visited[current_vertex] = true;
+
+        auto targets = adjacency.neighbours(current_vertex);
+        auto weights = adjacency.weights(current_vertex);
+        for (std::size_t i = 0; i < targets.size(); ++i) {
+            Vertex end = targets[i];
+            Distance candidate = saturating_add(dist[current_vertex], static_cast<Distance>(weights[i]));
+            if (!visited[end] && candidate < dist[end]) {
+                dist[end] = candidate;
+                pq.push(candidate, end);
+            }
+        }
+    }
+
+    return dist;
+}
+
+/**
+ * @brief Prim's algorithm grown from vertex 0
+ * @tparam Key Queue key type the edge weights are converted to
+ * @tparam Queue Priority-queue policy accepting non-monotone keys
+ * @param adjacency Graph adjacency
+ * @param weight_bound Largest weight, passed to Queue::reset()
+ * @param emit Called as emit(parent, vertex, weight) for every tree edge, in the order the
+ *             vertices join the tree
+ */
+template<typename Key, typename Queue, typename Adjacency, typename Emit>
+void prim_tree(const Adjacency& adjacency, int weight_bound, Emit&& emit) {
+    using Vertex = typename Adjacency::index_type;
+    using Weight = typename Adjacency::weight_type;
+    static_assert(!Queue::monotone_only, "Prim's algorithm needs a queue that accepts non-monotone keys");
+
+    const Vertex n = adjacency.size();
+    if (n == 0) return;
+    constexpr Vertex none = std::numeric_limits<Vertex>::max();
+    std::vector<bool> visited(n, false);
+    std::vector<Weight> key(n, std::numeric_limits<Weight>::max());
+    std::vector<Vertex> parent(n, none);
+    Queue pq;
+    pq.reset(n, weight_bound);
+
+    pq.push(Key{0}, Vertex{0});
+    key[0] = 0;
+
+    while (!pq.empty()) {
+        Vertex u = pq.pop().second;
+
+        if (visited[u]) continue;
+        visited[u] = true;
+
+        if (parent[u] != none) {
+            emit(parent[u], u, key[u]);
+        }
+
+        auto targets = adjacency.neighbours(u);
+        auto weights = adjacency.weights(u);
+        for (std::size_t i = 0; i < targets.size(); ++i) {
+            Vertex v = targets[i];
+            if (!visited[v] && (parent[v] == none || weights[i] < key[v])) {
+                parent[v] = u;
+                key[v] = weights[i];
+                pq.push(static_cast<Key>(key[v]), v);
+            }
+        }
+    }
+}
+
+#endif // WEIGHTED_SEARCH_H
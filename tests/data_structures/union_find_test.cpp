@@ -89,4 +89,19 @@ TEST_F(UnionFindTest, PathCompression) {
     }
 
     EXPECT_EQ(uf->count(), 1);
-}
\ No newline at end of file
+}
+
+
+TEST_F(UnionFindTest, FindRootMatchesFind) {
+    uf->unite(0, 1);
+    uf->unite(2, 3);
+    uf->unite(1, 3);
+    uf->unite(5, 6);
+
+    const UnionFind& view = *uf;
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ(view.find_root(i), uf->find(i));
+    }
+    EXPECT_EQ(view.find_root(3), view.find_root(0));
+    EXPECT_NE(view.find_root(4), view.find_root(5));
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include "src/graph/compressed_graph.h"
+#include "src/graph/unweighted_graph.h"
+#include "tests/test_utils.h"
+#include <cstdio>
+#include <numeric>
+#include <vector>
+
+class CompressedGraphTest : public ::testing::Test {
+protected:
+    /**
+     * Same graph with sorted neighbour lists, the order CompressedGraph visits them in.
+     */
+    static UnweightedGraph sorted(const UnweightedGraph& g) {
+        std::vector<int> identity(g.size());
+        std::iota(identity.begin(), identity.end(), 0);
+        return g.relabelled(identity);
+    }
+};
+
+TEST_F(CompressedGraphTest, NeighboursRoundTrip) {
+    UnweightedGraph g(6);
+    g.add_edge(3, 5);
+    g.add_edge(3, 0);
+    g.add_edge(3, 5);
+    g.add_edge(3, 1);
+    g.add_edge(5, 4);
+    g.add_edge(0, 2);
+
+    CompressedGraph c = g.compressed();
+    EXPECT_EQ(c.size(), 6);
+    EXPECT_EQ(c.edge_count(), 6);
+    EXPECT_EQ(c.neighbours(3), std::vector<int>({0, 1, 5, 5}));
+    EXPECT_EQ(c.neighbours(5), std::vector<int>({4}));
+    EXPECT_TRUE(c.neighbours(2).empty());
+    EXPECT_THROW(auto bad = c.neighbours(6), std::out_of_range);
+}
+
+TEST_F(CompressedGraphTest, LargeGapsUseMultiByteVarints) {
+    const int n = 1 << 22;
+    UnweightedGraph g(n);
+    g.add_edge(0, n - 1);
+    g.add_edge(0, 1 << 14);
+    g.add_edge(n - 1, 0);
+    g.add_edge(n / 2, 3);
+    CompressedGraph c = g.compressed(2);
+    EXPECT_EQ(c.neighbours(0), std::vector<int>({1 << 14, n - 1}));
+    EXPECT_EQ(c.neighbours(n - 1), std::vector<int>({0}));
+    EXPECT_EQ(c.neighbours(n / 2), std::vector<int>({3}));
+}
+
+TEST_F(CompressedGraphTest, TraversalsMatchUncompressed) {
+    UnweightedGraph g = sorted(testutil::random_unweighted_graph(5000, 30000, 11, false));
+    for (int threads : {1, 4}) {
+        CompressedGraph c = g.compressed(threads);
+        for (int start : {0, 17, 4999}) {
+            EXPECT_EQ(c.bfs(start), g.bfs(start));
+            EXPECT_EQ(c.dfs(start), g.dfs(start));
+        }
+        EXPECT_LT(c.bytes_per_edge(), 4.0 + 4.0 * 5001 / 30000);
+    }
+    EXPECT_THROW(auto bad = g.compressed().bfs(5000), std::out_of_range);
+}
+
+TEST_F(CompressedGraphTest, TopologicalSortMatchesUncompressed) {
+    UnweightedGraph dag = sorted(testutil::random_unweighted_graph(3000, 12000, 5, true));
+    CompressedGraph c = dag.compressed();
+    std::vector<int> order = c.topological_sort();
+    EXPECT_EQ(order, dag.topological_sort());
+    ASSERT_EQ(order.size(), 3000);
+
+    UnweightedGraph cyclic(3);
+    cyclic.add_edge(0, 1);
+    cyclic.add_edge(1, 2);
+    cyclic.add_edge(2, 0);
+    EXPECT_TRUE(cyclic.compressed().topological_sort().empty());
+}
+
+TEST_F(CompressedGraphTest, EncoderMatchesCsrEncoding) {
+    UnweightedGraph g = testutil::random_unweighted_graph(1000, 6000, 3, false);
+    CompressedGraph expected = g.compressed(3);
+
+    CompressedAdjacency::Encoder encoder(1000);
+    for (int v = 0; v < 990; ++v) encoder.add_row(g.neighbours(v));
+    std::vector<int> bad{1000};
+    EXPECT_THROW(encoder.add_row(bad), std::out_of_range);
+    EXPECT_EQ(encoder.next_vertex(), 990);
+    for (int v = 990; v < 1000; ++v) encoder.add_row(g.neighbours(v));
+    EXPECT_THROW(encoder.add_row({}), std::out_of_range);
+    CompressedGraph c(std::move(encoder).finish());
+
+    EXPECT_EQ(c.edge_count(), expected.edge_count());
+    EXPECT_EQ(c.bytes_per_edge(), expected.bytes_per_edge());
+    for (int v = 0; v < 1000; ++v) ASSERT_EQ(c.neighbours(v), expected.neighbours(v));
+    EXPECT_EQ(c.bfs(0), expected.bfs(0));
+
+    CompressedAdjacency::Encoder partial(70);
+    partial.add_row(std::vector<int>{69, 2});
+    CompressedGraph short_graph(std::move(partial).finish());
+    EXPECT_EQ(short_graph.neighbours(0), std::vector<int>({2, 69}));
+    EXPECT_TRUE(short_graph.neighbours(69).empty());
+}
+
+TEST_F(CompressedGraphTest, LoadFromGraphFile) {
+    UnweightedGraph g = testutil::random_unweighted_graph(2000, 9000, 8, false);
+    std::string filename = ::testing::TempDir() + "compressed_graph_test.bin";
+    g.save(filename);
+
+    CompressedGraph c = CompressedGraph::load(filename, true, 2);
+    CompressedGraph expected = g.compressed();
+    EXPECT_EQ(c.edge_count(), expected.edge_count());
+    for (int v = 0; v < 2000; ++v) ASSERT_EQ(c.neighbours(v), expected.neighbours(v));
+    std::remove(filename.c_str());
+    EXPECT_THROW(auto missing = CompressedGraph::load(filename), std::runtime_error);
+}
+
+TEST_F(CompressedGraphTest, EmptyGraph) {
+    CompressedGraph c = UnweightedGraph(0).compressed();
+    EXPECT_EQ(c.size(), 0);
+    EXPECT_EQ(c.bytes_per_edge(), 0);
+    EXPECT_TRUE(c.topological_sort().empty());
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include "src/graph/connected_components.h"
+#include "src/graph/unweighted_graph.h"
+#include "src/graph/weighted_graph.h"
+#include "src/data_structures/union_find.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+class ConnectedComponentsTest : public ::testing::Test {
+protected:
+    /// Expected labels: components numbered by smallest vertex, from a sequential UnionFind
+    static ConnectedComponents reference(int n, const std::vector<std::pair<int, int>>& edges) {
+        UnionFind sets(n);
+        for (auto [u, v] : edges) sets.unite(u, v);
+        ConnectedComponents expected;
+        expected.component.assign(n, -1);
+        std::vector<int> label_of_root(n, -1);
+        for (int v = 0; v < n; ++v) {
+            int& label = label_of_root[sets.find(v)];
+            if (label == -1) {
+                label = expected.count++;
+                expected.sizes.push_back(0);
+            }
+            expected.component[v] = label;
+            expected.sizes[label]++;
+        }
+        return expected;
+    }
+
+    static void expect_equal(const ConnectedComponents& got, const ConnectedComponents& expected) {
+        EXPECT_EQ(got.count, expected.count);
+        EXPECT_EQ(got.component, expected.component);
+        EXPECT_EQ(got.sizes, expected.sizes);
+    }
+
+    static std::vector<std::pair<int, int>> random_edges(int n, int count, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> vertex(0, n - 1);
+        std::vector<std::pair<int, int>> edges;
+        for (int i = 0; i < count; ++i) edges.emplace_back(vertex(rng), vertex(rng));
+        return edges;
+    }
+};
+
+TEST_F(ConnectedComponentsTest, SmallUndirected) {
+    WeightedGraph g(7);
+    g.add_edge(0, 3, 1);
+    g.add_edge(3, 5, 2);
+    g.add_edge(1, 4, 3);
+    g.add_edge(6, 6, 1);
+    ConnectedComponents cc = g.connected_components(1);
+    EXPECT_EQ(cc.count, 4);
+    EXPECT_EQ(cc.component, (std::vector<int>{0, 1, 2, 0, 1, 0, 3}));
+    EXPECT_EQ(cc.sizes, (std::vector<int>{3, 2, 1, 1}));
+}
+
+TEST_F(ConnectedComponentsTest, DirectedArcsJoinWeakly) {
+    // 1 .. 99 join the hub through their own first arc. The hub's arcs to 100 .. 199 lie
+    // beyond the sampled ones and the hub is skipped as part of the giant component, so
+    // those vertices, which have no arcs of their own, are only found through in-arcs.
+    UnweightedGraph g(210);
+    for (int v = 1; v < 100; ++v) g.add_edge(v, 0);
+    for (int v = 1; v < 200; ++v) g.add_edge(0, v);
+    for (int v = 201; v < 210; ++v) g.add_edge(v, v - 1);
+    for (int threads : {1, 4}) {
+        ConnectedComponents cc = g.connected_components(threads);
+        EXPECT_EQ(cc.count, 2);
+        EXPECT_EQ(cc.sizes, (std::vector<int>{200, 10}));
+        EXPECT_EQ(cc.component[199], 0);
+        EXPECT_EQ(cc.component[209], 1);
+    }
+}
+
+TEST_F(ConnectedComponentsTest, MatchesUnionFind) {
+    for (unsigned seed = 0; seed < 6; ++seed) {
+        // Sparse enough to leave many components, dense enough for a giant one
+        const int n = 5'000;
+        std::vector<std::pair<int, int>> edges = random_edges(n, n * (seed + 2) / 4, seed);
+        ConnectedComponents expected = reference(n, edges);
+
+        UnweightedGraph directed(n);
+        directed.add_edges(edges);
+        WeightedGraph undirected(n);
+        for (auto [u, v] : edges) undirected.add_edge(u, v, 1);
+        for (int threads : {1, 3, 8}) {
+            expect_equal(directed.connected_components(threads), expected);
+            expect_equal(undirected.connected_components(threads), expected);
+        }
+    }
+}
+
+TEST_F(ConnectedComponentsTest, EdgelessAndEmpty) {
+    UnweightedGraph isolated(5);
+    ConnectedComponents cc = isolated.connected_components();
+    EXPECT_EQ(cc.count, 5);
+    EXPECT_EQ(cc.component, (std::vector<int>{0, 1, 2, 3, 4}));
+    EXPECT_EQ(cc.sizes, (std::vector<int>(5, 1)));
+
+    EXPECT_EQ(UnweightedGraph(0).connected_components().count, 0);
+}
+
+TEST_F(ConnectedComponentsTest, LongPathIsOneComponent) {
+    const int n = 100'000;
+    std::vector<std::pair<int, int>> edges;
+    // Shuffled path order, so links are made far from the roots
+    std::vector<int> order(n);
+    for (int i = 0; i < n; ++i) order[i] = i;
+    std::shuffle(order.begin(), order.end(), std::mt19937(3));
+    for (int i = 1; i < n; ++i) edges.emplace_back(order[i - 1], order[i]);
+    UnweightedGraph g(n);
+    g.add_edges(edges);
+    ConnectedComponents cc = g.connected_components(4);
+    EXPECT_EQ(cc.count, 1);
+    EXPECT_EQ(cc.sizes, (std::vector<int>{n}));
+}
@@ -0,0 +1,201 @@
+#include <gtest/gtest.h>
+#include "src/graph/contraction_hierarchy.h"
+#include "tests/test_utils.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+
+class ContractionHierarchyTest : public ::testing::Test {
+protected:
+    static int path_weight(const WeightedGraph& g, const std::vector<int>& path) {
+        int total = 0;
+        for (std::size_t i = 1; i < path.size(); ++i) {
+            int best = -1;
+            for (auto [v, w] : g.get_adj_list()[path[i - 1]]) {
+                if (v == path[i] && (best == -1 || w < best)) best = w;
+            }
+            if (best == -1) return -1;
+            total += best;
+        }
+        return total;
+    }
+};
+
+TEST_F(ContractionHierarchyTest, SmallGraph) {
+    WeightedGraph g(5);
+    g.add_edge(0, 1, 4);
+    g.add_edge(0, 2, 1);
+    g.add_edge(1, 3, 1);
+    g.add_edge(2, 1, 2);
+    g.add_edge(2, 3, 5);
+    g.add_edge(3, 4, 3);
+    ContractionHierarchy ch(g);
+
+    EXPECT_EQ(ch.size(), 5);
+    EXPECT_EQ(ch.distance(0, 4), 7);
+    EXPECT_EQ(ch.distance(4, 0), 7);
+    EXPECT_EQ(ch.distance(2, 2), 0);
+
+    auto [distance, path] = ch.path(0, 4);
+    EXPECT_EQ(distance, 7);
+    EXPECT_EQ(path, std::vector<int>({0, 2, 1, 3, 4}));
+    EXPECT_THROW((void)ch.distance(0, 5), std::out_of_range);
+}
+
+TEST_F(ContractionHierarchyTest, MatchesDijkstraOnRandomGraph) {
+    WeightedGraph g = testutil::random_weighted_graph(400, 1000, 100, 17);
+    ContractionHierarchy ch(g, 4);
+    SearchWorkspace ws;
+
+    std::mt19937 gen(5);
+    std::uniform_int_distribution<> vertex_dist(0, 399);
+    for (int q = 0; q < 200; ++q) {
+        int s = vertex_dist(gen), t = vertex_dist(gen);
+        int expected = g.dijkstra(s, t);
+        ASSERT_EQ(ch.distance(s, t, ws), expected) << s << " -> " << t;
+
+        auto [distance, path] = ch.path(s, t);
+        EXPECT_EQ(distance, expected);
+        if (expected != -1) {
+            ASSERT_FALSE(path.empty());
+            EXPECT_EQ(path.front(), s);
+            EXPECT_EQ(path.back(), t);
+            EXPECT_EQ(path_weight(g, path), expected);
+        } else {
+            EXPECT_TRUE(path.empty());
+        }
+    }
+}
+
+TEST_F(ContractionHierarchyTest, GridGraph) {
+    const int W = 40;
+    WeightedGraph g(W * W);
+    std::mt19937 gen(9);
+    std::uniform_int_distribution<> weight_dist(1, 20);
+    for (int y = 0; y < W; ++y) {
+        for (int x = 0; x < W; ++x) {
+            if (x + 1 < W) g.add_edge(y * W + x, y * W + x + 1, weight_dist(gen));
+            if (y + 1 < W) g.add_edge(y * W + x, (y + 1) * W + x, weight_dist(gen));
+        }
+    }
+    ContractionHierarchy ch(g);
+
+    for (int s = 0; s < W * W; s += 97) {
+        auto expected = g.dijkstra(s);
+        for (int t = 0; t < W * W; t += 13) {
+            ASSERT_EQ(ch.distance(s, t), expected[t]);
+        }
+    }
+}
+
+TEST_F(ContractionHierarchyTest, DisconnectedGraph) {
+    WeightedGraph g(4);
+    g.add_edge(0, 1, 2);
+    g.add_edge(2, 3, 2);
+    ContractionHierarchy ch(g);
+
+    EXPECT_EQ(ch.distance(0, 1), 2);
+    EXPECT_EQ(ch.distance(0, 3), -1);
+    EXPECT_TRUE(ch.path(1, 2).second.empty());
+}
+
+TEST_F(ContractionHierarchyTest, HeavyWeightsDoNotOverflow) {
+    // Sums of two weights exceed INT_MAX; wrapped sums used to pass for witnesses and
+    // shortcut weights, giving negative distances.
+    WeightedGraph g(4);
+    g.add_edge(0, 1, 500'000'000);
+    g.add_edge(0, 3, 1'500'000'000);
+    g.add_edge(0, 2, 1'000'000'000);
+    g.add_edge(2, 3, 1'000'000'000);
+    ContractionHierarchy ch(g);
+
+    EXPECT_EQ(ch.distance(1, 2), 1'500'000'000);
+    for (int s = 0; s < 4; ++s) {
+        for (int t = 0; t < 4; ++t) {
+            EXPECT_EQ(ch.distance(s, t), g.dijkstra(s, t)) << s << " -> " << t;
+        }
+    }
+}
+
+TEST_F(ContractionHierarchyTest, SaveAndLoad) {
+    WeightedGraph g = testutil::random_weighted_graph(300, 700, 50, 23);
+    ContractionHierarchy ch(g);
+    std::string filename = ::testing::TempDir() + "ch_roundtrip.bin";
+    ch.save(filename);
+
+    ContractionHierarchy loaded = ContractionHierarchy::load(filename);
+    EXPECT_EQ(loaded.size(), ch.size());
+    EXPECT_EQ(loaded.arc_count(), ch.arc_count());
+    for (int s = 0; s < 300; s += 37) {
+        for (int t = 0; t < 300; t += 41) {
+            EXPECT_EQ(loaded.distance(s, t), ch.distance(s, t));
+        }
+    }
+    std::remove(filename.c_str());
+}
+
+TEST_F(ContractionHierarchyTest, LoadRejectsInvalidFiles) {
+    EXPECT_THROW(ContractionHierarchy::load(::testing::TempDir() + "missing_ch.bin"), std::runtime_error);
+
+    std::string filename = ::testing::TempDir() + "not_ch.bin";
+    {
+        std::ofstream out(filename, std::ios::binary);
+        out << "definitely not a hierarchy";
+    }
+    EXPECT_THROW(ContractionHierarchy::load(filename), std::runtime_error);
+    std::remove(filename.c_str());
+}
+
+TEST_F(ContractionHierarchyTest, LoadRejectsCorruptData) {
+    WeightedGraph g(4);
+    g.add_edge(0, 1, 2);
+    g.add_edge(1, 2, 3);
+    g.add_edge(2, 3, 1);
+    ContractionHierarchy ch(g);
+    std::string filename = ::testing::TempDir() + "ch_corrupt.bin";
+    ch.save(filename);
+
+    std::vector<char> bytes;
+    {
+        std::ifstream in(filename, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    // Header: magic (8), version (4), size (4), arc count (8); then rank, offsets, targets,
+    // weights and middles as 32-bit ints.
+    const int n = 4, arcs = static_cast<int>(ch.arc_count());
+    ASSERT_GT(arcs, 0);
+    auto read = [&](int array_offset, int index) {
+        std::int32_t value;
+        std::memcpy(&value, bytes.data() + 24 + 4 * (array_offset + index), sizeof(value));
+        return value;
+    };
+    const int rank = 0, offsets = n, targets = 2 * n + 1, weights = targets + arcs, middles = weights + arcs;
+    int tail = 0; // Vertex whose row holds arc 0
+    while (read(offsets, tail + 1) == 0) ++tail;
+
+    auto rejects = [&](int array_offset, int index, std::int32_t value) {
+        std::vector<char> patched = bytes;
+        std::memcpy(patched.data() + 24 + 4 * (array_offset + index), &value, sizeof(value));
+        {
+            std::ofstream out(filename, std::ios::binary);
+            out.write(patched.data(), static_cast<std::streamsize>(patched.size()));
+        }
+        try {
+            (void)ContractionHierarchy::load(filename);
+        } catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    };
+    EXPECT_FALSE(rejects(weights, 0, read(weights, 0)));
+    EXPECT_TRUE(rejects(middles, 0, tail));            // middle == a: unpack() would never return
+    EXPECT_TRUE(rejects(middles, 0, read(targets, 0))); // middle == b
+    EXPECT_TRUE(rejects(weights, 0, -1));
+    EXPECT_TRUE(rejects(rank, 0, read(rank, 1)));      // ranks are not a permutation
+    EXPECT_TRUE(rejects(rank, tail, n));
+    EXPECT_TRUE(rejects(targets, 0, tail));            // arc does not lead upwards
+    std::remove(filename.c_str());
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include "src/graph/csr.h"
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+class CsrAdjacencyTest : public ::testing::Test {
+protected:
+    static std::vector<int> to_vector(std::span<const int> s) {
+        return {s.begin(), s.end()};
+    }
+};
+
+TEST_F(CsrAdjacencyTest, EmptyAdjacency) {
+    CsrAdjacency csr(4, false);
+    EXPECT_EQ(csr.size(), 4);
+    EXPECT_EQ(csr.arc_count(), 0);
+    for (int v = 0; v < 4; ++v) {
+        EXPECT_EQ(csr.degree(v), 0);
+        EXPECT_TRUE(csr.neighbours(v).empty());
+    }
+}
+
+TEST_F(CsrAdjacencyTest, AppendGroupsArcsBySource) {
+    CsrAdjacency csr(3, true);
+    csr.append({{2, 0, 7}, {0, 1, 3}, {2, 1, 4}, {0, 2, 5}});
+
+    EXPECT_EQ(csr.arc_count(), 4);
+    EXPECT_EQ(to_vector(csr.offsets()), std::vector<int>({0, 2, 2, 4}));
+    EXPECT_EQ(to_vector(csr.neighbours(0)), std::vector<int>({1, 2}));
+    EXPECT_EQ(to_vector(csr.weights(0)), std::vector<int>({3, 5}));
+    EXPECT_TRUE(csr.neighbours(1).empty());
+    EXPECT_EQ(to_vector(csr.neighbours(2)), std::vector<int>({0, 1}));
+    EXPECT_EQ(to_vector(csr.weights(2)), std::vector<int>({7, 4}));
+}
+
+TEST_F(CsrAdjacencyTest, RepeatedAppendKeepsInsertionOrder) {
+    CsrAdjacency csr(3, false);
+    csr.append({{0, 1, 0}, {1, 2, 0}});
+    csr.append({{0, 2, 0}, {1, 0, 0}});
+
+    EXPECT_EQ(to_vector(csr.neighbours(0)), std::vector<int>({1, 2}));
+    EXPECT_EQ(to_vector(csr.neighbours(1)), std::vector<int>({2, 0}));
+    EXPECT_TRUE(csr.all_weights().empty());
+}
+
+TEST_F(CsrAdjacencyTest, WeightedViewYieldsPairs) {
+    CsrAdjacency csr(2, true);
+    csr.append({{0, 1, 9}, {0, 0, 2}});
+    WeightedNeighbourView view(csr);
+
+    std::vector<std::pair<int, int>> pairs;
+    for (auto [v, w] : view[0]) {
+        pairs.emplace_back(v, w);
+    }
+    EXPECT_EQ(pairs, (std::vector<std::pair<int, int>>{{1, 9}, {0, 2}}));
+    EXPECT_TRUE(view[1].empty());
+}
+
+TEST_F(CsrAdjacencyTest, TypedAppendMatchesCsrAppend) {
+    std::vector<std::vector<CsrAdjacency::Arc>> batches{{{2, 0, 7}, {0, 1, 3}}, {{2, 1, 4}, {0, 2, 5}, {1, 1, 6}}};
+    CsrAdjacency csr(3, true);
+    TypedCsrAdjacency<std::uint16_t, std::uint8_t> typed(3);
+    for (const auto& batch : batches) {
+        csr.append(batch);
+        typed.append(batch.size(), [&](auto&& fn) {
+            for (const auto& arc : batch) fn(arc.from, arc.to, arc.weight);
+        });
+    }
+
+    EXPECT_EQ(typed.arc_count(), csr.arc_count());
+    for (int v = 0; v < 3; ++v) {
+        EXPECT_EQ(std::vector<int>(typed.neighbours(v).begin(), typed.neighbours(v).end()), to_vector(csr.neighbours(v)));
+        EXPECT_EQ(std::vector<int>(typed.weights(v).begin(), typed.weights(v).end()), to_vector(csr.weights(v)));
+    }
+    EXPECT_EQ(typed.byte_size(), 4 * 2 + 5 * 2 + 5 * 1);
+}
+
+TEST_F(CsrAdjacencyTest, TypedAppendRejectsIndexOverflow) {
+    TypedCsrAdjacency<std::uint8_t, std::uint8_t> typed(2);
+    auto arcs = [](auto&& fn) {
+        for (int i = 0; i < 200; ++i) fn(0, 1, 1);
+    };
+    typed.append(200, arcs);
+    EXPECT_THROW(typed.append(200, arcs), std::overflow_error);
+    EXPECT_EQ(typed.arc_count(), 200);
+}
+
+TEST_F(CsrAdjacencyTest, BuildMatchesAppend) {
+    std::vector<int> from{2, 0, 2, 0, 1, 1, 0};
+    std::vector<int> to{0, 1, 1, 2, 1, 2, 1};
+    std::vector<int> weights{7, 3, 4, 5, 6, 8, 9};
+
+    for (bool symmetric : {false, true}) {
+        std::vector<CsrAdjacency::Arc> arcs;
+        for (std::size_t i = 0; i < from.size(); ++i) {
+            arcs.emplace_back(from[i], to[i], weights[i]);
+            if (symmetric) arcs.emplace_back(to[i], from[i], weights[i]);
+        }
+        CsrAdjacency expected(3, true);
+        expected.append(arcs);
+
+        for (int threads : {1, 3}) {
+            CsrAdjacency built = CsrAdjacency::build(3, true, from, to, weights, symmetric, threads);
+            EXPECT_EQ(to_vector(built.offsets()), to_vector(expected.offsets()));
+            EXPECT_EQ(to_vector(built.targets()), to_vector(expected.targets()));
+            EXPECT_EQ(to_vector(built.all_weights()), to_vector(expected.all_weights()));
+        }
+    }
+
+    CsrAdjacency unweighted = CsrAdjacency::build(4, false, from, to, {}, false, 2);
+    EXPECT_TRUE(unweighted.all_weights().empty());
+    EXPECT_EQ(unweighted.degree(3), 0);
+    EXPECT_EQ(to_vector(unweighted.neighbours(0)), std::vector<int>({1, 2, 1}));
+}
+
+TEST_F(CsrAdjacencyTest, ReserveRejectsArcCountOverflow) {
+    CsrAdjacency csr(2, false);
+    csr.append({{0, 1, 0}});
+    std::vector<int> extra{std::numeric_limits<int>::max(), 1};
+    EXPECT_THROW(csr.reserve(extra), std::overflow_error);
+    EXPECT_FALSE(csr.has_gaps());
+    EXPECT_EQ(to_vector(csr.neighbours(0)), std::vector<int>({1}));
+}
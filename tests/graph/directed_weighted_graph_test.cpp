@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include "src/graph/directed_weighted_graph.h"
+#include "tests/test_utils.h"
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+class DirectedWeightedGraphTest : public ::testing::Test {
+protected:
+    /// Textbook Bellman-Ford over every arc, V - 1 times
+    static std::vector<long long> reference(const DirectedWeightedGraph& g, int start) {
+        std::vector<long long> dist(g.size(), DirectedWeightedGraph::unreachable);
+        dist[start] = 0;
+        for (int round = 1; round < g.size(); ++round) {
+            for (int u = 0; u < g.size(); ++u) {
+                if (dist[u] == DirectedWeightedGraph::unreachable) continue;
+                for (std::size_t i = 0; i < g.neighbours(u).size(); ++i) {
+                    int v = g.neighbours(u)[i];
+                    dist[v] = std::min(dist[v], dist[u] + g.neighbour_weights(u)[i]);
+                }
+            }
+        }
+        return dist;
+    }
+
+    /// Check that the reported cycle exists and has negative weight
+    static void expect_negative_cycle(const DirectedWeightedGraph& g, const std::vector<int>& cycle) {
+        ASSERT_FALSE(cycle.empty());
+        long long weight = 0;
+        for (std::size_t i = 0; i < cycle.size(); ++i) {
+            int u = cycle[i], v = cycle[(i + 1) % cycle.size()];
+            long long best = DirectedWeightedGraph::unreachable;
+            for (std::size_t a = 0; a < g.neighbours(u).size(); ++a) {
+                if (g.neighbours(u)[a] == v) best = std::min<long long>(best, g.neighbour_weights(u)[a]);
+            }
+            ASSERT_NE(best, DirectedWeightedGraph::unreachable) << "no arc " << u << " -> " << v;
+            weight += best;
+        }
+        EXPECT_LT(weight, 0);
+    }
+};
+
+TEST_F(DirectedWeightedGraphTest, NegativeEdges) {
+    DirectedWeightedGraph g(5);
+    g.add_edge(0, 1, 4);
+    g.add_edge(0, 2, 5);
+    g.add_edge(2, 1, -3);
+    g.add_edge(1, 3, 2);
+    g.add_edge(3, 0, 1);
+
+    for (auto tree : {g.bellman_ford(0, 1), g.bellman_ford(0, 3), g.spfa(0)}) {
+        EXPECT_FALSE(tree.has_negative_cycle());
+        EXPECT_EQ(tree.distance, (std::vector<long long>{0, 2, 5, 4, DirectedWeightedGraph::unreachable}));
+        EXPECT_EQ(tree.parent, (std::vector<int>{-1, 2, 0, 1, -1}));
+    }
+    EXPECT_EQ(g.edge_count(), 5u);
+}
+
+TEST_F(DirectedWeightedGraphTest, MatchesReference) {
+    for (unsigned seed = 0; seed < 5; ++seed) {
+        DirectedWeightedGraph g = testutil::random_potential_graph(300, 1500, seed);
+        std::vector<long long> expected = reference(g, 0);
+        EXPECT_EQ(g.bellman_ford(0, 1).distance, expected);
+        EXPECT_EQ(g.bellman_ford(0, 4).distance, expected);
+        EXPECT_EQ(g.spfa(0).distance, expected);
+    }
+}
+
+TEST_F(DirectedWeightedGraphTest, ParentsFormShortestPathTree) {
+    DirectedWeightedGraph g = testutil::random_potential_graph(200, 1000, 11);
+    auto tree = g.bellman_ford(3, 2);
+    for (int v = 0; v < g.size(); ++v) {
+        int p = tree.parent[v];
+        if (p == -1) continue;
+        bool tight = false;
+        for (std::size_t a = 0; a < g.neighbours(p).size(); ++a) {
+            tight |= g.neighbours(p)[a] == v && tree.distance[p] + g.neighbour_weights(p)[a] == tree.distance[v];
+        }
+        EXPECT_TRUE(tight) << v;
+    }
+}
+
+TEST_F(DirectedWeightedGraphTest, ReportsNegativeCycle) {
+    DirectedWeightedGraph g = testutil::random_potential_graph(100, 400, 5);
+    // Reachable cycle 0 -> 50 -> 51 -> 52 -> 50 of weight -1
+    g.add_edge(0, 50, 0);
+    g.add_edge(50, 51, 100);
+    g.add_edge(51, 52, -50);
+    g.add_edge(52, 50, -51);
+
+    for (auto tree : {g.bellman_ford(0, 1), g.bellman_ford(0, 4), g.spfa(0)}) {
+        ASSERT_TRUE(tree.has_negative_cycle());
+        expect_negative_cycle(g, tree.negative_cycle);
+    }
+    EXPECT_THROW(auto d = g.all_pairs_distances(), std::invalid_argument);
+}
+
+TEST_F(DirectedWeightedGraphTest, UnreachableNegativeCycleIsIgnored) {
+    DirectedWeightedGraph g(4);
+    g.add_edge(0, 1, 3);
+    g.add_edge(2, 3, -2);
+    g.add_edge(3, 2, 1);
+
+    auto tree = g.bellman_ford(0);
+    EXPECT_FALSE(tree.has_negative_cycle());
+    EXPECT_EQ(tree.distance[1], 3);
+    EXPECT_EQ(tree.distance[2], DirectedWeightedGraph::unreachable);
+    EXPECT_FALSE(g.spfa(0).has_negative_cycle());
+    EXPECT_TRUE(g.spfa(2).has_negative_cycle());
+}
+
+TEST_F(DirectedWeightedGraphTest, JohnsonMatchesBellmanFord) {
+    DirectedWeightedGraph g = testutil::random_potential_graph(120, 600, 21);
+    for (int threads : {1, 3}) {
+        std::vector<long long> all = g.all_pairs_distances(threads);
+        ASSERT_EQ(all.size(), static_cast<std::size_t>(g.size()) * g.size());
+        for (int u = 0; u < g.size(); ++u) {
+            std::vector<long long> row(all.begin() + u * g.size(), all.begin() + (u + 1) * g.size());
+            EXPECT_EQ(row, g.bellman_ford(u, 1).distance) << u;
+        }
+    }
+}
+
+TEST_F(DirectedWeightedGraphTest, JohnsonHandlesHeavyArcs) {
+    // Reweighted arcs of 2^30 and paths longer than INT_MAX used to be rejected up front.
+    DirectedWeightedGraph g(3);
+    g.add_edge(0, 1, 1 << 30);
+    g.add_edge(1, 2, 2'000'000'000);
+    g.add_edge(2, 0, -5);
+    std::vector<long long> all = g.all_pairs_distances(2);
+    for (int u = 0; u < 3; ++u) {
+        std::vector<long long> row(all.begin() + u * 3, all.begin() + (u + 1) * 3);
+        EXPECT_EQ(row, g.bellman_ford(u, 1).distance) << u;
+    }
+    EXPECT_EQ(all[0 * 3 + 2], (1LL << 30) + 2'000'000'000);
+}
+
+TEST_F(DirectedWeightedGraphTest, BatchInsertion) {
+    std::vector<DirectedWeightedGraph::Edge> edges{{0, 1, -2}, {1, 2, -3}, {0, 2, 1}};
+    DirectedWeightedGraph g(3);
+    g.add_edges(edges);
+    g.add_edge(2, 0, 6);
+    g.finalize();
+    EXPECT_EQ(g.edge_count(), 4u);
+    EXPECT_EQ(g.bellman_ford(0).distance, (std::vector<long long>{0, -2, -5}));
+    EXPECT_EQ(g.bellman_ford(2).distance, (std::vector<long long>{6, 4, 0}));
+
+    std::vector<DirectedWeightedGraph::Edge> bad{{0, 3, 1}};
+    EXPECT_THROW(g.add_edges(bad), std::out_of_range);
+    EXPECT_EQ(g.edge_count(), 4u);
+}
+
+TEST_F(DirectedWeightedGraphTest, InvalidVertices) {
+    DirectedWeightedGraph g(3);
+    EXPECT_THROW(g.add_edge(0, 3, 1), std::out_of_range);
+    EXPECT_THROW(g.add_edge(-1, 0, 1), std::out_of_range);
+    EXPECT_THROW(auto t = g.bellman_ford(3), std::out_of_range);
+    EXPECT_THROW(auto t = g.spfa(-1), std::out_of_range);
+}
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include "src/graph/dynamic_topological_order.h"
+#include "src/graph/unweighted_graph.h"
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+class DynamicTopologicalOrderTest : public ::testing::Test {
+protected:
+    /**
+     * Check that order() is a permutation consistent with position() and every arc of g.
+     */
+    static void expect_valid(const DynamicTopologicalOrder& dto, const UnweightedGraph& g) {
+        ASSERT_EQ(dto.order().size(), static_cast<std::size_t>(g.size()));
+        for (int i = 0; i < g.size(); ++i) ASSERT_EQ(dto.position(dto.order()[i]), i);
+        for (int u = 0; u < g.size(); ++u) {
+            for (int v : g.neighbours(u)) ASSERT_LT(dto.position(u), dto.position(v)) << u << " -> " << v;
+        }
+    }
+};
+
+TEST_F(DynamicTopologicalOrderTest, ReordersBackwardInsertions) {
+    DynamicTopologicalOrder dto(4);
+    ASSERT_TRUE(dto.add_edge(3, 2));
+    ASSERT_TRUE(dto.add_edge(2, 1));
+    ASSERT_TRUE(dto.add_edge(1, 0));
+    EXPECT_EQ(std::vector<int>(dto.order().begin(), dto.order().end()), (std::vector<int>{3, 2, 1, 0}));
+
+    // Already consistent: nothing moves
+    ASSERT_TRUE(dto.add_edge(3, 0));
+    EXPECT_EQ(dto.last_reordered(), 0u);
+    EXPECT_EQ(dto.arc_count(), 4u);
+}
+
+TEST_F(DynamicTopologicalOrderTest, RejectsCycles) {
+    DynamicTopologicalOrder dto(4);
+    ASSERT_TRUE(dto.add_edge(0, 1));
+    ASSERT_TRUE(dto.add_edge(1, 2));
+    ASSERT_TRUE(dto.add_edge(2, 3));
+
+    EXPECT_FALSE(dto.add_edge(3, 0));
+    EXPECT_EQ(std::vector<int>(dto.cycle().begin(), dto.cycle().end()), (std::vector<int>{0, 1, 2, 3}));
+    EXPECT_FALSE(dto.add_edge(2, 2));
+    EXPECT_EQ(std::vector<int>(dto.cycle().begin(), dto.cycle().end()), (std::vector<int>{2}));
+
+    EXPECT_EQ(dto.arc_count(), 3u);
+    EXPECT_EQ(std::vector<int>(dto.order().begin(), dto.order().end()), (std::vector<int>{0, 1, 2, 3}));
+}
+
+TEST_F(DynamicTopologicalOrderTest, RandomInsertionsMatchStaticCheck) {
+    const int n = 300;
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> vertex(0, n - 1);
+    DynamicTopologicalOrder dto(n);
+    UnweightedGraph accepted(n);
+    std::set<std::pair<int, int>> arcs;
+    std::size_t inserted = 0;
+
+    for (int i = 0; i < 3'000; ++i) {
+        int u = vertex(rng), v = vertex(rng);
+        if (dto.add_edge(u, v)) {
+            accepted.add_edge(u, v);
+            ++inserted;
+            arcs.emplace(u, v);
+        } else {
+            // The reported cycle is a path v ... u of accepted arcs
+            auto cycle = dto.cycle();
+            ASSERT_FALSE(cycle.empty());
+            EXPECT_EQ(cycle.front(), v);
+            EXPECT_EQ(cycle.back(), u);
+            for (std::size_t k = 0; k + 1 < cycle.size(); ++k) {
+                EXPECT_TRUE(arcs.contains({cycle[k], cycle[k + 1]}));
+            }
+        }
+        if (i % 100 == 99) expect_valid(dto, accepted);
+    }
+    expect_valid(dto, accepted);
+    EXPECT_EQ(dto.arc_count(), inserted);
+    EXPECT_FALSE(accepted.topological_sort().empty());
+}
+
+TEST_F(DynamicTopologicalOrderTest, BuiltFromGraph) {
+    UnweightedGraph g(5);
+    g.add_edge(0, 1);
+    g.add_edge(1, 2);
+    g.add_edge(3, 4);
+    DynamicTopologicalOrder dto = g.dynamic_topological_order();
+    expect_valid(dto, g);
+
+    ASSERT_TRUE(dto.add_edge(2, 3));
+    EXPECT_FALSE(dto.add_edge(4, 0));
+    ASSERT_TRUE(dto.add_edge(2, 4));
+    UnweightedGraph all = dto.graph();
+    EXPECT_EQ(dto.arc_count(), 5u);
+    expect_valid(dto, all);
+    EXPECT_EQ(std::vector<int>(all.neighbours(2).begin(), all.neighbours(2).end()), (std::vector<int>{3, 4}));
+
+    g.add_edge(2, 0);
+    EXPECT_THROW(auto cyclic = g.dynamic_topological_order(), std::invalid_argument);
+}
+
+TEST_F(DynamicTopologicalOrderTest, InvalidVertices) {
+    DynamicTopologicalOrder dto(3);
+    EXPECT_THROW((void)dto.add_edge(-1, 0), std::out_of_range);
+    EXPECT_THROW((void)dto.add_edge(0, 3), std::out_of_range);
+}
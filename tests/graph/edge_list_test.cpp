@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include "src/graph/edge_list.h"
+#include "src/graph/weighted_graph.h"
+#include "src/graph/unweighted_graph.h"
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <limits>
+#include <fstream>
+#include <random>
+
+class EdgeListTest : public ::testing::Test {
+protected:
+    std::string filename = ::testing::TempDir() + "edge_list_test.txt";
+
+    void TearDown() override {
+        std::remove(filename.c_str());
+    }
+
+    void write(const std::string& contents) const {
+        std::ofstream out(filename, std::ios::binary);
+        out << contents;
+    }
+};
+
+TEST_F(EdgeListTest, TextFormat) {
+    write("# comment\n0 1 4\n0\t2 1\n\n  1 3 1\r\n% another comment\n2 1 2\n2 3 5\n3 4 3");
+    EdgeList edges = read_edge_list(filename, EdgeListFormat::Text, true);
+    EXPECT_EQ(edges.vertices, 5);
+    EXPECT_EQ(edges.from, std::vector<int>({0, 0, 1, 2, 2, 3}));
+    EXPECT_EQ(edges.to, std::vector<int>({1, 2, 3, 1, 3, 4}));
+    EXPECT_EQ(edges.weights, std::vector<int>({4, 1, 1, 2, 5, 3}));
+
+    WeightedGraph g = WeightedGraph::from_edge_list(filename, EdgeListFormat::Text);
+    EXPECT_TRUE(g.is_finalized());
+    EXPECT_EQ(g.dijkstra(0), std::vector<int>({0, 3, 1, 4, 7}));
+    EXPECT_EQ(g.max_weight(), 5);
+}
+
+TEST_F(EdgeListTest, CsvFormatWithHeader) {
+    write("source,target,weight\n0,1,4\n1, 2 ,7\n2,0\n");
+    EdgeList edges = read_edge_list(filename, EdgeListFormat::Csv, true, 0, 2);
+    EXPECT_EQ(edges.from, std::vector<int>({0, 1, 2}));
+    EXPECT_EQ(edges.to, std::vector<int>({1, 2, 0}));
+    EXPECT_EQ(edges.weights, std::vector<int>({4, 7, 1}));
+
+    EdgeList unweighted = read_edge_list(filename, EdgeListFormat::Csv, false);
+    EXPECT_TRUE(unweighted.weights.empty());
+    EXPECT_EQ(unweighted.from.size(), 3);
+}
+
+TEST_F(EdgeListTest, BinaryFormat) {
+    {
+        std::ofstream out(filename, std::ios::binary);
+        int triples[] = {5, 2, 0, 5, 0, 0, 4, 0, 0, 4, 1, 0, 2, 3, 0, 3, 1, 0};
+        out.write(reinterpret_cast<const char*>(triples), sizeof(triples));
+    }
+    UnweightedGraph g = UnweightedGraph::from_edge_list(filename, EdgeListFormat::Binary);
+    UnweightedGraph expected(6);
+    expected.add_edge(5, 2);
+    expected.add_edge(5, 0);
+    expected.add_edge(4, 0);
+    expected.add_edge(4, 1);
+    expected.add_edge(2, 3);
+    expected.add_edge(3, 1);
+    EXPECT_EQ(g.topological_sort(), expected.topological_sort());
+    for (int v = 0; v < 6; ++v) {
+        std::span<const int> a = g.neighbours(v), b = expected.neighbours(v);
+        EXPECT_TRUE(std::equal(a.begin(), a.end(), b.begin(), b.end()));
+    }
+
+    write("0123456789a"); // not a multiple of 12 bytes
+    EXPECT_THROW(auto e = read_edge_list(filename, EdgeListFormat::Binary, true), std::runtime_error);
+}
+
+TEST_F(EdgeListTest, LargeFileMatchesAddEdge) {
+    const int n = 20000;
+    std::mt19937 gen(4);
+    std::uniform_int_distribution<> vertex(0, n - 1);
+    std::uniform_int_distribution<> weight(0, 99);
+    WeightedGraph expected(n);
+    {
+        std::ofstream out(filename);
+        for (int i = 0; i < 150000; ++i) {
+            int u = vertex(gen), v = vertex(gen), w = weight(gen);
+            out << u << ' ' << v << ' ' << w << '\n';
+            expected.add_edge(u, v, w);
+        }
+    }
+
+    WeightedGraph g = WeightedGraph::from_edge_list(filename, EdgeListFormat::Text, n, 4);
+    for (int v = 0; v < n; ++v) {
+        std::span<const int> a = g.neighbours(v), b = expected.neighbours(v);
+        ASSERT_TRUE(std::equal(a.begin(), a.end(), b.begin(), b.end()));
+        std::span<const int> wa = g.neighbour_weights(v), wb = expected.neighbour_weights(v);
+        ASSERT_TRUE(std::equal(wa.begin(), wa.end(), wb.begin(), wb.end()));
+    }
+}
+
+TEST_F(EdgeListTest, RejectsBadInput) {
+    write("0 1 2\n1 x 3\n");
+    EXPECT_THROW(auto e = read_edge_list(filename, EdgeListFormat::Text, true), std::runtime_error);
+
+    write("0 1 2.5\n");
+    EXPECT_THROW(auto e = read_edge_list(filename, EdgeListFormat::Text, true), std::runtime_error);
+
+    write("0 1 2\n1 7 3\n");
+    EXPECT_THROW(auto e = read_edge_list(filename, EdgeListFormat::Text, true, 5), std::out_of_range);
+
+    write("0 -1 2\n");
+    EXPECT_THROW(auto e = read_edge_list(filename, EdgeListFormat::Text, true), std::out_of_range);
+
+    write("0 1 -2\n");
+    EXPECT_THROW(auto g = WeightedGraph::from_edge_list(filename, EdgeListFormat::Text), std::invalid_argument);
+
+    EXPECT_THROW(auto e = read_edge_list(filename + ".missing", EdgeListFormat::Text, true), std::runtime_error);
+}
+
+TEST_F(EdgeListTest, RejectsTooManyEdges) {
+    write("0 1 2\n1 2 3\n2 0 1\n");
+    EXPECT_THROW(auto e = read_edge_list(filename, EdgeListFormat::Text, true, 0, 2, 2), std::overflow_error);
+    EXPECT_EQ(read_edge_list(filename, EdgeListFormat::Text, true, 0, 2, 3).from.size(), 3);
+
+    // A sparse file just past INT_MAX / 2 edges: its arcs would overflow the symmetric CSR, so
+    // the size alone must be rejected before the payload is read
+    std::size_t edges = std::numeric_limits<int>::max() / 2 + 1;
+    write("");
+    std::filesystem::resize_file(filename, edges * 3 * sizeof(std::int32_t));
+    EXPECT_THROW(auto g = WeightedGraph::from_edge_list(filename, EdgeListFormat::Binary), std::overflow_error);
+    EXPECT_THROW(auto e = read_edge_list(filename, EdgeListFormat::Binary, true, 0, 0, edges - 1), std::overflow_error);
+}
+
+TEST_F(EdgeListTest, EmptyFile) {
+    write("");
+    EdgeList edges = read_edge_list(filename, EdgeListFormat::Text, true, 3);
+    EXPECT_EQ(edges.vertices, 3);
+    EXPECT_TRUE(edges.from.empty());
+}
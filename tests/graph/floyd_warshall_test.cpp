@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include "src/graph/floyd_warshall.h"
+#include "src/graph/weighted_graph.h"
+#include "tests/test_utils.h"
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+class FloydWarshallTest : public ::testing::Test {
+protected:
+    static void expect_matches_dijkstra(const WeightedGraph& g, int threads) {
+        std::vector<int> all(g.size());
+        std::iota(all.begin(), all.end(), 0);
+        std::vector<int> expected = g.distance_table(all, all);
+        DistanceMatrix matrix = g.all_pairs_distances(threads);
+        ASSERT_EQ(matrix.size(), g.size());
+        ASSERT_EQ(std::vector<int>(matrix.data().begin(), matrix.data().end()), expected);
+    }
+};
+
+TEST_F(FloydWarshallTest, SmallGraph) {
+    WeightedGraph g(4);
+    g.add_edge(0, 1, 5);
+    g.add_edge(1, 2, 2);
+    g.add_edge(0, 2, 9);
+    DistanceMatrix m = g.all_pairs_distances(1);
+    EXPECT_EQ(m(0, 0), 0);
+    EXPECT_EQ(m(0, 2), 7);
+    EXPECT_EQ(m(2, 0), 7);
+    EXPECT_EQ(m(1, 3), -1);
+    EXPECT_EQ(m(3, 3), 0);
+    EXPECT_EQ(std::vector<int>(m.row(1).begin(), m.row(1).end()), (std::vector<int>{5, 0, 2, -1}));
+}
+
+TEST_F(FloydWarshallTest, MatchesDijkstraAcrossTileBoundaries) {
+    // Sizes below, at and just past multiples of the 64-vertex tile
+    for (int n : {1, 2, 63, 64, 65, 130, 200}) {
+        for (int threads : {1, 4}) {
+            expect_matches_dijkstra(testutil::random_weighted_graph(n, 2 * n, 100, n, 1), threads);
+        }
+    }
+}
+
+TEST_F(FloydWarshallTest, DenseAndDisconnected) {
+    WeightedGraph dense = testutil::random_weighted_graph(150, 6'000, 1'000, 3, 1);
+    expect_matches_dijkstra(dense, 3);
+
+    // Two halves without edges between them
+    WeightedGraph split(140);
+    std::mt19937 rng(9);
+    std::uniform_int_distribution<int> half(0, 69), weight(1, 50);
+    for (int i = 0; i < 400; ++i) {
+        split.add_edge(half(rng), half(rng), weight(rng));
+        split.add_edge(70 + half(rng), 70 + half(rng), weight(rng));
+    }
+    expect_matches_dijkstra(split, 2);
+}
+
+TEST_F(FloydWarshallTest, LargeWeightsUseWideEntries) {
+    // (V - 1) * max_weight exceeds the 32-bit sentinel, forcing 64-bit entries
+    WeightedGraph path(4);
+    path.add_edge(0, 1, 800'000'000);
+    path.add_edge(1, 2, 800'000'000);
+    path.add_edge(2, 3, 800'000'000);
+    DistanceMatrix m = path.all_pairs_distances(2);
+    EXPECT_EQ(m(0, 1), 800'000'000);
+    EXPECT_EQ(m(0, 2), 1'600'000'000);
+    EXPECT_EQ(m(3, 0), std::numeric_limits<int>::max()); // 2.4e9 saturates
+}
+
+TEST_F(FloydWarshallTest, EmptyGraph) {
+    WeightedGraph g(0);
+    DistanceMatrix m = g.all_pairs_distances();
+    EXPECT_EQ(m.size(), 0);
+    EXPECT_TRUE(m.data().empty());
+}
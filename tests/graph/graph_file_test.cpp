@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include "src/graph/graph_file.h"
+#include "src/graph/weighted_graph.h"
+#include "src/graph/unweighted_graph.h"
+#include "tests/test_utils.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+class GraphFileTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        std::remove(path("graph_file_test.bin").c_str());
+    }
+
+    static std::string path(const std::string& name) {
+        return ::testing::TempDir() + name;
+    }
+
+    static void flip_byte(const std::string& filename, std::streamoff position) {
+        std::fstream file(filename, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekg(position);
+        char byte = 0;
+        file.read(&byte, 1);
+        byte ^= 0x5a;
+        file.seekp(position);
+        file.write(&byte, 1);
+    }
+};
+
+TEST_F(GraphFileTest, WeightedRoundTrip) {
+    WeightedGraph g = testutil::random_weighted_graph(500, 2000, 100, 1);
+    std::string filename = path("graph_file_test.bin");
+    g.save(filename);
+
+    WeightedGraph loaded = WeightedGraph::load(filename);
+    EXPECT_TRUE(loaded.is_finalized());
+    EXPECT_EQ(loaded.max_weight(), g.max_weight());
+    for (int v = 0; v < 500; ++v) {
+        std::span<const int> a = g.neighbours(v), b = loaded.neighbours(v);
+        ASSERT_TRUE(std::equal(a.begin(), a.end(), b.begin(), b.end()));
+        std::span<const int> wa = g.neighbour_weights(v), wb = loaded.neighbour_weights(v);
+        ASSERT_TRUE(std::equal(wa.begin(), wa.end(), wb.begin(), wb.end()));
+    }
+    EXPECT_EQ(loaded.dijkstra(0), g.dijkstra(0));
+}
+
+TEST_F(GraphFileTest, UnweightedRoundTrip) {
+    UnweightedGraph g(6);
+    g.add_edge(5, 2);
+    g.add_edge(5, 0);
+    g.add_edge(4, 0);
+    g.add_edge(4, 1);
+    g.add_edge(2, 3);
+    g.add_edge(3, 1);
+    std::string filename = path("graph_file_test.bin");
+    g.save(filename);
+
+    UnweightedGraph loaded = UnweightedGraph::load(filename);
+    EXPECT_EQ(loaded.topological_sort(), g.topological_sort());
+    EXPECT_EQ(loaded.bfs(5), g.bfs(5));
+    EXPECT_EQ(loaded.bfs_parallel(5, 2), g.bfs(5));
+}
+
+TEST_F(GraphFileTest, LoadedGraphIsBorrowedAndCopyOnWrite) {
+    WeightedGraph g(3);
+    g.add_edge(0, 1, 5);
+    std::string filename = path("graph_file_test.bin");
+    g.save(filename);
+
+    auto [csr, max_weight] = map_graph_file(filename, GraphFileKind::Undirected);
+    EXPECT_TRUE(csr.borrowed());
+    EXPECT_EQ(max_weight, 5);
+
+    WeightedGraph loaded = WeightedGraph::load(filename);
+    WeightedGraph copy = loaded;
+    loaded.add_edge(1, 2, 1);
+    EXPECT_EQ(loaded.dijkstra(0, 2), 6);
+    EXPECT_EQ(copy.dijkstra(0, 2), -1);
+
+    // The reloaded file is unchanged
+    EXPECT_EQ(WeightedGraph::load(filename).dijkstra(0, 2), -1);
+}
+
+TEST_F(GraphFileTest, MappingOutlivesLoadingScope) {
+    std::string filename = path("graph_file_test.bin");
+    testutil::random_weighted_graph(50, 200, 100, 2).save(filename);
+    std::vector<int> expected = WeightedGraph::load(filename).dijkstra(3);
+
+    WeightedGraph kept(1);
+    {
+        WeightedGraph loaded = WeightedGraph::load(filename);
+        kept = loaded;
+    }
+    std::remove(filename.c_str());
+    EXPECT_EQ(kept.dijkstra(3), expected);
+}
+
+TEST_F(GraphFileTest, RejectsWrongKind) {
+    std::string filename = path("graph_file_test.bin");
+    UnweightedGraph g(2);
+    g.add_edge(0, 1);
+    g.save(filename);
+    EXPECT_THROW(auto loaded = WeightedGraph::load(filename), std::runtime_error);
+}
+
+TEST_F(GraphFileTest, RejectsCorruptFiles) {
+    std::string filename = path("graph_file_test.bin");
+    EXPECT_THROW(auto loaded = WeightedGraph::load(path("missing_graph.bin")), std::runtime_error);
+
+    {
+        std::ofstream out(filename, std::ios::binary);
+        out << "definitely not a graph file, just some text";
+    }
+    EXPECT_THROW(auto loaded = WeightedGraph::load(filename), std::runtime_error);
+
+    testutil::random_weighted_graph(100, 300, 100, 3).save(filename);
+    flip_byte(filename, 40); // arc count
+    EXPECT_THROW(auto loaded = WeightedGraph::load(filename), std::runtime_error);
+
+    testutil::random_weighted_graph(100, 300, 100, 3).save(filename);
+    flip_byte(filename, 64 + 4 * 101 + 8); // a target
+    EXPECT_THROW(auto loaded = WeightedGraph::load(filename), std::runtime_error);
+    EXPECT_NO_THROW(auto loaded = WeightedGraph::load(filename, false));
+
+    testutil::random_weighted_graph(100, 300, 100, 3).save(filename);
+    flip_byte(filename, static_cast<std::streamoff>(std::filesystem::file_size(filename)) - 1); // last weight
+    EXPECT_THROW(auto loaded = WeightedGraph::load(filename), std::runtime_error);
+    EXPECT_NO_THROW(auto loaded = WeightedGraph::load(filename, false));
+
+    testutil::random_weighted_graph(100, 300, 100, 3).save(filename);
+    {
+        std::ofstream out(filename, std::ios::binary | std::ios::app);
+        out << "trailing";
+    }
+    EXPECT_THROW(auto loaded = WeightedGraph::load(filename), std::runtime_error);
+}
@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+#include "src/graph/max_flow.h"
+#include "src/graph/weighted_graph.h"
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+class MaxFlowTest : public ::testing::Test {
+protected:
+    struct Edge {
+        int from, to, capacity;
+    };
+
+    static FlowNetwork build(int n, const std::vector<Edge>& edges) {
+        FlowNetwork network(n);
+        for (const Edge& e : edges) network.add_edge(e.from, e.to, e.capacity);
+        return network;
+    }
+
+    static std::vector<Edge> random_edges(int n, int count, int max_capacity, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> vertex(0, n - 1), capacity(0, max_capacity);
+        std::vector<Edge> edges;
+        for (int i = 0; i < count; ++i) edges.push_back({vertex(rng), vertex(rng), capacity(rng)});
+        return edges;
+    }
+
+    /// Edmonds-Karp on a capacity matrix
+    static long long reference(int n, const std::vector<Edge>& edges, int source, int sink) {
+        std::vector<std::vector<long long>> residual(n, std::vector<long long>(n, 0));
+        for (const Edge& e : edges) {
+            if (e.from != e.to) residual[e.from][e.to] += e.capacity;
+        }
+        long long value = 0;
+        while (true) {
+            std::vector<int> parent(n, -1);
+            parent[source] = source;
+            std::queue<int> queue;
+            queue.push(source);
+            while (!queue.empty() && parent[sink] == -1) {
+                int v = queue.front();
+                queue.pop();
+                for (int w = 0; w < n; ++w) {
+                    if (parent[w] == -1 && residual[v][w] > 0) {
+                        parent[w] = v;
+                        queue.push(w);
+                    }
+                }
+            }
+            if (parent[sink] == -1) return value;
+            long long bottleneck = std::numeric_limits<long long>::max();
+            for (int v = sink; v != source; v = parent[v]) bottleneck = std::min(bottleneck, residual[parent[v]][v]);
+            for (int v = sink; v != source; v = parent[v]) {
+                residual[parent[v]][v] -= bottleneck;
+                residual[v][parent[v]] += bottleneck;
+            }
+            value += bottleneck;
+        }
+    }
+
+    /// Capacity limits, conservation, value and a cut of equal capacity
+    static void expect_max_flow(int n, const std::vector<Edge>& edges, int source, int sink,
+                                const FlowNetwork::MaxFlow& result) {
+        ASSERT_EQ(result.flow.size(), edges.size());
+        std::vector<long long> balance(n, 0);
+        long long cut = 0;
+        for (std::size_t i = 0; i < edges.size(); ++i) {
+            const Edge& e = edges[i];
+            ASSERT_GE(result.flow[i], 0);
+            ASSERT_LE(result.flow[i], e.capacity);
+            balance[e.from] -= result.flow[i];
+            balance[e.to] += result.flow[i];
+            if (result.source_side[e.from] && !result.source_side[e.to]) cut += e.capacity;
+        }
+        for (int v = 0; v < n; ++v) {
+            if (v != source && v != sink) {
+                ASSERT_EQ(balance[v], 0) << "vertex " << v;
+            }
+        }
+        EXPECT_EQ(balance[sink], result.value);
+        EXPECT_EQ(balance[source], -result.value);
+        EXPECT_TRUE(result.source_side[source]);
+        EXPECT_FALSE(result.source_side[sink]);
+        EXPECT_EQ(cut, result.value);
+    }
+};
+
+TEST_F(MaxFlowTest, ClassicNetwork) {
+    std::vector<Edge> edges{{0, 1, 16}, {0, 2, 13}, {2, 1, 4}, {1, 3, 12}, {3, 2, 9},
+                            {2, 4, 14}, {4, 3, 7},  {3, 5, 20}, {4, 5, 4}};
+    FlowNetwork network = build(6, edges);
+    for (const auto& result : {network.dinic(0, 5), network.push_relabel(0, 5)}) {
+        EXPECT_EQ(result.value, 23);
+        expect_max_flow(6, edges, 0, 5, result);
+    }
+    EXPECT_EQ(network.edge_count(), 9u);
+}
+
+TEST_F(MaxFlowTest, MatchesEdmondsKarp) {
+    for (unsigned seed = 0; seed < 40; ++seed) {
+        int n = 2 + static_cast<int>(seed % 30);
+        std::vector<Edge> edges = random_edges(n, 4 * n, seed % 2 == 0 ? 1 : 50, seed);
+        FlowNetwork network = build(n, edges);
+        long long expected = reference(n, edges, 0, n - 1);
+
+        FlowNetwork::MaxFlow dinic = network.dinic(0, n - 1);
+        EXPECT_EQ(dinic.value, expected) << "seed " << seed;
+        expect_max_flow(n, edges, 0, n - 1, dinic);
+
+        FlowNetwork::MaxFlow push_relabel = network.push_relabel(0, n - 1);
+        EXPECT_EQ(push_relabel.value, expected) << "seed " << seed;
+        expect_max_flow(n, edges, 0, n - 1, push_relabel);
+    }
+}
+
+TEST_F(MaxFlowTest, LargeRandomNetworksAgree) {
+    for (unsigned seed = 0; seed < 3; ++seed) {
+        std::vector<Edge> edges = random_edges(2'000, 10'000, 1'000, seed);
+        FlowNetwork network = build(2'000, edges);
+        FlowNetwork::MaxFlow dinic = network.dinic(1, 2), push_relabel = network.push_relabel(1, 2);
+        EXPECT_EQ(dinic.value, push_relabel.value);
+        expect_max_flow(2'000, edges, 1, 2, dinic);
+        expect_max_flow(2'000, edges, 1, 2, push_relabel);
+    }
+}
+
+TEST_F(MaxFlowTest, ParallelAntiparallelAndSelfLoops) {
+    std::vector<Edge> edges{{0, 1, 3}, {0, 1, 4}, {1, 0, 5}, {1, 1, 9}, {1, 2, 6},
+                            {2, 1, 2}, {1, 2, std::numeric_limits<int>::max()}};
+    FlowNetwork network = build(3, edges);
+    for (const auto& result : {network.dinic(0, 2), network.push_relabel(0, 2)}) {
+        EXPECT_EQ(result.value, 7);
+        EXPECT_EQ(result.flow[3], 0);
+        expect_max_flow(3, edges, 0, 2, result);
+    }
+}
+
+TEST_F(MaxFlowTest, UnreachableSink) {
+    std::vector<Edge> edges{{0, 1, 5}, {1, 2, 5}, {3, 2, 5}};
+    FlowNetwork network = build(4, edges);
+    for (const auto& result : {network.dinic(0, 3), network.push_relabel(0, 3)}) {
+        EXPECT_EQ(result.value, 0);
+        EXPECT_EQ(result.flow, (std::vector<int>{0, 0, 0}));
+        EXPECT_EQ(result.source_side, (std::vector<char>{1, 1, 1, 0}));
+    }
+}
+
+TEST_F(MaxFlowTest, LongPathWithDeadEnds) {
+    // A long chain with a bottleneck in the middle and many branches that reach no sink,
+    // which exercises the gap and global relabeling heuristics.
+    const int length = 20'000;
+    std::vector<Edge> edges;
+    for (int v = 0; v + 1 < length; ++v) {
+        edges.push_back({v, v + 1, v == length / 2 ? 3 : 10});
+        edges.push_back({v, length + v, 10});
+    }
+    FlowNetwork network = build(2 * length, edges);
+    for (const auto& result : {network.dinic(0, length - 1), network.push_relabel(0, length - 1)}) {
+        EXPECT_EQ(result.value, 3);
+        expect_max_flow(2 * length, edges, 0, length - 1, result);
+    }
+}
+
+TEST_F(MaxFlowTest, FromUndirectedGraph) {
+    WeightedGraph g(4);
+    g.add_edge(0, 1, 3);
+    g.add_edge(1, 3, 2);
+    g.add_edge(0, 2, 2);
+    g.add_edge(2, 3, 4);
+    g.add_edge(2, 1, 5);
+    FlowNetwork network = FlowNetwork::from_graph(g);
+    EXPECT_EQ(network.edge_count(), 10u);
+    EXPECT_EQ(network.dinic(0, 3).value, 5);
+    EXPECT_EQ(network.push_relabel(3, 0).value, 5);
+}
+
+TEST_F(MaxFlowTest, InvalidArguments) {
+    FlowNetwork network(3);
+    EXPECT_THROW(network.add_edge(0, 3, 1), std::out_of_range);
+    EXPECT_THROW(network.add_edge(-1, 0, 1), std::out_of_range);
+    EXPECT_THROW(network.add_edge(0, 1, -1), std::invalid_argument);
+    EXPECT_THROW(auto f = network.dinic(0, 0), std::invalid_argument);
+    EXPECT_THROW(auto f = network.push_relabel(0, 3), std::out_of_range);
+}
@@ -106,4 +106,35 @@ TEST_F(GraphTest, LargeGraph) {
     auto mstPrim = g.prim_mst();
 
     EXPECT_TRUE(areMSTsEquivalent(mstKruskal, mstPrim));
-}
\ No newline at end of file
+}
+
+
+TEST_F(GraphTest, BoruvkaMatchesKruskal) {
+    MSTGraph g(6);
+    g.add_edge(0, 1, 4);
+    g.add_edge(0, 2, 3);
+    g.add_edge(1, 2, 1);
+    g.add_edge(1, 3, 2);
+    g.add_edge(2, 3, 4);
+    g.add_edge(3, 4, 2);
+    g.add_edge(4, 5, 6);
+
+    auto mstBoruvka = g.boruvka_mst(2);
+    EXPECT_TRUE(areMSTsEquivalent(g.kruskal_mst(), mstBoruvka));
+}
+
+TEST_F(GraphTest, BoruvkaNegativeWeightsAndForest) {
+    MSTGraph g(6);
+    g.add_edge(0, 1, -5);
+    g.add_edge(1, 2, 3);
+    g.add_edge(0, 2, -1);
+    g.add_edge(3, 4, 7);
+    g.add_edge(4, 4, -9); // self-loop is ignored
+    // Node 5 is isolated
+
+    auto forest = g.boruvka_mst();
+    ASSERT_EQ(forest.size(), 3);
+    int totalWeight = 0;
+    for (const auto& edge : forest) totalWeight += edge.w;
+    EXPECT_EQ(totalWeight, 1);
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include "src/graph/multi_source_bfs.h"
+#include "src/graph/unweighted_graph.h"
+#include "tests/test_utils.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+class MultiSourceBfsTest : public ::testing::Test {
+protected:
+    static std::vector<int> random_sources(int n, int count, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> vertex(0, n - 1);
+        std::vector<int> sources(count);
+        for (int& s : sources) s = vertex(rng);
+        return sources;
+    }
+};
+
+TEST_F(MultiSourceBfsTest, SmallGraph) {
+    UnweightedGraph g(6);
+    g.add_edge(0, 1);
+    g.add_edge(1, 2);
+    g.add_edge(0, 2);
+    g.add_edge(2, 3);
+    g.add_edge(4, 0);
+    std::vector<int> sources{0, 3, 4, 0};
+    std::vector<std::vector<int>> distance = g.multi_source_bfs(sources, 64, 1);
+    ASSERT_EQ(distance.size(), 4u);
+    EXPECT_EQ(distance[0], (std::vector<int>{0, 1, 1, 2, -1, -1}));
+    EXPECT_EQ(distance[1], (std::vector<int>{-1, -1, -1, 0, -1, -1}));
+    EXPECT_EQ(distance[2], (std::vector<int>{1, 2, 2, 3, 0, -1}));
+    EXPECT_EQ(distance[3], distance[0]);
+}
+
+TEST_F(MultiSourceBfsTest, MatchesBfsForEveryWidth) {
+    // Sparse enough for long tails, dense enough that some levels run bottom-up
+    for (unsigned seed = 0; seed < 3; ++seed) {
+        const int n = 3'000;
+        UnweightedGraph g = testutil::random_unweighted_graph(n, n * (2 + 3 * seed), seed);
+        // 700 sources leave a partial last batch at every width
+        std::vector<int> sources = random_sources(n, 700, seed + 10);
+        std::vector<std::vector<int>> expected;
+        for (int s : sources) expected.push_back(g.bfs(s).second);
+
+        for (int width : {64, 256, 512}) {
+            for (int threads : {1, 4}) {
+                EXPECT_EQ(g.multi_source_bfs(sources, width, threads), expected)
+                    << "seed " << seed << ", width " << width << ", threads " << threads;
+            }
+        }
+    }
+}
+
+TEST_F(MultiSourceBfsTest, SummaryMatchesDistances) {
+    const int n = 4'000;
+    UnweightedGraph g = testutil::random_unweighted_graph(n, 3 * n, 5);
+    std::vector<int> sources = random_sources(n, 300, 6);
+    std::vector<std::vector<int>> distance = g.multi_source_bfs(sources, 256, 1);
+
+    for (int threads : {1, 3}) {
+        BfsSummary summary = g.multi_source_bfs_summary(sources, 256, threads);
+        for (std::size_t i = 0; i < sources.size(); ++i) {
+            int reached = 0, eccentricity = 0;
+            long long sum = 0, arcs = 0;
+            for (int v = 0; v < n; ++v) {
+                if (distance[i][v] == -1) continue;
+                ++reached;
+                sum += distance[i][v];
+                eccentricity = std::max(eccentricity, distance[i][v]);
+                arcs += static_cast<long long>(g.neighbours(v).size());
+            }
+            EXPECT_EQ(summary.reached[i], reached);
+            EXPECT_EQ(summary.distance_sum[i], sum);
+            EXPECT_EQ(summary.eccentricity[i], eccentricity);
+            EXPECT_EQ(summary.arcs[i], arcs);
+        }
+    }
+}
+
+TEST_F(MultiSourceBfsTest, LongPath) {
+    // Thousands of top-down levels with a frontier of a single vertex per search
+    const int n = 5'000;
+    UnweightedGraph g(n);
+    for (int v = 0; v + 1 < n; ++v) g.add_edge(v, v + 1);
+    std::vector<int> sources{0, n / 2, n - 1};
+    BfsSummary summary = g.multi_source_bfs_summary(sources, 64, 2);
+    EXPECT_EQ(summary.reached, (std::vector<int>{n, n - n / 2, 1}));
+    EXPECT_EQ(summary.eccentricity, (std::vector<int>{n - 1, n - 1 - n / 2, 0}));
+    EXPECT_EQ(summary.distance_sum[0], static_cast<long long>(n) * (n - 1) / 2);
+}
+
+TEST_F(MultiSourceBfsTest, InvalidArguments) {
+    UnweightedGraph g(4);
+    g.add_edge(0, 1);
+    std::vector<int> bad_source{0, 4};
+    EXPECT_THROW(auto d = g.multi_source_bfs(bad_source), std::out_of_range);
+    EXPECT_THROW(auto s = g.multi_source_bfs_summary(std::vector<int>{-1}), std::out_of_range);
+    EXPECT_THROW(auto d = g.multi_source_bfs(std::vector<int>{0}, 128), std::invalid_argument);
+    EXPECT_TRUE(g.multi_source_bfs({}).empty());
+}
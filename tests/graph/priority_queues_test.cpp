@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include "src/graph/priority_queues.h"
+#include <algorithm>
+#include <random>
+
+template<typename Queue>
+class PriorityQueueTest : public ::testing::Test {
+protected:
+    Queue q;
+};
+
+using QueuePolicies = ::testing::Types<BinaryHeapQueue, DialBucketQueue, RadixHeapQueue,
+                                       IndexedDaryHeapQueue<2>, IndexedDaryHeapQueue<4>>;
+TYPED_TEST_SUITE(PriorityQueueTest, QueuePolicies);
+
+TYPED_TEST(PriorityQueueTest, PopsInKeyOrder) {
+    this->q.reset(5, 10);
+    EXPECT_TRUE(this->q.empty());
+    this->q.push(7, 0);
+    this->q.push(3, 1);
+    this->q.push(9, 2);
+    this->q.push(4, 3);
+
+    std::vector<int> keys;
+    while (!this->q.empty()) keys.push_back(this->q.pop().first);
+    EXPECT_EQ(keys, std::vector<int>({3, 4, 7, 9}));
+}
+
+TYPED_TEST(PriorityQueueTest, MonotoneDijkstraPattern) {
+    // Simulates Dijkstra: keys pushed after a pop lie within max_weight of the popped key
+    const int max_weight = 20;
+    const int vertices = 2000;
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<> weight(0, max_weight);
+
+    this->q.reset(vertices, max_weight);
+    std::vector<int> pushed_key(vertices, -1);
+    this->q.push(0, 0);
+    pushed_key[0] = 0;
+    int next = 1, last = 0;
+    while (!this->q.empty()) {
+        auto [key, v] = this->q.pop();
+        EXPECT_GE(key, last);
+        last = key;
+        for (int i = 0; i < 3 && next < vertices; ++i, ++next) {
+            pushed_key[next] = key + weight(gen);
+            this->q.push(pushed_key[next], next);
+        }
+    }
+    EXPECT_EQ(next, vertices);
+}
+
+TYPED_TEST(PriorityQueueTest, ResetClearsEntries) {
+    this->q.reset(3, 5);
+    this->q.push(2, 0);
+    this->q.push(1, 1);
+    this->q.reset(3, 5);
+    EXPECT_TRUE(this->q.empty());
+    this->q.push(4, 2);
+    EXPECT_EQ(this->q.pop(), std::make_pair(4, 2));
+}
+
+TEST(IndexedDaryHeapQueueTest, DecreaseKeyKeepsOneEntryPerVertex) {
+    IndexedDaryHeapQueue<4> q;
+    q.reset(4, 0);
+    q.push(10, 0);
+    q.push(8, 1);
+    q.push(5, 0);  // decrease-key
+    q.push(12, 1); // larger key is ignored
+    q.push(6, 2);
+
+    EXPECT_EQ(q.pop(), std::make_pair(5, 0));
+    EXPECT_EQ(q.pop(), std::make_pair(6, 2));
+    EXPECT_EQ(q.pop(), std::make_pair(8, 1));
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(DialBucketQueueTest, AcceptsKeysBelowCurrent) {
+    // Prim pushes edge weights, which may be smaller than the last popped key
+    DialBucketQueue q;
+    q.reset(4, 9);
+    q.push(7, 0);
+    EXPECT_EQ(q.pop(), std::make_pair(7, 0));
+    q.push(9, 1);
+    q.push(2, 2);
+    EXPECT_EQ(q.pop(), std::make_pair(2, 2));
+    EXPECT_EQ(q.pop(), std::make_pair(9, 1));
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(RadixHeapQueueTest, LargeKeys) {
+    RadixHeapQueue q;
+    q.reset(4, 0);
+    q.push(1 << 30, 0);
+    q.push((1 << 30) + 1, 1);
+    q.push(5, 2);
+    EXPECT_EQ(q.pop(), std::make_pair(5, 2));
+    EXPECT_EQ(q.pop(), std::make_pair(1 << 30, 0));
+    q.push((1 << 30) + 1, 3);
+    EXPECT_EQ(q.pop().first, (1 << 30) + 1);
+    EXPECT_EQ(q.pop().first, (1 << 30) + 1);
+    EXPECT_TRUE(q.empty());
+}
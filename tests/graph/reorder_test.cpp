@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include "src/graph/reorder.h"
+#include "src/graph/weighted_graph.h"
+#include "src/graph/unweighted_graph.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+class ReorderTest : public ::testing::Test {
+protected:
+    static constexpr int side = 30;
+
+    /**
+     * Grid graph whose vertex ids have been shuffled, so neighbours are far apart.
+     */
+    static WeightedGraph shuffled_grid(std::vector<int>& label) {
+        label.resize(side * side);
+        for (int i = 0; i < side * side; ++i) label[i] = i;
+        std::shuffle(label.begin(), label.end(), std::mt19937(5));
+
+        WeightedGraph g(side * side);
+        std::mt19937 rng(9);
+        std::uniform_int_distribution<int> weight(1, 20);
+        for (int r = 0; r < side; ++r) {
+            for (int c = 0; c < side; ++c) {
+                if (c + 1 < side) g.add_edge(label[r * side + c], label[r * side + c + 1], weight(rng));
+                if (r + 1 < side) g.add_edge(label[r * side + c], label[(r + 1) * side + c], weight(rng));
+            }
+        }
+        return g;
+    }
+
+    static int bandwidth(const WeightedGraph& g) {
+        int result = 0;
+        for (int v = 0; v < g.size(); ++v) {
+            for (int u : g.neighbours(v)) result = std::max(result, std::abs(u - v));
+        }
+        return result;
+    }
+};
+
+TEST_F(ReorderTest, OrderingsArePermutations) {
+    std::vector<int> label;
+    WeightedGraph g = shuffled_grid(label);
+    for (VertexOrdering ordering : {VertexOrdering::ReverseCuthillMcKee, VertexOrdering::DegreeDescending,
+                                    VertexOrdering::BreadthFirst}) {
+        auto [reordered, new_id] = g.reordered(ordering, 2);
+        EXPECT_TRUE(is_permutation(new_id, g.size()));
+        EXPECT_EQ(reordered.size(), g.size());
+    }
+    EXPECT_FALSE(is_permutation(std::vector<int>{0, 2, 2}, 3));
+    EXPECT_FALSE(is_permutation(std::vector<int>{0, 1}, 3));
+}
+
+TEST_F(ReorderTest, ReverseCuthillMcKeeRecoversGridBandwidth) {
+    std::vector<int> label;
+    WeightedGraph g = shuffled_grid(label);
+    auto [reordered, new_id] = g.reordered(VertexOrdering::ReverseCuthillMcKee);
+    EXPECT_GT(bandwidth(g), 10 * side);
+    EXPECT_LE(bandwidth(reordered), 2 * side);
+}
+
+TEST_F(ReorderTest, DegreeDescendingPutsHubsFirst) {
+    UnweightedGraph g(6);
+    for (int v = 0; v < 5; ++v) g.add_edge(v, 5);
+    g.add_edge(3, 1);
+    g.add_edge(3, 4);
+    auto [reordered, new_id] = g.reordered(VertexOrdering::DegreeDescending);
+    EXPECT_EQ(new_id[5], 0);
+    EXPECT_EQ(new_id[3], 1);
+    EXPECT_EQ(new_id[1], 2); // ties keep the original order
+    EXPECT_EQ(new_id[4], 3);
+    EXPECT_EQ(reordered.neighbours(0).size(), 0);
+}
+
+TEST_F(ReorderTest, WeightedResultsMapBack) {
+    std::vector<int> label;
+    WeightedGraph g = shuffled_grid(label);
+    std::vector<int> expected = g.dijkstra(label[0]);
+    long long expected_mst = 0;
+    for (const auto& e : g.prim_mst()) expected_mst += e.w;
+
+    for (VertexOrdering ordering : {VertexOrdering::ReverseCuthillMcKee, VertexOrdering::DegreeDescending,
+                                    VertexOrdering::BreadthFirst}) {
+        auto [reordered, new_id] = g.reordered(ordering, 3);
+        EXPECT_EQ(reordered.max_weight(), g.max_weight());
+        std::vector<int> distance = reordered.dijkstra(new_id[label[0]]);
+        for (int v = 0; v < g.size(); ++v) ASSERT_EQ(distance[new_id[v]], expected[v]);
+
+        long long mst = 0;
+        for (const auto& e : reordered.prim_mst()) mst += e.w;
+        EXPECT_EQ(mst, expected_mst);
+    }
+}
+
+TEST_F(ReorderTest, DirectedResultsMapBackAcrossComponents) {
+    const int n = 2000;
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> vertex(0, n - 1);
+    UnweightedGraph g(n);
+    for (int i = 0; i < 3 * n; ++i) g.add_edge(vertex(rng), vertex(rng));
+    std::vector<int> expected = g.bfs(7).second;
+
+    for (VertexOrdering ordering : {VertexOrdering::ReverseCuthillMcKee, VertexOrdering::BreadthFirst}) {
+        auto [reordered, new_id] = g.reordered(ordering);
+        std::vector<int> distance = reordered.bfs(new_id[7]).second;
+        for (int v = 0; v < n; ++v) ASSERT_EQ(distance[new_id[v]], expected[v]);
+    }
+}
+
+TEST_F(ReorderTest, RelabelledWithExplicitPermutation) {
+    WeightedGraph g(3);
+    g.add_edge(0, 1, 4);
+    g.add_edge(1, 2, 6);
+    WeightedGraph relabelled = g.relabelled(std::vector<int>{2, 0, 1});
+    EXPECT_EQ(relabelled.dijkstra(2), std::vector<int>({4, 10, 0}));
+    std::span<const int> n0 = relabelled.neighbours(0);
+    EXPECT_EQ(std::vector<int>(n0.begin(), n0.end()), std::vector<int>({1, 2}));
+    EXPECT_THROW(auto bad = g.relabelled(std::vector<int>{0, 0, 1}), std::invalid_argument);
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include "src/graph/search_workspace.h"
+#include "src/graph/weighted_graph.h"
+#include "src/graph/unweighted_graph.h"
+#include <limits>
+#include <random>
+#include <thread>
+
+class SearchWorkspaceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        g = new WeightedGraph(5);
+        g->add_edge(0, 1, 4);
+        g->add_edge(0, 2, 1);
+        g->add_edge(1, 3, 1);
+        g->add_edge(2, 1, 2);
+        g->add_edge(2, 3, 5);
+        g->add_edge(3, 4, 3);
+    }
+
+    void TearDown() override {
+        delete g;
+    }
+
+    WeightedGraph* g;
+};
+
+TEST_F(SearchWorkspaceTest, FreshWorkspaceIsUntouched) {
+    SearchWorkspace ws(4);
+    EXPECT_EQ(ws.capacity(), 4);
+    EXPECT_TRUE(ws.touched().empty());
+    for (int v = 0; v < 4; ++v) {
+        EXPECT_FALSE(ws.touched(v));
+        EXPECT_EQ(ws.distance(v), -1);
+        EXPECT_EQ(ws.parent(v), -1);
+    }
+}
+
+TEST_F(SearchWorkspaceTest, ResultsMatchAllocatingDijkstra) {
+    SearchWorkspace ws;
+    auto expected = g->dijkstra(0);
+    auto reached = g->dijkstra(0, ws);
+
+    EXPECT_EQ(reached.size(), 5);
+    EXPECT_GE(ws.capacity(), 5);
+    for (int v = 0; v < 5; ++v) {
+        EXPECT_EQ(ws.distance(v), expected[v]);
+    }
+    EXPECT_EQ(ws.parent(0), -1);
+    EXPECT_EQ(ws.parent(1), 2);
+    EXPECT_EQ(ws.parent(4), 3);
+}
+
+TEST_F(SearchWorkspaceTest, ReuseForgetsPreviousSearch) {
+    WeightedGraph g2(4);
+    g2.add_edge(0, 1, 1);
+    g2.add_edge(2, 3, 1);
+    SearchWorkspace ws(4);
+
+    EXPECT_EQ(g2.dijkstra(0, ws).size(), 2);
+    EXPECT_TRUE(ws.touched(1));
+
+    EXPECT_EQ(g2.dijkstra(2, ws).size(), 2);
+    EXPECT_FALSE(ws.touched(0));
+    EXPECT_FALSE(ws.touched(1));
+    EXPECT_EQ(ws.distance(0), std::numeric_limits<int>::max());
+    EXPECT_EQ(ws.distance(3), 1);
+}
+
+TEST_F(SearchWorkspaceTest, PointToPointQueriesShareWorkspace) {
+    const int NUM_VERTICES = 1000;
+    WeightedGraph g2(NUM_VERTICES);
+    std::mt19937 gen(5);
+    std::uniform_int_distribution<> vertex_dist(0, NUM_VERTICES - 1);
+    std::uniform_int_distribution<> weight_dist(1, 20);
+    for (int i = 0; i < 3 * NUM_VERTICES; ++i) {
+        g2.add_edge(vertex_dist(gen), vertex_dist(gen), weight_dist(gen));
+    }
+
+    SearchWorkspace ws;
+    for (int q = 0; q < 100; ++q) {
+        int s = vertex_dist(gen), t = vertex_dist(gen);
+        int expected = g2.dijkstra(s, t);
+        EXPECT_EQ(g2.dijkstra(s, t, ws), expected);
+        EXPECT_EQ(g2.bidirectional_dijkstra(s, t, ws), expected);
+        EXPECT_EQ(g2.a_star(s, t, [](int) { return 0; }, ws), expected);
+    }
+}
+
+TEST_F(SearchWorkspaceTest, OneShotQueriesLeaseThreadWorkspace) {
+    // The heuristic runs one-shot queries while the outer A* holds a lease
+    auto exact = [this](int v) { return g->dijkstra(v, 4); };
+    EXPECT_EQ(g->a_star(0, 4, exact), 7);
+    EXPECT_EQ(g->a_star_path(0, 4, exact).second, std::vector<int>({0, 2, 1, 3, 4}));
+
+    SearchWorkspace* shared;
+    {
+        SearchWorkspace::Lease first;
+        shared = &*first;
+    }
+    SearchWorkspace::Lease again;
+    EXPECT_EQ(&*again, shared);
+    SearchWorkspace::Lease nested;
+    EXPECT_NE(&*nested, shared);
+    std::thread([shared] {
+        SearchWorkspace::Lease other;
+        EXPECT_NE(&*other, shared);
+    }).join();
+}
+
+TEST_F(SearchWorkspaceTest, UnweightedSearches) {
+    UnweightedGraph g2(5);
+    g2.add_edge(0, 1);
+    g2.add_edge(0, 2);
+    g2.add_edge(1, 3);
+    g2.add_edge(2, 3);
+    SearchWorkspace ws;
+
+    auto [parent, distance] = g2.bfs(0);
+    auto order = g2.bfs(0, ws);
+    EXPECT_EQ(std::vector<int>(order.begin(), order.end()), std::vector<int>({0, 1, 2, 3}));
+    for (int v = 0; v < 5; ++v) {
+        EXPECT_EQ(ws.distance(v), distance[v]);
+        EXPECT_EQ(ws.parent(v), parent[v]);
+    }
+
+    auto [dfs_parent, dfs_time] = g2.dfs(0);
+    auto discovered = g2.dfs(0, ws);
+    EXPECT_EQ(discovered.size(), 4);
+    for (int v = 0; v < 5; ++v) {
+        EXPECT_EQ(ws.distance(v), dfs_time[v]);
+        EXPECT_EQ(ws.parent(v), dfs_parent[v]);
+    }
+    EXPECT_THROW(g2.bfs(5, ws), std::out_of_range);
+}
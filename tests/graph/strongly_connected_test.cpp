@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include "src/graph/strongly_connected.h"
+#include "src/graph/unweighted_graph.h"
+#include "tests/test_utils.h"
+#include <stdexcept>
+#include <vector>
+
+class StronglyConnectedTest : public ::testing::Test {
+protected:
+    /**
+     * Every arc must point to the same or a later component.
+     */
+    static void expect_topological(const UnweightedGraph& g, const StronglyConnectedComponents& scc) {
+        ASSERT_EQ(static_cast<int>(scc.component.size()), g.size());
+        for (int u = 0; u < g.size(); ++u) {
+            ASSERT_GE(scc.component[u], 0);
+            ASSERT_LT(scc.component[u], scc.count);
+            for (int v : g.neighbours(u)) ASSERT_LE(scc.component[u], scc.component[v]);
+        }
+    }
+
+    static void expect_same_partition(const StronglyConnectedComponents& a, const StronglyConnectedComponents& b) {
+        ASSERT_EQ(a.count, b.count);
+        std::vector<int> map(a.count, -1);
+        for (std::size_t v = 0; v < a.component.size(); ++v) {
+            int& m = map[a.component[v]];
+            if (m == -1) m = b.component[v];
+            ASSERT_EQ(m, b.component[v]) << "vertex " << v;
+        }
+    }
+};
+
+TEST_F(StronglyConnectedTest, SmallGraph) {
+    // {0, 1, 2} -> {3, 4} -> {5}, plus the isolated vertex 6 and a self-loop on 5
+    UnweightedGraph g(7);
+    g.add_edge(0, 1);
+    g.add_edge(1, 2);
+    g.add_edge(2, 0);
+    g.add_edge(2, 3);
+    g.add_edge(3, 4);
+    g.add_edge(4, 3);
+    g.add_edge(4, 5);
+    g.add_edge(5, 5);
+
+    for (const auto& scc : {g.strongly_connected_components(), g.strongly_connected_components_parallel(2)}) {
+        EXPECT_EQ(scc.count, 4);
+        expect_topological(g, scc);
+        EXPECT_EQ(scc.component[0], scc.component[1]);
+        EXPECT_EQ(scc.component[1], scc.component[2]);
+        EXPECT_EQ(scc.component[3], scc.component[4]);
+        EXPECT_NE(scc.component[2], scc.component[3]);
+        EXPECT_NE(scc.component[4], scc.component[5]);
+    }
+}
+
+TEST_F(StronglyConnectedTest, MatchesReachability) {
+    const int n = 60;
+    for (unsigned seed = 1; seed <= 10; ++seed) {
+        UnweightedGraph g = testutil::random_unweighted_graph(n, 90, seed);
+        std::vector<std::vector<bool>> reach(n, std::vector<bool>(n, false));
+        for (int s = 0; s < n; ++s) {
+            std::vector<int> distance = g.bfs(s).second;
+            for (int v = 0; v < n; ++v) reach[s][v] = distance[v] != -1;
+        }
+
+        StronglyConnectedComponents scc = g.strongly_connected_components();
+        expect_topological(g, scc);
+        for (int u = 0; u < n; ++u) {
+            for (int v = 0; v < n; ++v) {
+                EXPECT_EQ(scc.component[u] == scc.component[v], reach[u][v] && reach[v][u]);
+            }
+        }
+        expect_same_partition(scc, g.strongly_connected_components_parallel(3));
+    }
+}
+
+TEST_F(StronglyConnectedTest, ParallelMatchesTarjanOnLargeGraphs) {
+    // Sparse graphs leave many mid-sized components for the colouring rounds.
+    for (auto [n, edges] : {std::pair{50'000, 60'000}, std::pair{50'000, 150'000}}) {
+        UnweightedGraph g = testutil::random_unweighted_graph(n, edges, 7);
+        StronglyConnectedComponents expected = g.strongly_connected_components();
+        expect_topological(g, expected);
+        for (int threads : {1, 4}) {
+            StronglyConnectedComponents got = g.strongly_connected_components_parallel(threads);
+            expect_topological(g, got);
+            expect_same_partition(expected, got);
+        }
+    }
+}
+
+TEST_F(StronglyConnectedTest, ChainOfCycles) {
+    // 20'000 two-vertex cycles linked into a chain: no vertex can be trimmed
+    const int pairs = 20'000;
+    UnweightedGraph g(2 * pairs);
+    for (int i = 0; i < pairs; ++i) {
+        g.add_edge(2 * i, 2 * i + 1);
+        g.add_edge(2 * i + 1, 2 * i);
+        if (i + 1 < pairs) g.add_edge(2 * i + 1, 2 * i + 2);
+    }
+    for (const auto& scc : {g.strongly_connected_components(), g.strongly_connected_components_parallel(4)}) {
+        EXPECT_EQ(scc.count, pairs);
+        for (int i = 0; i < pairs; ++i) {
+            EXPECT_EQ(scc.component[2 * i], i);
+            EXPECT_EQ(scc.component[2 * i + 1], i);
+        }
+    }
+}
+
+TEST_F(StronglyConnectedTest, DeepCycleDoesNotOverflowStack) {
+    const int n = 1'000'000;
+    UnweightedGraph g(n);
+    for (int v = 0; v < n; ++v) g.add_edge(v, (v + 1) % n);
+    EXPECT_EQ(g.strongly_connected_components().count, 1);
+    EXPECT_EQ(g.strongly_connected_components_parallel(2).count, 1);
+}
+
+TEST_F(StronglyConnectedTest, CondensationIsTopologicallyNumberedDag) {
+    UnweightedGraph g = testutil::random_unweighted_graph(2'000, 3'000, 3);
+    StronglyConnectedComponents scc = g.strongly_connected_components();
+    UnweightedGraph dag = g.condensation(scc, 2);
+    ASSERT_EQ(dag.size(), scc.count);
+
+    std::vector<std::vector<bool>> expected_arc(scc.count);
+    for (int u = 0; u < g.size(); ++u) {
+        for (int v : g.neighbours(u)) {
+            int a = scc.component[u], b = scc.component[v];
+            if (a == b) continue;
+            if (expected_arc[a].empty()) expected_arc[a].assign(scc.count, false);
+            expected_arc[a][b] = true;
+        }
+    }
+    std::size_t arcs = 0;
+    for (int c = 0; c < dag.size(); ++c) {
+        auto row = dag.neighbours(c);
+        EXPECT_TRUE(std::is_sorted(row.begin(), row.end()));
+        EXPECT_EQ(std::adjacent_find(row.begin(), row.end()), row.end());
+        for (int d : row) {
+            EXPECT_LT(c, d);
+            EXPECT_TRUE(expected_arc[c][d]);
+        }
+        arcs += row.size();
+    }
+    std::size_t expected_arcs = 0;
+    for (const auto& row : expected_arc) expected_arcs += std::count(row.begin(), row.end(), true);
+    EXPECT_EQ(arcs, expected_arcs);
+    EXPECT_EQ(dag.topological_sort().size(), static_cast<std::size_t>(scc.count));
+}
+
+TEST_F(StronglyConnectedTest, CondensationRejectsInvalidLabels) {
+    UnweightedGraph g(3);
+    g.add_edge(0, 1);
+    EXPECT_THROW(auto dag = g.condensation({2, {0, 1}}), std::invalid_argument);
+    EXPECT_THROW(auto dag = g.condensation({2, {0, 1, 2}}), std::invalid_argument);
+}
+
+TEST_F(StronglyConnectedTest, EmptyGraph) {
+    UnweightedGraph g(0);
+    EXPECT_EQ(g.strongly_connected_components().count, 0);
+    EXPECT_EQ(g.strongly_connected_components_parallel().count, 0);
+    EXPECT_EQ(g.condensation(g.strongly_connected_components()).size(), 0);
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include "src/graph/typed_weighted_graph.h"
+#include "src/graph/weighted_graph.h"
+#include <limits>
+#include <random>
+#include <vector>
+
+template<typename Graph>
+class TypedWeightedGraphTest : public ::testing::Test {};
+
+using GraphTypes = ::testing::Types<TypedWeightedGraph<std::uint32_t, std::uint16_t>,
+                                    TypedWeightedGraph<std::uint32_t, std::uint32_t>,
+                                    TypedWeightedGraph<std::uint64_t, std::uint64_t>,
+                                    TypedWeightedGraph<std::uint32_t, float>,
+                                    TypedWeightedGraph<std::uint64_t, double>>;
+TYPED_TEST_SUITE(TypedWeightedGraphTest, GraphTypes);
+
+TYPED_TEST(TypedWeightedGraphTest, MatchesWeightedGraph) {
+    const int n = 2000;
+    std::mt19937 rng(23);
+    std::uniform_int_distribution<int> vertex(0, n - 1), weight(0, 300);
+    WeightedGraph reference(n);
+    TypeParam g(n);
+    for (int i = 0; i < 8000; ++i) {
+        int u = vertex(rng), v = vertex(rng), w = weight(rng);
+        reference.add_edge(u, v, w);
+        g.add_edge(u, v, w);
+    }
+    EXPECT_FALSE(g.is_finalized());
+    EXPECT_EQ(g.edge_count(), 8000);
+    EXPECT_EQ(g.max_weight(), reference.max_weight());
+
+    for (int start : {0, 999}) {
+        std::vector<int> expected = reference.dijkstra(start);
+        auto distance = g.dijkstra(start);
+        for (int v = 0; v < n; ++v) {
+            if (expected[v] == std::numeric_limits<int>::max()) {
+                ASSERT_EQ(distance[v], TypeParam::unreachable);
+            } else {
+                ASSERT_EQ(distance[v], expected[v]);
+            }
+        }
+    }
+
+    long long expected_mst = 0, mst = 0;
+    for (const auto& e : reference.prim_mst()) expected_mst += e.w;
+    auto tree = g.prim_mst();
+    for (const auto& e : tree) mst += static_cast<long long>(e.w);
+    EXPECT_EQ(tree.empty(), reference.prim_mst().empty());
+    EXPECT_EQ(mst, expected_mst);
+}
+
+TYPED_TEST(TypedWeightedGraphTest, StagedEdgesAndErrors) {
+    TypeParam g(4);
+    g.add_edge(0, 1, 3);
+    g.finalize();
+    EXPECT_TRUE(g.is_finalized());
+    g.add_edge(1, 2, 4);
+    g.add_edge(2, 3, 5);
+    g.add_edge(0, 3, 20);
+    auto distance = g.dijkstra(0);
+    EXPECT_EQ(distance[3], 12);
+    EXPECT_EQ(g.neighbours(0).size(), 2);
+    EXPECT_EQ(g.neighbour_weights(0)[1], 20);
+    EXPECT_EQ(g.prim_mst().size(), 3);
+
+    EXPECT_THROW(g.add_edge(0, 4, 1), std::out_of_range);
+    EXPECT_THROW(auto bad = g.dijkstra(4), std::out_of_range);
+}
+
+TEST(TypedWeightedGraphOverflowTest, LongPathsDoNotWrap) {
+    const std::uint32_t heavy = 4'000'000'000u;
+    TypedWeightedGraph<std::uint32_t, std::uint32_t> g(4);
+    g.add_edge(0, 1, heavy);
+    g.add_edge(1, 2, heavy);
+    g.add_edge(2, 3, heavy);
+    auto distance = g.dijkstra(0);
+    EXPECT_EQ(distance[3], 3ull * heavy);
+
+    const std::uint64_t huge = std::numeric_limits<std::uint64_t>::max() / 2 + 1;
+    TypedWeightedGraph<std::uint64_t, std::uint64_t> wide(3);
+    wide.add_edge(0, 1, huge);
+    wide.add_edge(1, 2, huge);
+    auto saturated = wide.dijkstra(0);
+    EXPECT_EQ(saturated[1], huge);
+    EXPECT_EQ(saturated[2], decltype(wide)::unreachable);
+}
+
+TEST(TypedWeightedGraphFootprintTest, NarrowTypesShrinkAdjacency) {
+    TypedWeightedGraph<std::uint32_t, std::uint16_t> narrow(1000);
+    TypedWeightedGraph<std::uint64_t, std::uint64_t> wide(1000);
+    for (std::uint32_t v = 1; v < 1000; ++v) {
+        narrow.add_edge(v - 1, v, 7);
+        wide.add_edge(v - 1, v, 7);
+    }
+    EXPECT_EQ(narrow.adjacency_bytes(), 1001 * 4 + 1998 * (4 + 2));
+    EXPECT_EQ(wide.adjacency_bytes(), 1001 * 8 + 1998 * (8 + 8));
+}
+
+TEST(TypedWeightedGraphFloatTest, RejectsNegativeAndNaN) {
+    TypedWeightedGraph<std::uint32_t, double> g(3);
+    EXPECT_THROW(g.add_edge(0, 1, -0.5), std::invalid_argument);
+    EXPECT_THROW(g.add_edge(0, 1, std::numeric_limits<double>::quiet_NaN()), std::invalid_argument);
+    g.add_edge(0, 1, 0.25);
+    g.add_edge(1, 2, 0.5);
+    EXPECT_DOUBLE_EQ(g.dijkstra(0)[2], 0.75);
+    EXPECT_EQ(g.dijkstra(2)[0], 0.75);
+}
@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 #include "src/graph/unweighted_graph.h"
+#include "tests/test_utils.h"
 #include <set>
+#include <thread>
+#include <numeric>
 
 class UnweightedGraphTest : public ::testing::Test {
 protected:
@@ -163,6 +166,234 @@ TEST_F(UnweightedGraphTest, LargeGraphSearch) {
     EXPECT_EQ(dfs_discovery_time[999], 999);
 }
 
+// CSR Storage Tests
+
+TEST_F(UnweightedGraphTest, FinalizeMergesStagedEdges) {
+    UnweightedGraph g2(3);
+    g2.add_edge(0, 1);
+    EXPECT_FALSE(g2.is_finalized());
+    g2.finalize();
+    EXPECT_TRUE(g2.is_finalized());
+
+    g2.add_edge(0, 2);
+    g2.add_edge(1, 2);
+    auto [parent, distance] = g2.bfs(0);
+    EXPECT_TRUE(g2.is_finalized());
+    EXPECT_EQ(distance[2], 1);
+
+    std::span<const int> n0 = g2.neighbours(0);
+    EXPECT_EQ(std::vector<int>(n0.begin(), n0.end()), std::vector<int>({1, 2}));
+    EXPECT_EQ(g2.get_adj_list()[1].size(), 1);
+}
+
+// Parallel BFS Tests
+
+TEST_F(UnweightedGraphTest, ParallelBFSMatchesBFS) {
+    for (int threads : {1, 2, 4}) {
+        auto [parent, distance] = g->bfs_parallel(0, threads);
+        EXPECT_EQ(distance, g->bfs(0).second);
+        EXPECT_EQ(parent[0], -1);
+        EXPECT_EQ(parent[4], 3);
+        EXPECT_TRUE(parent[3] == 1 || parent[3] == 2);
+    }
+}
+
+TEST_F(UnweightedGraphTest, ParallelBFSRandomGraph) {
+    const int n = 20000;
+    UnweightedGraph g2 = testutil::random_unweighted_graph(n, 8 * n, 42);
+
+    auto expected = g2.bfs(0).second;
+    for (int threads : {1, 3, 8}) {
+        auto [parent, distance] = g2.bfs_parallel(0, threads);
+        ASSERT_EQ(distance, expected);
+        for (int v = 0; v < n; ++v) {
+            if (distance[v] > 0) {
+                EXPECT_EQ(distance[parent[v]], distance[v] - 1);
+            } else {
+                EXPECT_EQ(parent[v], -1);
+            }
+        }
+    }
+}
+
+TEST_F(UnweightedGraphTest, ParallelBFSUnreachableAndInvalid) {
+    UnweightedGraph g2(3);
+    g2.add_edge(0, 1);
+    auto [parent, distance] = g2.bfs_parallel(0, 2);
+    EXPECT_EQ(distance, std::vector<int>({0, 1, -1}));
+    EXPECT_EQ(parent, std::vector<int>({-1, 0, -1}));
+    EXPECT_THROW(g2.bfs_parallel(3), std::out_of_range);
+}
+
+TEST_F(UnweightedGraphTest, ConcurrentReadersAfterFinalize) {
+    const int n = 20000;
+    UnweightedGraph g2 = testutil::random_unweighted_graph(n, 8 * n, 7);
+    g2.finalize();
+    EXPECT_TRUE(g2.is_finalized());
+
+    // Every reader needs the transposed adjacency, which nobody has built yet.
+    auto expected = g2.bfs(0).second;
+    auto check_readers = [&](const UnweightedGraph& shared) {
+        std::vector<std::vector<int>> distances(4);
+        std::vector<int> components(4);
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 4; ++t) {
+            readers.emplace_back([&, t] {
+                distances[t] = shared.bfs_parallel(0, 2).second;
+                components[t] = shared.connected_components(2).count;
+            });
+        }
+        for (std::thread& reader : readers) reader.join();
+
+        for (int t = 0; t < 4; ++t) {
+            EXPECT_EQ(distances[t], expected);
+            EXPECT_EQ(components[t], components[0]);
+        }
+    };
+    check_readers(g2);
+
+    // Graphs built from whole CSR arrays are finalized without ever calling finalize().
+    std::vector<int> identity(n);
+    std::iota(identity.begin(), identity.end(), 0);
+    UnweightedGraph relabelled = g2.relabelled(identity);
+    EXPECT_TRUE(relabelled.is_finalized());
+    check_readers(relabelled);
+}
+
+// Bulk Construction Tests
+
+TEST_F(UnweightedGraphTest, AddEdgesMatchesAddEdge) {
+    const int n = 3000;
+    std::vector<std::pair<int, int>> first = testutil::random_edge_pairs(n, 20000, 17);
+    std::vector<std::pair<int, int>> second = testutil::random_edge_pairs(n, 5000, 18);
+
+    UnweightedGraph expected(n);
+    for (auto [u, v] : first) expected.add_edge(u, v);
+    expected.add_edge(2, 0);
+    for (auto [u, v] : second) expected.add_edge(u, v);
+
+    for (int threads : {1, 3}) {
+        UnweightedGraph bulk(n);
+        bulk.add_edges(first, threads);
+        bulk.add_edge(2, 0);
+        bulk.add_edges(second, threads);
+        for (int v = 0; v < n; ++v) {
+            ASSERT_TRUE(std::ranges::equal(bulk.neighbours(v), expected.neighbours(v)));
+        }
+        EXPECT_EQ(bulk.bfs(0).second, expected.bfs(0).second);
+    }
+
+    std::vector<std::pair<int, int>> bad = {{0, 1}, {n, 0}};
+    EXPECT_THROW(expected.add_edges(bad), std::out_of_range);
+}
+
+TEST_F(UnweightedGraphTest, ReserveDegreesWithOverflow) {
+    UnweightedGraph g2(3);
+    g2.reserve_degrees(std::vector<int>{1, 0, 0});
+    g2.add_edge(0, 2);
+    g2.add_edge(0, 1);
+    g2.add_edge(1, 2);
+    EXPECT_FALSE(g2.is_finalized());
+
+    std::span<const int> n0 = g2.neighbours(0);
+    EXPECT_EQ(std::vector<int>(n0.begin(), n0.end()), std::vector<int>({2, 1}));
+    EXPECT_EQ(g2.bfs(0).second, std::vector<int>({0, 1, 1}));
+    EXPECT_TRUE(g2.is_finalized());
+}
+
+TEST_F(UnweightedGraphTest, DepthFirstForestClassifiesEdges) {
+    // 0 -> 1 -> 2 -> 0 (back), 0 -> 2 (forward), 3 -> 1 (cross, new tree rooted at 3)
+    UnweightedGraph graph(4);
+    graph.add_edge(0, 1);
+    graph.add_edge(0, 2);
+    graph.add_edge(1, 2);
+    graph.add_edge(2, 0);
+    graph.add_edge(3, 1);
+
+    UnweightedGraph::DepthFirstForest forest = graph.depth_first_forest();
+    EXPECT_EQ(forest.parent, (std::vector<int>{-1, 0, 1, -1}));
+    EXPECT_EQ(forest.discovery, (std::vector<int>{0, 1, 2, 3}));
+    EXPECT_EQ(forest.finish, (std::vector<int>{2, 1, 0, 3}));
+
+    EXPECT_EQ(forest.classify(0, 0), EdgeClass::Tree);    // 0 -> 1
+    EXPECT_EQ(forest.classify(0, 1), EdgeClass::Forward); // 0 -> 2
+    EXPECT_EQ(forest.classify(1, 0), EdgeClass::Tree);    // 1 -> 2
+    EXPECT_EQ(forest.classify(2, 0), EdgeClass::Back);    // 2 -> 0
+    EXPECT_EQ(forest.classify(3, 0), EdgeClass::Cross);   // 3 -> 1
+}
+
+TEST_F(UnweightedGraphTest, DFSMatchesRecursiveOrder) {
+    auto [parent, discovery] = g->dfs(0);
+    // Recursive order visits 0, 1, 3, 4 before backtracking to 2
+    EXPECT_EQ(discovery, (std::vector<int>{0, 1, 4, 2, 3}));
+    EXPECT_EQ(parent, (std::vector<int>{-1, 0, 0, 1, 3}));
+    EXPECT_EQ(g->dfs_recursive(0), g->dfs(0));
+}
+
+TEST_F(UnweightedGraphTest, DeepPathDoesNotOverflowStack) {
+    const int n = 1'000'000;
+    UnweightedGraph path(n);
+    for (int v = 0; v + 1 < n; ++v) {
+        path.add_edge(v, v + 1);
+    }
+
+    auto [parent, discovery] = path.dfs_recursive(0);
+    EXPECT_EQ(discovery[n - 1], n - 1);
+    EXPECT_EQ(parent[n - 1], n - 2);
+
+    UnweightedGraph::DepthFirstForest forest = path.depth_first_forest();
+    EXPECT_EQ(forest.finish[0], n - 1);
+    EXPECT_EQ(forest.finish[n - 1], 0);
+}
+
+TEST_F(UnweightedGraphTest, TopologicalLayersSmallDag) {
+    UnweightedGraph::TopologicalLayers layers = g->topological_layers(2);
+    ASSERT_EQ(layers.layer_count(), 4);
+    EXPECT_EQ(layers.layer_offsets, (std::vector<int>{0, 1, 3, 4, 5}));
+    EXPECT_EQ(layers.layer(0)[0], 0);
+    std::vector<int> second(layers.layer(1).begin(), layers.layer(1).end());
+    std::sort(second.begin(), second.end());
+    EXPECT_EQ(second, (std::vector<int>{1, 2}));
+    EXPECT_EQ(layers.layer(2)[0], 3);
+    EXPECT_EQ(layers.layer(3)[0], 4);
+}
+
+TEST_F(UnweightedGraphTest, TopologicalLayersFollowLongestPaths) {
+    const int n = 20'000;
+    UnweightedGraph dag = testutil::random_unweighted_graph(n, 4 * n, 5, true);
+
+    // Longest incoming path of every vertex, by dynamic programming over increasing ids
+    std::vector<int> depth(n, 0);
+    for (int u = 0; u < n; ++u) {
+        for (int v : dag.neighbours(u)) depth[v] = std::max(depth[v], depth[u] + 1);
+    }
+
+    for (int threads : {1, 4}) {
+        UnweightedGraph::TopologicalLayers layers = dag.topological_layers(threads);
+        ASSERT_EQ(layers.order.size(), static_cast<std::size_t>(n));
+        ASSERT_EQ(layers.layer_count(), *std::max_element(depth.begin(), depth.end()) + 1);
+        std::vector<int> position(n, -1);
+        for (int i = 0; i < layers.layer_count(); ++i) {
+            for (int v : layers.layer(i)) EXPECT_EQ(depth[v], i);
+        }
+        for (int i = 0; i < n; ++i) position[layers.order[i]] = i;
+        for (int u = 0; u < n; ++u) {
+            ASSERT_NE(position[u], -1);
+            for (int v : dag.neighbours(u)) EXPECT_LT(position[u], position[v]);
+        }
+    }
+}
+
+TEST_F(UnweightedGraphTest, TopologicalLayersRejectCycle) {
+    g->add_edge(4, 1);
+    UnweightedGraph::TopologicalLayers layers = g->topological_layers(2);
+    EXPECT_TRUE(layers.order.empty());
+    EXPECT_EQ(layers.layer_count(), 0);
+
+    UnweightedGraph empty(0);
+    EXPECT_EQ(empty.topological_layers().layer_count(), 0);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -1,7 +1,9 @@
 #include <gtest/gtest.h>
 #include "src/graph/weighted_graph.h"
+#include "tests/test_utils.h"
 #include <algorithm>
 #include <random>
+#include <limits>
 
 class WeightedGraphTest : public ::testing::Test {
 protected:
@@ -173,6 +175,443 @@ TEST_F(WeightedGraphTest, LargeGraphMST) {
     EXPECT_TRUE(areMSTsEquivalent(mstKruskal, mstPrim));
 }
 
+// CSR Storage Tests
+
+TEST_F(WeightedGraphTest, NeighbourViewMatchesAddedEdges) {
+    std::span<const int> targets = g->neighbours(2);
+    std::span<const int> weights = g->neighbour_weights(2);
+    EXPECT_EQ(std::vector<int>(targets.begin(), targets.end()), std::vector<int>({0, 1, 3}));
+    EXPECT_EQ(std::vector<int>(weights.begin(), weights.end()), std::vector<int>({1, 2, 5}));
+
+    int total = 0;
+    for (const auto& [v, w] : g->get_adj_list()[2]) total += w;
+    EXPECT_EQ(total, 8);
+}
+
+TEST_F(WeightedGraphTest, EdgesAddedAfterFinalize) {
+    WeightedGraph g2(3);
+    g2.add_edge(0, 1, 5);
+    g2.finalize();
+    EXPECT_EQ(g2.dijkstra(0, 2), -1);
+
+    g2.add_edge(1, 2, 1);
+    g2.add_edge(0, 2, 10);
+    EXPECT_FALSE(g2.is_finalized());
+    EXPECT_EQ(g2.dijkstra(0, 2), 6);
+    EXPECT_EQ(g2.kruskal_mst().size(), 2);
+}
+
+// Delta-Stepping Tests
+
+TEST_F(WeightedGraphTest, DeltaSteppingMatchesDijkstra) {
+    for (int delta : {0, 1, 2, 100}) {
+        EXPECT_EQ(g->delta_stepping(0, 2, delta), g->dijkstra(0));
+        EXPECT_EQ(g->delta_stepping(3, 1, delta), g->dijkstra(3));
+    }
+}
+
+TEST_F(WeightedGraphTest, DeltaSteppingRandomGraph) {
+    const int NUM_VERTICES = 5000;
+    WeightedGraph g2 = testutil::random_weighted_graph(NUM_VERTICES, 4 * NUM_VERTICES, 1000, 7);
+
+    auto expected = g2.dijkstra(0);
+    EXPECT_GE(g2.select_delta(), 1);
+    for (int threads : {1, 4}) {
+        EXPECT_EQ(g2.delta_stepping(0, threads), expected);
+    }
+}
+
+TEST_F(WeightedGraphTest, DeltaSteppingHeavyEdge) {
+    // Bucket storage must not grow with distance / delta
+    WeightedGraph pair(3);
+    pair.add_edge(0, 1, 200'000'000);
+    pair.add_edge(1, 2, 3);
+    EXPECT_EQ(pair.delta_stepping(0, 1, 1), (std::vector<int>{0, 200'000'000, 200'000'003}));
+
+    const int n = 2000;
+    WeightedGraph pendant(n + 1);
+    for (int v = 1; v < n; ++v) pendant.add_edge(v - 1, v, 1);
+    pendant.add_edge(n - 1, n, 50'000'000);
+    auto expected = pendant.dijkstra(0);
+    for (int threads : {1, 4}) {
+        EXPECT_EQ(pendant.delta_stepping(0, threads), expected);
+    }
+
+    // Weights far beyond the bucket window with delta = 1 keep the overflow list busy
+    WeightedGraph spread = testutil::random_weighted_graph(3000, 12'000, 1'000'000, 11);
+    expected = spread.dijkstra(0);
+    for (int threads : {1, 4}) {
+        EXPECT_EQ(spread.delta_stepping(0, threads, 1), expected);
+        EXPECT_EQ(spread.delta_stepping(0, threads, 5000), expected);
+    }
+}
+
+TEST_F(WeightedGraphTest, DeltaSteppingLightAndHeavyArcs) {
+    // With delta = 5 the direct 0 - 1 arc is heavy and loses to the light path through 2;
+    // the zero-weight arcs keep refilling the current bucket.
+    WeightedGraph g2(5);
+    g2.add_edge(0, 1, 10);
+    g2.add_edge(0, 2, 3);
+    g2.add_edge(2, 1, 3);
+    g2.add_edge(2, 3, 0);
+    g2.add_edge(3, 4, 0);
+    g2.add_edge(4, 1, 1);
+    EXPECT_EQ(g2.delta_stepping(0, 1, 5), (std::vector<int>{0, 4, 3, 3, 3}));
+    EXPECT_EQ(g2.delta_stepping(0, 1, 100), g2.dijkstra(0));
+}
+
+TEST_F(WeightedGraphTest, DeltaSteppingUnreachableAndInvalid) {
+    WeightedGraph g2(3);
+    g2.add_edge(0, 1, 4);
+    auto dist = g2.delta_stepping(0, 2);
+    EXPECT_EQ(dist[1], 4);
+    EXPECT_EQ(dist[2], std::numeric_limits<int>::max());
+    EXPECT_THROW(g2.delta_stepping(3), std::out_of_range);
+    EXPECT_EQ(WeightedGraph(0).select_delta(), 1);
+}
+
+// Point-to-Point Query Tests
+
+TEST_F(WeightedGraphTest, BidirectionalDijkstra) {
+    EXPECT_EQ(g->bidirectional_dijkstra(0, 4), 7);
+    EXPECT_EQ(g->bidirectional_dijkstra(4, 0), 7);
+    EXPECT_EQ(g->bidirectional_dijkstra(2, 2), 0);
+
+    auto [distance, path] = g->bidirectional_dijkstra_path(0, 4);
+    EXPECT_EQ(distance, 7);
+    EXPECT_EQ(path, std::vector<int>({0, 2, 1, 3, 4}));
+    EXPECT_THROW((void)g->bidirectional_dijkstra(0, 5), std::out_of_range);
+}
+
+TEST_F(WeightedGraphTest, AStarGridWithManhattanHeuristic) {
+    const int W = 30, H = 20;
+    WeightedGraph grid(W * H);
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<> weight_dist(1, 9);
+    for (int y = 0; y < H; ++y) {
+        for (int x = 0; x < W; ++x) {
+            if (x + 1 < W) grid.add_edge(y * W + x, y * W + x + 1, weight_dist(gen));
+            if (y + 1 < H) grid.add_edge(y * W + x, (y + 1) * W + x, weight_dist(gen));
+        }
+    }
+
+    const int target = W * H - 1;
+    auto manhattan = [&](int v) { return std::abs(v % W - target % W) + std::abs(v / W - target / W); };
+    auto [distance, path] = grid.a_star_path(0, target, manhattan);
+
+    EXPECT_EQ(distance, grid.dijkstra(0, target));
+    EXPECT_EQ(grid.a_star(0, target, [](int) { return 0; }), distance);
+    ASSERT_FALSE(path.empty());
+    EXPECT_EQ(path.front(), 0);
+    EXPECT_EQ(path.back(), target);
+
+    int total = 0;
+    for (std::size_t i = 1; i < path.size(); ++i) {
+        int best = std::numeric_limits<int>::max();
+        for (auto [v, w] : grid.get_adj_list()[path[i - 1]]) {
+            if (v == path[i]) best = std::min(best, w);
+        }
+        ASSERT_NE(best, std::numeric_limits<int>::max());
+        total += best;
+    }
+    EXPECT_EQ(total, distance);
+}
+
+TEST_F(WeightedGraphTest, PointToPointRandomGraph) {
+    const int NUM_VERTICES = 2000;
+    WeightedGraph g2 = testutil::random_weighted_graph(NUM_VERTICES, 3 * NUM_VERTICES, 50, 11);
+    std::mt19937 gen(12);
+    std::uniform_int_distribution<> vertex_dist(0, NUM_VERTICES - 1);
+    for (int q = 0; q < 50; ++q) {
+        int s = vertex_dist(gen), t = vertex_dist(gen);
+        int expected = g2.dijkstra(s, t);
+        EXPECT_EQ(g2.bidirectional_dijkstra(s, t), expected);
+        EXPECT_EQ(g2.a_star(s, t, [](int) { return 0; }), expected);
+    }
+}
+
+TEST_F(WeightedGraphTest, PointToPointNoPath) {
+    WeightedGraph g2(3);
+    g2.add_edge(0, 1, 1);
+    auto [distance, path] = g2.bidirectional_dijkstra_path(0, 2);
+    EXPECT_EQ(distance, -1);
+    EXPECT_TRUE(path.empty());
+    EXPECT_EQ(g2.a_star_path(2, 0, [](int) { return 0; }).first, -1);
+}
+
+
+// Priority-Queue Policy Tests
+
+TEST_F(WeightedGraphTest, DijkstraQueuePoliciesMatch) {
+    std::vector<int> expected = g->dijkstra(0);
+    EXPECT_EQ(g->dijkstra<DialBucketQueue>(0), expected);
+    EXPECT_EQ(g->dijkstra<RadixHeapQueue>(0), expected);
+    EXPECT_EQ(g->dijkstra<IndexedDaryHeapQueue<4>>(0), expected);
+    EXPECT_EQ(g->max_weight(), 5);
+    EXPECT_THROW(g->dijkstra<RadixHeapQueue>(5), std::out_of_range);
+}
+
+TEST_F(WeightedGraphTest, QueuePoliciesRandomGraph) {
+    const int n = 1500;
+    WeightedGraph rg = testutil::random_weighted_graph(n, 6 * n, 50, 11);
+    for (int i = 1; i < n; ++i) {
+        rg.add_edge(i - 1, i, 50);
+    }
+
+    std::vector<int> expected = rg.dijkstra(0);
+    EXPECT_EQ(rg.dijkstra<DialBucketQueue>(0), expected);
+    EXPECT_EQ(rg.dijkstra<RadixHeapQueue>(0), expected);
+    EXPECT_EQ(rg.dijkstra<IndexedDaryHeapQueue<2>>(0), expected);
+    EXPECT_EQ(rg.dijkstra<IndexedDaryHeapQueue<8>>(0), expected);
+
+    auto total = [](const std::vector<WeightedGraph::Edge>& mst) {
+        long long sum = 0;
+        for (const auto& e : mst) sum += e.w;
+        return sum;
+    };
+    long long expected_weight = total(rg.kruskal_mst());
+    EXPECT_EQ(total(rg.prim_mst()), expected_weight);
+    EXPECT_EQ(total(rg.prim_mst<DialBucketQueue>()), expected_weight);
+    EXPECT_EQ(total(rg.prim_mst<IndexedDaryHeapQueue<4>>()), expected_weight);
+    EXPECT_EQ(rg.prim_mst<IndexedDaryHeapQueue<4>>().size(), static_cast<std::size_t>(n - 1));
+}
+
+
+// Many-to-Many and Multi-Source Tests
+
+TEST_F(WeightedGraphTest, DistanceTableMatchesDijkstra) {
+    std::vector<int> sources{0, 3, 4};
+    std::vector<int> targets{4, 1, 1, 0};
+    std::vector<int> table = g->distance_table(sources, targets, 2);
+    ASSERT_EQ(table.size(), sources.size() * targets.size());
+    for (std::size_t i = 0; i < sources.size(); ++i) {
+        std::vector<int> dist = g->dijkstra(sources[i]);
+        for (std::size_t j = 0; j < targets.size(); ++j) {
+            EXPECT_EQ(table[i * targets.size() + j], dist[targets[j]]);
+        }
+    }
+}
+
+TEST_F(WeightedGraphTest, DistanceTableRandomGraph) {
+    const int n = 600;
+    WeightedGraph rg = testutil::random_weighted_graph(n, 4 * n, 30, 5, 1, 1); // vertex n is isolated
+    std::mt19937 gen(6);
+    std::uniform_int_distribution<> vertex(0, n - 1);
+
+    std::vector<int> sources, targets;
+    for (int i = 0; i < 40; ++i) sources.push_back(vertex(gen));
+    for (int i = 0; i < 25; ++i) targets.push_back(vertex(gen));
+    targets.push_back(n);
+
+    std::vector<int> table = rg.distance_table(sources, targets, 4);
+    for (std::size_t i = 0; i < sources.size(); ++i) {
+        std::vector<int> dist = rg.dijkstra(sources[i]);
+        for (std::size_t j = 0; j < targets.size(); ++j) {
+            int expected = dist[targets[j]] == std::numeric_limits<int>::max() ? -1 : dist[targets[j]];
+            EXPECT_EQ(table[i * targets.size() + j], expected);
+        }
+    }
+    EXPECT_EQ(rg.distance_table(sources, targets, 1), table);
+}
+
+TEST_F(WeightedGraphTest, DistanceTableInvalidVertex) {
+    std::vector<int> valid{0, 1};
+    std::vector<int> invalid{0, 5};
+    EXPECT_THROW(auto t = g->distance_table(invalid, valid), std::out_of_range);
+    EXPECT_THROW(auto t = g->distance_table(valid, invalid), std::out_of_range);
+    EXPECT_TRUE(g->distance_table({}, valid).empty());
+}
+
+TEST_F(WeightedGraphTest, NearestSource) {
+    std::vector<int> sources{0, 4};
+    auto [dist, owner] = g->nearest_source(sources);
+    EXPECT_EQ(dist, std::vector<int>({0, 3, 1, 3, 0}));
+    EXPECT_EQ(owner, std::vector<int>({0, 0, 0, 4, 4}));
+}
+
+TEST_F(WeightedGraphTest, NearestSourceRandomGraph) {
+    const int n = 800;
+    WeightedGraph rg = testutil::random_weighted_graph(n, 3 * n, 40, 9, 1, 1);
+    std::mt19937 gen(10);
+    std::uniform_int_distribution<> vertex(0, n - 1);
+    std::vector<int> sources{vertex(gen), vertex(gen), vertex(gen), vertex(gen)};
+
+    auto [dist, owner] = rg.nearest_source(sources);
+    std::vector<std::vector<int>> from_each;
+    for (int s : sources) from_each.push_back(rg.dijkstra(s));
+    for (int v = 0; v <= n; ++v) {
+        int best = std::numeric_limits<int>::max();
+        for (const auto& d : from_each) best = std::min(best, d[v]);
+        EXPECT_EQ(dist[v], best);
+        if (best == std::numeric_limits<int>::max()) {
+            EXPECT_EQ(owner[v], -1);
+        } else {
+            int i = std::find(sources.begin(), sources.end(), owner[v]) - sources.begin();
+            ASSERT_LT(i, static_cast<int>(sources.size()));
+            EXPECT_EQ(from_each[i][v], best);
+        }
+    }
+}
+
+
+// Borůvka MST Tests
+
+TEST_F(WeightedGraphTest, BoruvkaSimpleGraph) {
+    auto mst = g->boruvka_mst();
+    ASSERT_EQ(mst.size(), 4);
+    EXPECT_TRUE(areMSTsEquivalent(g->kruskal_mst(), mst));
+    for (const auto& edge : mst) EXPECT_LT(edge.u, edge.v);
+}
+
+TEST_F(WeightedGraphTest, BoruvkaRandomGraphAcrossThreadCounts) {
+    const int n = 3000;
+    WeightedGraph rg = testutil::random_weighted_graph(n, 5 * n, 20, 3); // many ties
+    std::mt19937 gen(4);
+    std::uniform_int_distribution<> weight(0, 20);
+    for (int i = 1; i < n; ++i) rg.add_edge(i - 1, i, weight(gen));
+
+    auto kruskal = rg.kruskal_mst();
+    auto single = rg.boruvka_mst(1);
+    EXPECT_TRUE(areMSTsEquivalent(kruskal, single));
+
+    auto parallel = rg.boruvka_mst(4);
+    ASSERT_EQ(parallel.size(), single.size());
+    for (std::size_t i = 0; i < single.size(); ++i) {
+        EXPECT_EQ(parallel[i].u, single[i].u);
+        EXPECT_EQ(parallel[i].v, single[i].v);
+    }
+}
+
+TEST_F(WeightedGraphTest, BoruvkaLongPath) {
+    // Increasing weights make every component hook onto the next one: a single deep chain
+    const int n = 5000;
+    WeightedGraph path(n);
+    for (int i = 1; i < n; ++i) path.add_edge(i - 1, i, i);
+    EXPECT_EQ(path.boruvka_mst(2).size(), static_cast<std::size_t>(n - 1));
+}
+
+TEST_F(WeightedGraphTest, BoruvkaDisconnectedGraphReturnsForest) {
+    WeightedGraph dg(7);
+    dg.add_edge(0, 1, 1);
+    dg.add_edge(1, 2, 2);
+    dg.add_edge(0, 2, 5);
+    dg.add_edge(3, 4, 4);
+    // Vertices 5 and 6 are isolated
+
+    auto forest = dg.boruvka_mst();
+    EXPECT_TRUE(dg.kruskal_mst().empty());
+    ASSERT_EQ(forest.size(), 3);
+    int total = 0;
+    for (const auto& edge : forest) total += edge.w;
+    EXPECT_EQ(total, 7);
+}
+
+
+// Filter-Kruskal Tests
+
+TEST_F(WeightedGraphTest, FilterKruskalSimpleGraph) {
+    auto mst = g->filter_kruskal_mst();
+    ASSERT_EQ(mst.size(), 4);
+    EXPECT_TRUE(areMSTsEquivalent(g->kruskal_mst(), mst));
+}
+
+TEST_F(WeightedGraphTest, FilterKruskalDenseRandomGraph) {
+    const int n = 400;
+    WeightedGraph dense(n);
+    std::mt19937 gen(17);
+    std::uniform_int_distribution<> weight(1, 1000);
+    for (int u = 0; u < n; ++u) {
+        for (int v = u + 1; v < n; ++v) {
+            dense.add_edge(u, v, weight(gen));
+        }
+    }
+
+    auto kruskal = dense.kruskal_mst();
+    EXPECT_TRUE(areMSTsEquivalent(kruskal, dense.filter_kruskal_mst(1)));
+    EXPECT_TRUE(areMSTsEquivalent(kruskal, dense.filter_kruskal_mst(4)));
+}
+
+TEST_F(WeightedGraphTest, FilterKruskalEqualWeightsAndDisconnected) {
+    const int n = 3000;
+    WeightedGraph same = testutil::random_weighted_graph(n, 4 * n, 7, 23, 7);
+    for (int i = 1; i < n; ++i) same.add_edge(i - 1, i, 7);
+    EXPECT_EQ(same.filter_kruskal_mst(2).size(), static_cast<std::size_t>(n - 1));
+
+    WeightedGraph split(6);
+    split.add_edge(0, 1, 1);
+    split.add_edge(2, 3, 1);
+    EXPECT_TRUE(split.filter_kruskal_mst().empty());
+}
+
+// Bulk Construction Tests
+
+TEST_F(WeightedGraphTest, AddEdgesMatchesAddEdge) {
+    const int n = 3000;
+    std::mt19937 rng(31);
+    std::uniform_int_distribution<int> vertex(0, n - 1), weight(0, 50);
+    std::vector<WeightedGraph::Edge> first, second;
+    for (int i = 0; i < 20000; ++i) first.emplace_back(vertex(rng), vertex(rng), weight(rng));
+    for (int i = 0; i < 5000; ++i) second.emplace_back(vertex(rng), vertex(rng), weight(rng));
+
+    WeightedGraph expected(n);
+    for (const auto& e : first) expected.add_edge(e.u, e.v, e.w);
+    expected.add_edge(0, 1, 7);
+    for (const auto& e : second) expected.add_edge(e.u, e.v, e.w);
+
+    for (int threads : {1, 3}) {
+        WeightedGraph bulk(n);
+        bulk.add_edges(first, threads);
+        bulk.add_edge(0, 1, 7);
+        bulk.add_edges(second, threads);
+        EXPECT_EQ(bulk.max_weight(), expected.max_weight());
+        for (int v = 0; v < n; ++v) {
+            std::span<const int> a = bulk.neighbours(v), b = expected.neighbours(v);
+            std::span<const int> wa = bulk.neighbour_weights(v), wb = expected.neighbour_weights(v);
+            ASSERT_TRUE(std::ranges::equal(a, b));
+            ASSERT_TRUE(std::ranges::equal(wa, wb));
+        }
+    }
+}
+
+TEST_F(WeightedGraphTest, AddEdgesRejectsInvalidBatchWithoutChanges) {
+    std::vector<WeightedGraph::Edge> bad_vertex = {{0, 4, 1}, {0, 5, 1}};
+    std::vector<WeightedGraph::Edge> bad_weight = {{0, 4, 1}, {1, 4, -2}};
+    EXPECT_THROW(g->add_edges(bad_vertex), std::out_of_range);
+    EXPECT_THROW(g->add_edges(bad_weight), std::invalid_argument);
+    EXPECT_EQ(g->dijkstra(0), std::vector<int>({0, 3, 1, 4, 7}));
+}
+
+TEST_F(WeightedGraphTest, ReserveDegreesFillsInPlace) {
+    WeightedGraph g2(4);
+    g2.add_edge(0, 1, 5);
+    g2.reserve_edges(3);
+    g2.reserve_degrees(std::vector<int>{2, 1, 1, 0});
+    g2.add_edge(0, 2, 1);
+    g2.add_edge(1, 2, 2);
+    g2.add_edge(0, 3, 4);
+    EXPECT_FALSE(g2.is_finalized());
+    EXPECT_EQ(g2.dijkstra(0), std::vector<int>({0, 3, 1, 4}));
+    EXPECT_TRUE(g2.is_finalized());
+
+    std::span<const int> n0 = g2.neighbours(0);
+    EXPECT_EQ(std::vector<int>(n0.begin(), n0.end()), std::vector<int>({1, 2, 3}));
+    std::span<const int> n2 = g2.neighbours(2);
+    EXPECT_EQ(std::vector<int>(n2.begin(), n2.end()), std::vector<int>({0, 1}));
+    EXPECT_THROW(g2.reserve_degrees(std::vector<int>{1, 1}), std::invalid_argument);
+}
+
+TEST_F(WeightedGraphTest, LongPathsSaturateInsteadOfWrapping) {
+    const int heavy = std::numeric_limits<int>::max() / 2 + 10;
+    WeightedGraph g(4);
+    g.add_edge(0, 1, heavy);
+    g.add_edge(1, 2, heavy);
+    g.add_edge(0, 3, 1);
+    std::vector<int> distance = g.dijkstra(0);
+    EXPECT_EQ(distance[1], heavy);
+    EXPECT_EQ(distance[2], std::numeric_limits<int>::max());
+    EXPECT_EQ(g.dijkstra(0, 2), -1);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
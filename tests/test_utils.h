@@ -0,0 +1,107 @@
+#ifndef TEST_UTILS_H
+#define TEST_UTILS_H
+
+#include <random>
+#include <utility>
+#include <vector>
+#include "src/graph/unweighted_graph.h"
+#include "src/graph/weighted_graph.h"
+#include "src/graph/directed_weighted_graph.h"
+
+/**
+ * @brief Random graph generators shared by the test executables
+ *
+ * Every generator draws each edge as (source, target[, weight]) in that order from a
+ * std::mt19937 seeded with seed, so a given seed always yields the same graph. Edges are
+ * added one by one and left staged; the graphs are not finalized.
+ */
+namespace testutil {
+
+/**
+ * @brief Draw random (source, target) pairs with uniformly drawn endpoints
+ * @param vertices Number of vertices
+ * @param edges Number of pairs drawn
+ * @param seed Random seed
+ * @return std::vector<std::pair<int, int>> Pairs in drawing order, e.g. for add_edges()
+ */
+inline std::vector<std::pair<int, int>> random_edge_pairs(int vertices, int edges, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> vertex(0, vertices - 1);
+    std::vector<std::pair<int, int>> pairs;
+    pairs.reserve(edges);
+    for (int i = 0; i < edges; ++i) {
+        int u = vertex(rng), v = vertex(rng);
+        pairs.emplace_back(u, v);
+    }
+    return pairs;
+}
+
+/**
+ * @brief Build a random directed unweighted graph with uniformly drawn endpoints
+ * @param vertices Number of vertices
+ * @param edges Number of edges drawn
+ * @param seed Random seed
+ * @param acyclic If true, self-loops are dropped and every arc points from the smaller to the
+ *                larger id, so the graph is a DAG
+ * @return UnweightedGraph Graph with up to edges arcs (exactly edges unless acyclic)
+ */
+inline UnweightedGraph random_unweighted_graph(int vertices, int edges, unsigned seed, bool acyclic = false) {
+    UnweightedGraph g(vertices);
+    for (auto [u, v] : random_edge_pairs(vertices, edges, seed)) {
+        if (acyclic && u == v) continue;
+        if (acyclic && u > v) std::swap(u, v);
+        g.add_edge(u, v);
+    }
+    return g;
+}
+
+/**
+ * @brief Build a random undirected weighted graph with uniformly drawn endpoints and weights
+ * @param vertices Number of vertices
+ * @param edges Number of edges
+ * @param max_weight Largest edge weight
+ * @param seed Random seed
+ * @param min_weight Smallest edge weight
+ * @param isolated Number of extra vertices, numbered after the others, that get no edges
+ * @return WeightedGraph Graph with weights uniform in [min_weight, max_weight]
+ */
+inline WeightedGraph random_weighted_graph(int vertices, int edges, int max_weight, unsigned seed,
+                                           int min_weight = 0, int isolated = 0) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> vertex(0, vertices - 1), weight(min_weight, max_weight);
+    WeightedGraph g(vertices + isolated);
+    for (int i = 0; i < edges; ++i) {
+        int u = vertex(rng), v = vertex(rng);
+        g.add_edge(u, v, weight(rng));
+    }
+    return g;
+}
+
+/**
+ * @brief Build a random directed graph with negative arcs but no negative cycle
+ *
+ * Every vertex gets a random potential p in [0, 50] and every arc u -> v the weight
+ * b + p(u) - p(v) with b in [0, 20]. Around any cycle the potentials cancel, so cycles weigh
+ * at least 0, while single arcs are often negative.
+ *
+ * @param vertices Number of vertices
+ * @param edges Number of arcs
+ * @param seed Random seed
+ * @return DirectedWeightedGraph Graph without negative cycles
+ */
+inline DirectedWeightedGraph random_potential_graph(int vertices, int edges, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> vertex(0, vertices - 1), base(0, 20), potential(0, 50);
+    std::vector<int> p(vertices);
+    for (int& x : p) x = potential(rng);
+    DirectedWeightedGraph g(vertices);
+    for (int i = 0; i < edges; ++i) {
+        int u = vertex(rng), v = vertex(rng);
+        g.add_edge(u, v, base(rng) + p[u] - p[v]);
+    }
+    return g;
+}
+
+} // namespace testutil
+
+#endif // TEST_UTILS_H